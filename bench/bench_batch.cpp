@@ -0,0 +1,70 @@
+// Compares the gm_math batch overloads against a plain loop over the
+// scalar templates, which the compiler is free to auto-vectorize. Runs
+// once with arrays that fit in L1 and once with arrays that don't, and
+// once with a misaligned output to exercise the head/tail handling.
+//
+//   g++ -std=c++11 -O3 -march=native -I.. bench_batch.cpp -o bench_batch
+
+#include "gm_math.hpp"
+
+#include <stdio.h>
+#include <vector>
+#include <chrono>
+
+
+static volatile float sink;
+
+
+#define BENCH(name, scalarExpr, batchCall) \
+	{ \
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(); \
+		for (int rep = 0; rep < reps; ++rep) \
+		{ \
+			for (size_t i = 0; i < n; ++i) \
+				scalarExpr; \
+			sink = r[rep % n]; \
+		} \
+		const double scalarTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / reps / n; \
+		start = std::chrono::steady_clock::now(); \
+		for (int rep = 0; rep < reps; ++rep) \
+		{ \
+			batchCall; \
+			sink = r[rep % n]; \
+		} \
+		const double batchTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / reps / n; \
+		printf("n=%-8zu %-12s scalar %.3f ns  batch %.3f ns  %.2fx\n", n, name, scalarTime, batchTime, scalarTime / batchTime); \
+	}
+
+
+int main()
+{
+	const size_t sizes[] = { size_t(4096), size_t(1) << 22 };
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); ++s)
+	{
+		const size_t n = sizes[s];
+		const int reps = (int) ((size_t(1) << 26) / n);
+
+		std::vector<float> av(n), bv(n), tv(n), rv(n + 1);
+		float *a = av.data(), *b = bv.data(), *t = tv.data(), *r = rv.data();
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			a[i] = (float) (i % 7);
+			b[i] = (float) (i % 5);
+			t[i] = (i % 100) / 100.0f;
+		}
+
+		BENCH("lerp", r[i] = gm::lerp(a[i], b[i], t[i]), gm::lerp(a, b, t, r, n))
+		BENCH("lerp scalar", r[i] = gm::lerp(2.0f, 3.0f, t[i]), gm::lerp(2.0f, 3.0f, t, r, n))
+		BENCH("map", r[i] = gm::map(a[i], 0.0f, 7.0f, -1.0f, 1.0f), gm::map(a, 0.0f, 7.0f, -1.0f, 1.0f, r, n))
+		BENCH("normalize", r[i] = gm::normalize(0.0f, 7.0f, a[i]), gm::normalize(0.0f, 7.0f, a, r, n))
+		BENCH("clamp", r[i] = gm::clamp(a[i], 1.0f, 4.0f), gm::clamp(a, 1.0f, 4.0f, r, n))
+		BENCH("smoothstep", r[i] = gm::smoothstep(1.0f, 4.0f, a[i]), gm::smoothstep(1.0f, 4.0f, a, r, n))
+		BENCH("bilerp", r[i] = gm::bilerp(a[i], b[i], a[i], b[i], t[i], t[i]), gm::bilerp(a, b, a, b, t, t, r, n))
+		BENCH("clamp r+1", r[i + 1] = gm::clamp(a[i], 1.0f, 4.0f), gm::clamp(a, 1.0f, 4.0f, r + 1, n))
+		BENCH("in place", t[i] = gm::smoothstep(0.0f, 1.0f, t[i]), gm::smoothstep(0.0f, 1.0f, t, t, n))
+	}
+
+	return 0;
+}
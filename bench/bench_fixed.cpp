@@ -0,0 +1,74 @@
+// Times the float and gm::fixed paths of the templates fixed plugs
+// into (easing curves, smoothstep) and the fixed math functions
+// against their <math.h> counterparts.
+//
+//   g++ -std=c++11 -O2 -I.. bench_fixed.cpp -o bench_fixed
+
+#include "gm_math.hpp"
+#include "gm_easing.hpp"
+#include "gm_fixed.hpp"
+
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+#include <chrono>
+
+
+using gm::fixed;
+
+
+static const size_t N = size_t(1) << 20;
+
+static volatile float floatSink;
+static volatile int32_t fixedSink;
+
+
+static double elapsed(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / N;
+}
+
+
+#define BENCH(name, floatExpr, fixedExpr) \
+	{ \
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(); \
+		float fs = 0.0f; \
+		for (size_t i = 0; i < N; ++i) \
+			fs += floatExpr; \
+		const double floatTime = elapsed(start); \
+		start = std::chrono::steady_clock::now(); \
+		fixed xs(0); \
+		for (size_t i = 0; i < N; ++i) \
+			xs += fixedExpr; \
+		const double fixedTime = elapsed(start); \
+		floatSink = fs; \
+		fixedSink = xs.raw(); \
+		printf("%-18s float %6.2f ns  fixed %6.2f ns\n", name, floatTime, fixedTime); \
+	}
+
+
+int main()
+{
+	std::vector<float> tf(N);
+	std::vector<fixed> tx(N);
+
+	for (size_t i = 0; i < N; ++i)
+	{
+		tf[i] = (i % 1000) / 1000.0f;
+		tx[i] = fixed(tf[i]);
+	}
+
+	BENCH("easeInOutQuad", gm::easing::easeInOutQuad<float>(tf[i]), gm::easing::easeInOutQuad<fixed>(tx[i]))
+	BENCH("easeInOutSine", gm::easing::easeInOutSine<float>(tf[i]), gm::easing::easeInOutSine<fixed>(tx[i]))
+	BENCH("easeInOutExpo", gm::easing::easeInOutExpo<float>(tf[i]), gm::easing::easeInOutExpo<fixed>(tx[i]))
+	BENCH("easeInOutCirc", gm::easing::easeInOutCirc<float>(tf[i]), gm::easing::easeInOutCirc<fixed>(tx[i]))
+	BENCH("easeInOutElastic", gm::easing::easeInOutElastic<float>(tf[i]), gm::easing::easeInOutElastic<fixed>(tx[i]))
+	BENCH("smoothstep", gm::smoothstep(0.0f, 1.0f, tf[i]), gm::smoothstep(fixed(0), fixed(1), tx[i]))
+
+	BENCH("sin", sinf(tf[i] * 10.0f), sin(tx[i] * fixed(10)))
+	BENCH("sqrt", sqrtf(tf[i]), sqrt(tx[i]))
+	BENCH("exp2", exp2f(tf[i]), exp2(tx[i]))
+	BENCH("pow", powf(tf[i], 1.5f), pow(tx[i], fixed(1.5)))
+
+	return 0;
+}
@@ -0,0 +1,97 @@
+// Compares bilinear sampling of a 4096x4096 heightmap through a
+// plain row-major array and gm::bilerp against gm::Grid. Runs once
+// with random queries and once with a coherent scan over the grid.
+//
+//   g++ -std=c++11 -O3 -march=native -I.. bench_grid.cpp -o bench_grid
+
+#include "gm_grid.hpp"
+
+#include <stdio.h>
+#include <vector>
+#include <random>
+#include <chrono>
+
+
+static const size_t width = 4096;
+static const size_t height = 4096;
+static const size_t queries = size_t(1) << 22;
+
+static volatile float sink;
+
+
+static double now()
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+static void sampleRowMajor(const std::vector<float> &data, const std::vector<float> &xs, const std::vector<float> &ys, std::vector<float> &result)
+{
+	for (size_t i = 0; i < queries; ++i)
+	{
+		const float x = gm::clamp(xs[i], 0.0f, (float) (width - 1));
+		const float y = gm::clamp(ys[i], 0.0f, (float) (height - 1));
+
+		const size_t x0 = (size_t) x, y0 = (size_t) y;
+		const size_t x1 = (x0 + 1 < width) ? (x0 + 1) : (width - 1);
+		const size_t y1 = (y0 + 1 < height) ? (y0 + 1) : (height - 1);
+
+		result[i] = gm::bilerp(
+			data[y0 * width + x0], data[y0 * width + x1],
+			data[y1 * width + x0], data[y1 * width + x1],
+			x - (float) x0, y - (float) y0);
+	}
+}
+
+
+static void run(const char *name, const std::vector<float> &data, gm::Grid &grid, const std::vector<float> &xs, const std::vector<float> &ys)
+{
+	std::vector<float> result(queries);
+
+	double t = now();
+	sampleRowMajor(data, xs, ys, result);
+	const double rowMajor = now() - t;
+	sink = result[queries / 2];
+
+	t = now();
+	grid.sample(xs.data(), ys.data(), result.data(), queries);
+	const double tiled = now() - t;
+	sink = result[queries / 2];
+
+	printf("%-9s row-major %6.1f ms  tiled %6.1f ms\n", name, rowMajor, tiled);
+}
+
+
+int main()
+{
+	std::mt19937 rng(1);
+
+	std::vector<float> data(width * height);
+
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = (rng() & 1023) * 0.001f;
+
+	gm::Grid grid(width, height);
+	grid.load(data.data());
+
+	std::uniform_real_distribution<float> ux(0.0f, (float) (width - 1)), uy(0.0f, (float) (height - 1));
+	std::vector<float> xs(queries), ys(queries);
+
+	for (size_t i = 0; i < queries; ++i)
+	{
+		xs[i] = ux(rng);
+		ys[i] = uy(rng);
+	}
+
+	run("random", data, grid, xs, ys);
+
+	for (size_t i = 0; i < queries; ++i)
+	{
+		xs[i] = (i % 2048) * 0.5f + 7.3f;
+		ys[i] = (i / 2048) * 0.25f;
+	}
+
+	run("coherent", data, grid, xs, ys);
+
+	return 0;
+}
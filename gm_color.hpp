@@ -4,7 +4,7 @@
 // Repository: https://github.com/MrVallentin/GameMath
 //
 // Date Created: September 24, 2012
-// Last Modified: July 27, 2016
+// Last Modified: October 18, 2026
 
 // Copyright (c) 2012-2016 Christian Vallentin <mail@vallentinsource.com>
 //
@@ -47,7 +47,7 @@
 #define GM_COLOR_NAME "GameMath Color"
 
 #define GM_COLOR_VERSION_MAJOR 1
-#define GM_COLOR_VERSION_MINOR 2
+#define GM_COLOR_VERSION_MINOR 3
 #define GM_COLOR_VERSION_PATCH 0
 
 #define GM_COLOR_VERSION GM_STRINGIFY_VERSION(GM_COLOR_VERSION_MAJOR, GM_COLOR_VERSION_MINOR, GM_COLOR_VERSION_PATCH)
@@ -56,6 +56,20 @@
 
 
 #include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "gm_parallel.hpp"
+#include "gm_simd.hpp"
 
 
 #define GM_COLOR_API static
@@ -104,11 +118,521 @@ template<typename T> GM_COLOR_API void rgb2hcv(
 	T *h, T *c, T *v);
 
 
+// Batch versions of hue2rgb(), hsl2rgb(), rgb2hsl() and rgb2hcv(),
+// which convert count colors at a time, GM_SIMD_FLOAT_WIDTH colors
+// per iteration (see gm_simd.hpp).
+//
+// The planar versions take an array per channel. The interleaved
+// versions take count pixels of 3 (RGB) or 4 (RGBA) channels, where
+// alpha is copied as is. Outputs may alias the inputs, and any
+// output channel may be nullptr.
+//
+// The results match the scalar functions (with T = float) within
+// 1E-5. The only exception is the saturation given by rgb2hsl(),
+// as it becomes ill-conditioned when the lightness is close to 0 or 1.
+
+GM_COLOR_API void hue2rgb(
+	const float *hue,
+	float *r, float *g, float *b,
+	size_t count);
+
+GM_COLOR_API void hsl2rgb(
+	const float *h, const float *s, const float *l,
+	float *r, float *g, float *b,
+	size_t count);
+
+GM_COLOR_API void rgb2hsl(
+	const float *r, const float *g, const float *b,
+	float *h, float *s, float *l,
+	size_t count);
+
+GM_COLOR_API void rgb2hcv(
+	const float *r, const float *g, const float *b,
+	float *h, float *c, float *v,
+	size_t count);
+
+GM_COLOR_API void hsl2rgb(const float *hsl, float *rgb, size_t count, int channels = 3);
+GM_COLOR_API void rgb2hsl(const float *rgb, float *hsl, size_t count, int channels = 3);
+GM_COLOR_API void rgb2hcv(const float *rgb, float *hcv, size_t count, int channels = 3);
+
+
+// The order of the channels in a packed color, from the most to
+// the least significant byte. ARGB (0xAARRGGBB) is the order used
+// by int2rgb() and rgb2int(). On little-endian machines the bytes
+// are stored in memory in the reverse order, i.e. ARGB is stored
+// as B, G, R, A.
+enum class ChannelOrder
+{
+	ARGB,
+	RGBA,
+	BGRA,
+	ABGR,
+};
+
+
+// Batch versions of int2rgb() and rgb2int(), which unpack count
+// packed colors into planar channels and pack them back. Any of the
+// unpacked channels may be nullptr, in which case it's skipped when
+// unpacking and (for alpha) packed as 255 or (for the colors) as 0.
+//
+// The float versions use the range [0;1]. When packing the values
+// are clamped and rounded to the nearest integer.
+
+GM_COLOR_API void int2rgb(
+	const int *rgb,
+	unsigned char *r, unsigned char *g, unsigned char *b, unsigned char *a,
+	size_t count, ChannelOrder order = ChannelOrder::ARGB);
+
+GM_COLOR_API void int2rgb(
+	const int *rgb,
+	float *r, float *g, float *b, float *a,
+	size_t count, ChannelOrder order = ChannelOrder::ARGB);
+
+GM_COLOR_API void rgb2int(
+	const unsigned char *r, const unsigned char *g, const unsigned char *b, const unsigned char *a,
+	int *rgb,
+	size_t count, ChannelOrder order = ChannelOrder::ARGB);
+
+GM_COLOR_API void rgb2int(
+	const float *r, const float *g, const float *b, const float *a,
+	int *rgb,
+	size_t count, ChannelOrder order = ChannelOrder::ARGB);
+
+
+// Converts count packed colors from one channel order to
+// another, in place.
+GM_COLOR_API void swizzle(int *rgb, size_t count, ChannelOrder from, ChannelOrder to);
+
+
+// The Porter-Duff compositing operators, as well as Plus (additive,
+// clamped). Where "source" is composited onto "destination", e.g.
+// SourceOver is the equivalent of (OpenGL, premultiplied alpha):
+// glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+//
+// Reference: https://www.w3.org/TR/compositing-1/#porterduffcompositingoperators
+enum class CompositeMode
+{
+	Clear,
+	Source,
+	Destination,
+	SourceOver,
+	DestinationOver,
+	SourceIn,
+	DestinationIn,
+	SourceOut,
+	DestinationOut,
+	SourceAtop,
+	DestinationAtop,
+	Xor,
+	Plus,
+};
+
+enum class AlphaMode
+{
+	Straight,
+	Premultiplied,
+};
+
+
+// Composites count RGBA pixels of src onto dst, storing the result
+// in dst. Alpha must be the last channel of every pixel, the order
+// of the other channels doesn't matter.
+//
+// Unlike blend(), the straight alpha mode also produces the
+// straight alpha result of the operator. Which for SourceOver is:
+//   resA = srcA + dstA * (1 - srcA)
+//   resC = (srcC * srcA + dstC * dstA * (1 - srcA)) / resA
+//
+// Runs of fully transparent source pixels (which leave dst as is)
+// and fully opaque source pixels (which replace dst) are skipped.
+//
+// The 8-bit versions multiply in integers, where every product
+// is divided by 255 and rounded to the nearest integer. The
+// straight alpha result is then rounded to the nearest integer.
+GM_COLOR_API void composite(
+	const unsigned char *src, unsigned char *dst, size_t count,
+	CompositeMode mode = CompositeMode::SourceOver, AlphaMode alphaMode = AlphaMode::Premultiplied);
+
+GM_COLOR_API void composite(
+	const float *src, float *dst, size_t count,
+	CompositeMode mode = CompositeMode::SourceOver, AlphaMode alphaMode = AlphaMode::Premultiplied);
+
+// Composites a width x height tile, where the strides
+// are the number of pixels between each scanline.
+GM_COLOR_API void composite(
+	const unsigned char *src, size_t srcStride,
+	unsigned char *dst, size_t dstStride,
+	size_t width, size_t height,
+	CompositeMode mode = CompositeMode::SourceOver, AlphaMode alphaMode = AlphaMode::Premultiplied);
+
+GM_COLOR_API void composite(
+	const float *src, size_t srcStride,
+	float *dst, size_t dstStride,
+	size_t width, size_t height,
+	CompositeMode mode = CompositeMode::SourceOver, AlphaMode alphaMode = AlphaMode::Premultiplied);
+
+
+
+// The luma coefficients of grayscale(). Rec709 is the
+// same weighting as used by the scalar grayscale().
+//
+// Reference: https://en.wikipedia.org/wiki/Luma_(video)
+enum class LumaWeights
+{
+	Rec601,
+	Rec709,
+};
+
+
+// Converts count 8-bit RGB or RGBA (channels = 3 or 4) pixels to
+// 8-bit or 16-bit luma, using fixed-point integer arithmetic.
+//
+// The weights are Q15 fixed-point numbers, rounded such that they
+// sum to exactly 32768:
+//   Rec601 = 9798, 19235, 3735
+//   Rec709 = 6966, 23436, 2366
+//
+// Which are then rounded half up:
+//   Y8  = (Wr * R + Wg * G + Wb * B + 16384) >> 15
+//   Y16 = ((Wr * R + Wg * G + Wb * B) * 257 + 16384) >> 15
+//
+// Thereby white is exactly 255 (or 65535) and the SIMD and
+// scalar paths are bit-exact.
+GM_COLOR_API void grayscale(
+	const unsigned char *rgb, unsigned char *gray, size_t count,
+	int channels = 3, LumaWeights weights = LumaWeights::Rec709);
+
+GM_COLOR_API void grayscale(
+	const unsigned char *rgb, unsigned short *gray, size_t count,
+	int channels = 3, LumaWeights weights = LumaWeights::Rec709);
+
+
+
+// Converts between sRGB and linear RGB, i.e. applies the sRGB
+// transfer function (or its inverse) to a single channel.
+// All other functions in this library treat colors as linear.
+//
+// Range [0;1]
+//
+// Reference: https://en.wikipedia.org/wiki/SRGB
+template<typename T> GM_COLOR_API T srgb2linear(const T &x);
+template<typename T> GM_COLOR_API T linear2srgb(const T &x);
+
+
+// Batch versions of srgb2linear() and linear2srgb(). The 8-bit
+// decode uses a 256-entry table, and is exact (to float precision).
+//
+// The float versions use a vectorized exp2/log2 approximation
+// (see gm_simd.hpp), with a max relative error of 1E-6 compared
+// to the scalar functions. The 8-bit encode clamps to [0;1] and
+// rounds to the nearest integer, which matches the exactly rounded
+// result unless the value is within 1E-4 of a rounding boundary.
+GM_COLOR_API void srgb2linear(const unsigned char *srgb, float *linear, size_t count);
+GM_COLOR_API void srgb2linear(const float *srgb, float *linear, size_t count);
+
+GM_COLOR_API void linear2srgb(const float *linear, float *srgb, size_t count);
+GM_COLOR_API void linear2srgb(const float *linear, unsigned char *srgb, size_t count);
+
+
+// The equivalent of decoding the 8-bit sRGB pixels with
+// srgb2linear(), applying composite() or grayscale() in linear
+// float, and encoding the result with linear2srgb(). However, this
+// is done in a single pass, in blocks small enough to stay in cache.
+//
+// Alpha is always linear. With AlphaMode::Premultiplied the
+// decoded colors are treated as premultiplied.
+GM_COLOR_API void compositeSRGB(
+	const unsigned char *src, unsigned char *dst, size_t count,
+	CompositeMode mode = CompositeMode::SourceOver, AlphaMode alphaMode = AlphaMode::Straight);
+
+GM_COLOR_API void grayscaleSRGB(
+	const unsigned char *rgb, unsigned char *gray, size_t count,
+	int channels = 3, LumaWeights weights = LumaWeights::Rec709);
+
+enum class LUTInterpolation
+{
+	Trilinear,
+	Tetrahedral,
+};
+
+
+// A 3D color lookup table, for baking any (composed) color
+// transform, e.g. rgb2hsl(), adjusting the saturation and then
+// hsl2rgb(), into a size * size * size grid. Which is then applied
+// with a handful of vectorized gathers per pixel.
+//
+// Common sizes are 17, 33 and 65. The table stores 4 floats per
+// entry, i.e. 33 is 575 KB and 65 is 4.4 MB.
+//
+// The input of apply() is clamped to [0;1], the output isn't.
+class ColorLUT
+{
+public:
+	explicit ColorLUT(int size = 33);
+
+	int size() const;
+	bool baked() const;
+
+	// Calls transform(r, g, b, &outR, &outG, &outB) for every entry,
+	// with r, g and b in [0;1]. The entries are split across the
+	// threads of the pool, thereby transform must be thread-safe.
+	// If transform throws, the exception is rethrown and the LUT is
+	// left partially baked.
+	//
+	// Forces the next update() to bake, as the table no longer
+	// matches the params given to it.
+	template<typename Transform> void bake(const Transform &transform, ThreadPool &pool = defaultThreadPool());
+
+	// Same as bake(), however only if params differs (byte for byte)
+	// from the params given to the previous update(). Thereby the
+	// LUT is only rebaked when the parameters change. Returns true
+	// if the LUT was baked.
+	//
+	// Params must be trivially copyable, e.g. a struct of floats.
+	template<typename Params, typename Transform> bool update(const Params &params, const Transform &transform, ThreadPool &pool = defaultThreadPool());
+
+	// Forces the next update() to bake.
+	void invalidate();
+
+	// Transforms count colors. The planar version takes an array
+	// per channel, the interleaved version takes pixels of 3 (RGB)
+	// or 4 (RGBA) channels, where alpha is copied as is. Outputs may
+	// alias the inputs, and any output channel may be nullptr.
+	//
+	// Tetrahedral needs 4 lookups per pixel instead of 8, and
+	// preserves neutral colors (r = g = b) along the diagonal.
+	void apply(
+		const float *r, const float *g, const float *b,
+		float *outR, float *outG, float *outB,
+		size_t count, LUTInterpolation interpolation = LUTInterpolation::Tetrahedral) const;
+
+	void apply(
+		const float *rgb, float *out, size_t count,
+		int channels = 3, LUTInterpolation interpolation = LUTInterpolation::Tetrahedral) const;
+
+private:
+	int n;
+
+	std::vector<float> table;
+	std::vector<unsigned char> params;
+
+	bool isBaked;
+	bool hasParams;
+};
+
+// A tile of planar RGBA pixels in the range [0;1], as given to
+// the stages of a ColorPipeline. Where first is the index of the
+// tile's first pixel in the image.
+struct ColorTile
+{
+	float *r, *g, *b, *a;
+
+	size_t first;
+	size_t count;
+};
+
+typedef std::function<void(ColorTile &tile)> ColorStage;
+
+
+struct ColorStageStats
+{
+	std::string name;
+
+	// The time spent, summed across all threads
+	double seconds;
+	size_t pixels;
+
+	// Pixels per second
+	double throughput() const;
+};
+
+
+// Runs a chain of stages over an image of packed colors in a single
+// pass. The image is unpacked (int2rgb()) into cache sized tiles, which
+// go through every stage before being packed again (rgb2int()). The
+// tiles are spread across the threads of a ThreadPool.
+//
+// Thereby every pixel is read and written once, regardless of the
+// number of stages. Stages are called concurrently with different
+// tiles, and must be thread-safe.
+class ColorPipeline
+{
+public:
+	// The default of 2048 pixels is 32 KB of planar floats per tile.
+	explicit ColorPipeline(size_t tileSize = 2048);
+
+	ColorPipeline& add(const std::string &name, const ColorStage &stage);
+	void clear();
+
+	size_t size() const;
+
+	// src and dst may be the same.
+	void run(
+		const int *src, int *dst, size_t count,
+		ChannelOrder order = ChannelOrder::ARGB, ThreadPool &pool = defaultThreadPool());
+
+	// The time spent in each stage, accumulated over every run().
+	// The first and the last entry are the unpacking and packing.
+	const std::vector<ColorStageStats>& stats() const;
+
+	// The wall clock time and pixels of every run().
+	double seconds() const;
+	size_t pixels() const;
+
+	// Pixels per second, for the whole pipeline.
+	double throughput() const;
+
+	void resetStats();
+
+private:
+	size_t tileSize;
+
+	std::vector<ColorStage> stages;
+	std::vector<ColorStageStats> statistics;
+
+	double totalSeconds;
+	size_t totalPixels;
+};
+
+
+// Stages for ColorPipeline.
+
+// Converts to HSL, offsets the hue (wrapping around), scales
+// the saturation and lightness (clamped to [0;1]) and converts
+// back to RGB, all in one go.
+GM_COLOR_API ColorStage adjustHSLStage(float hueShift, float saturation = 1.0f, float lightness = 1.0f);
+
+// Blends the color (or the overlay image, which must have the same
+// size as the image given to run()) over the tile, like blend().
+GM_COLOR_API ColorStage blendStage(float r, float g, float b, float a);
+GM_COLOR_API ColorStage blendStage(const int *overlay, ChannelOrder order = ChannelOrder::ARGB);
+
+// Replaces the colors with their luma, see grayscale().
+GM_COLOR_API ColorStage grayscaleStage(LumaWeights weights = LumaWeights::Rec709);
+
+// Applies the LUT, which must outlive the stage.
+GM_COLOR_API ColorStage lutStage(const ColorLUT &lut, LUTInterpolation interpolation = LUTInterpolation::Tetrahedral);
+
+// Luminance statistics of an image, as used for auto-exposure.
+struct LuminanceStats
+{
+	size_t count;
+
+	float min, max;
+	float mean;
+
+	// exp(mean(log(Y + 1E-4))), i.e. the geometric
+	// mean, which is less sensitive to outliers
+	float logAverage;
+
+	// For 8-bit images, the histogram has 256 bins, one per luma
+	// value in [0;1] (i.e. grayscale() / 255). For float images
+	// the bins are spread evenly over log2(Y) in the range
+	// [histogramMin;histogramMax], where outliers go to the first
+	// or last bin.
+	std::vector<size_t> histogram;
+	float histogramMin, histogramMax;
+	bool logarithmic;
+
+	// The luminance below which p (in [0;1]) of the pixels lie, e.g.
+	// percentile(0.5f) is the median. The 8-bit percentiles are
+	// exact, the float ones interpolate within the bin.
+	float percentile(float p) const;
+};
+
+
+// Computes the luminance histogram and statistics of count RGB
+// or RGBA (channels = 3 or 4) pixels in a single pass. The pixels
+// are split across the threads of the pool, each with its own
+// histogram, which are merged at the end.
+//
+// The 8-bit version uses the fixed-point grayscale(). The float
+// version is intended for linear HDR images, and uses a log2
+// histogram with bins buckets over [minLog2;maxLog2].
+GM_COLOR_API LuminanceStats luminanceStats(
+	const unsigned char *rgb, size_t count,
+	int channels = 4, LumaWeights weights = LumaWeights::Rec709,
+	ThreadPool &pool = defaultThreadPool());
+
+GM_COLOR_API LuminanceStats luminanceStats(
+	const float *rgb, size_t count,
+	int channels = 4, LumaWeights weights = LumaWeights::Rec709,
+	float minLog2 = -16.0f, float maxLog2 = 16.0f, size_t bins = 256,
+	ThreadPool &pool = defaultThreadPool());
+
+enum class PaletteDistance
+{
+	// Euclidean distance between the 8-bit RGB values
+	RGB,
+	// Euclidean distance in the HSL cylinder, i.e. between
+	// (S cos(H), S sin(H), L), such that hue wraps around and
+	// is insignificant for unsaturated colors
+	HSL,
+};
+
+
+// A palette of (at most 256) packed colors, for finding the nearest
+// palette color. The color space is split into a 16 * 16 * 16 grid,
+// where each cell lists the only palette colors that can be nearest
+// to any color within it. Thereby a lookup only compares against a
+// handful of colors, instead of the whole palette.
+//
+// Ties are broken by the lowest index, such that the result is
+// the same as a linear scan. Alpha is ignored when comparing.
+// An empty palette gives index 0, while remap() and dither()
+// leave their results untouched.
+class Palette
+{
+public:
+	Palette(
+		const int *colors, size_t count,
+		PaletteDistance distance = PaletteDistance::RGB,
+		ChannelOrder order = ChannelOrder::ARGB);
+
+	size_t size() const;
+	int color(size_t index) const;
+
+	size_t nearest(int color) const;
+
+	// Batch versions of nearest(), which either give the index or the
+	// palette color. Repeated colors are looked up in a small cache.
+	void nearest(const int *colors, unsigned char *indices, size_t count) const;
+	void remap(const int *colors, int *result, size_t count) const;
+
+	// Maps a width * height image (with rows stride colors apart) to
+	// width * height palette indices, diffusing the error in RGB with
+	// Floyd-Steinberg.
+	void dither(const int *image, size_t width, size_t height, size_t stride, unsigned char *indices) const;
+
+private:
+	void _embed(float r, float g, float b, float point[3]) const;
+	void _unpack(int color, float rgb[3]) const;
+
+	size_t _nearest(const float rgb[3]) const;
+	void _nearest(const int *colors, unsigned char *indices, size_t count, unsigned int *cacheKeys, unsigned char *cacheValues) const;
+
+	PaletteDistance distance;
+	int shifts[4];
+
+	std::vector<int> colors;
+	std::vector<float> points;
+
+	// The bounds of the (embedded) color space
+	float lower[3];
+	float scale[3];
+
+	// The candidates of cell i are candidates[offsets[i]] up to
+	// candidates[offsets[i + 1]], in ascending order
+	std::vector<unsigned int> offsets;
+	std::vector<unsigned char> candidates;
+};
+
+
 // After this point everything you'll see is all
 // the definitions to the prior declarations.
 
 
-GM_COLOR_API void int2rgb(const int rgb, int *r, int *g, int *b, int *a)
+GM_COLOR_API inline void int2rgb(const int rgb, int *r, int *g, int *b, int *a)
 {
 	if (a) (*a) = (rgb >> 24) & 0xFF;
 	if (r) (*r) = (rgb >> 16) & 0xFF;
@@ -116,7 +640,7 @@ GM_COLOR_API void int2rgb(const int rgb, int *r, int *g, int *b, int *a)
 	if (b) (*b) = rgb & 0xFF;
 }
 
-GM_COLOR_API int rgb2int(const int r, const int g, const int b, const int a)
+GM_COLOR_API inline int rgb2int(const int r, const int g, const int b, const int a)
 {
 	return ((a & 0xFF) << 24) | ((r & 0xFF) << 16) | ((g & 0xFF) << 8) | (b & 0xFF);
 }
@@ -132,9 +656,12 @@ template<typename T> GM_COLOR_API T grayscale(T r, T g, T b)
 	return (r * T(0.2126) + g * T(0.7152) + b * T(0.0722)); // Better
 }
 
-template<> GM_COLOR_API int grayscale(int r, int g, int b)
+// Same weighting in Q15 fixed-point, rounded to the nearest
+// integer. See the batch grayscale() further below. The sum is
+// computed in 64-bit, so any int range can be used.
+template<> inline int grayscale(int r, int g, int b)
 {
-	return static_cast<int>(grayscale<double>(static_cast<double>(r) / 255.0, static_cast<double>(g) / 255.0, static_cast<double>(b) / 255.0) * 255.0);
+	return static_cast<int>((static_cast<int64_t>(r) * 6966 + static_cast<int64_t>(g) * 23436 + static_cast<int64_t>(b) * 2366 + 16384) >> 15);
 }
 
 
@@ -237,6 +764,2225 @@ template<typename T> GM_COLOR_API void rgb2hcv(
 }
 
 
+// The vector kernels mirror the scalar functions above, with
+// the branches in rgb2hcv() replaced by selects.
+
+struct _gm_hue2rgb_kernel
+{
+	template<typename V> void operator()(const V &hue, V &r, V &g, V &b) const
+	{
+		const V h6 = hue * V(6.0f);
+
+		r = simd::clamp(simd::abs(h6 - V(3.0f)) - V(1.0f), V(0.0f), V(1.0f));
+		g = simd::clamp(V(2.0f) - simd::abs(h6 - V(2.0f)), V(0.0f), V(1.0f));
+		b = simd::clamp(V(2.0f) - simd::abs(h6 - V(4.0f)), V(0.0f), V(1.0f));
+	}
+};
+
+struct _gm_hsl2rgb_kernel
+{
+	template<typename V> void operator()(const V &h, const V &s, const V &l, V &r, V &g, V &b) const
+	{
+		_gm_hue2rgb_kernel()(h, r, g, b);
+
+		const V c = (V(1.0f) - simd::abs(V(2.0f) * l - V(1.0f))) * s;
+
+		r = (r - V(0.5f)) * c + l;
+		g = (g - V(0.5f)) * c + l;
+		b = (b - V(0.5f)) * c + l;
+	}
+};
+
+struct _gm_rgb2hcv_kernel
+{
+	template<typename V> void operator()(const V &r, const V &g, const V &b, V &h, V &c, V &v) const
+	{
+		const auto gltb = (g < b);
+
+		const V x = simd::select(gltb, b, g);
+		const V y = simd::select(gltb, g, b);
+		const V z = simd::select(gltb, V(-1.0f), V(0.0f));
+		const V w = simd::select(gltb, V(2.0f / 3.0f), V(-1.0f / 3.0f));
+
+		const auto rltx = (r < x);
+
+		const V x2 = simd::select(rltx, x, r);
+		const V y2 = simd::select(rltx, r, x);
+		const V z2 = simd::select(rltx, w, z);
+
+		c = x2 - simd::min(y2, y);
+		h = simd::abs((y2 - y) / (V(6.0f) * c + V(1E-10f)) + z2);
+		v = x2;
+	}
+};
+
+struct _gm_rgb2hsl_kernel
+{
+	template<typename V> void operator()(const V &r, const V &g, const V &b, V &h, V &s, V &l) const
+	{
+		V c, v;
+		_gm_rgb2hcv_kernel()(r, g, b, h, c, v);
+
+		l = v - c * V(0.5f);
+		s = c / (V(1.0f) - simd::abs(l * V(2.0f) - V(1.0f)) + V(1E-10f));
+	}
+};
+
+
+template<typename Kernel> GM_COLOR_API void _gm_color_planar(
+	const float *in0, const float *in1, const float *in2,
+	float *out0, float *out1, float *out2,
+	size_t count, const Kernel &kernel)
+{
+	typedef simd::vfloat V;
+
+	V a, b, c;
+	size_t i = 0;
+
+	for (; (i + V::width) <= count; i += V::width)
+	{
+		kernel(V::loadu(in0 + i), V::loadu(in1 + i), V::loadu(in2 + i), a, b, c);
+
+		if (out0) a.storeu(out0 + i);
+		if (out1) b.storeu(out1 + i);
+		if (out2) c.storeu(out2 + i);
+	}
+
+	if (i < count)
+	{
+		const size_t n = count - i;
+
+		kernel(simd::loadPartial<V>(in0 + i, n), simd::loadPartial<V>(in1 + i, n), simd::loadPartial<V>(in2 + i, n), a, b, c);
+
+		if (out0) simd::storePartial(a, out0 + i, n);
+		if (out1) simd::storePartial(b, out1 + i, n);
+		if (out2) simd::storePartial(c, out2 + i, n);
+	}
+}
+
+// Interleaved pixels are split into planar blocks
+// on the stack, converted, and then merged back.
+template<typename Kernel> GM_COLOR_API void _gm_color_interleaved(
+	const float *src, float *dst,
+	size_t count, int channels, const Kernel &kernel)
+{
+	const size_t BLOCK_SIZE = 256;
+
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float block[3][BLOCK_SIZE];
+
+	const size_t stride = static_cast<size_t>(channels);
+
+	for (size_t first = 0; first < count; first += BLOCK_SIZE)
+	{
+		const size_t n = ((count - first) < BLOCK_SIZE) ? (count - first) : BLOCK_SIZE;
+
+		const float *in = src + first * stride;
+		float *out = dst + first * stride;
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			block[0][i] = in[i * stride + 0];
+			block[1][i] = in[i * stride + 1];
+			block[2][i] = in[i * stride + 2];
+		}
+
+		_gm_color_planar(block[0], block[1], block[2], block[0], block[1], block[2], n, kernel);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			out[i * stride + 0] = block[0][i];
+			out[i * stride + 1] = block[1][i];
+			out[i * stride + 2] = block[2][i];
+		}
+
+		if ((channels == 4) && (in != out))
+			for (size_t i = 0; i < n; ++i)
+				out[i * 4 + 3] = in[i * 4 + 3];
+	}
+}
+
+
+struct _gm_hue2rgb_planar_kernel
+{
+	template<typename V> void operator()(const V &hue, const V&, const V&, V &r, V &g, V &b) const
+	{
+		_gm_hue2rgb_kernel()(hue, r, g, b);
+	}
+};
+
+GM_COLOR_API inline void hue2rgb(
+	const float *hue,
+	float *r, float *g, float *b,
+	size_t count)
+{
+	_gm_color_planar(hue, hue, hue, r, g, b, count, _gm_hue2rgb_planar_kernel());
+}
+
+
+GM_COLOR_API inline void hsl2rgb(
+	const float *h, const float *s, const float *l,
+	float *r, float *g, float *b,
+	size_t count)
+{
+	_gm_color_planar(h, s, l, r, g, b, count, _gm_hsl2rgb_kernel());
+}
+
+GM_COLOR_API inline void rgb2hsl(
+	const float *r, const float *g, const float *b,
+	float *h, float *s, float *l,
+	size_t count)
+{
+	_gm_color_planar(r, g, b, h, s, l, count, _gm_rgb2hsl_kernel());
+}
+
+GM_COLOR_API inline void rgb2hcv(
+	const float *r, const float *g, const float *b,
+	float *h, float *c, float *v,
+	size_t count)
+{
+	_gm_color_planar(r, g, b, h, c, v, count, _gm_rgb2hcv_kernel());
+}
+
+
+GM_COLOR_API inline void hsl2rgb(const float *hsl, float *rgb, size_t count, int channels)
+{
+	_gm_color_interleaved(hsl, rgb, count, channels, _gm_hsl2rgb_kernel());
+}
+
+GM_COLOR_API inline void rgb2hsl(const float *rgb, float *hsl, size_t count, int channels)
+{
+	_gm_color_interleaved(rgb, hsl, count, channels, _gm_rgb2hsl_kernel());
+}
+
+GM_COLOR_API inline void rgb2hcv(const float *rgb, float *hcv, size_t count, int channels)
+{
+	_gm_color_interleaved(rgb, hcv, count, channels, _gm_rgb2hcv_kernel());
+}
+
+
+// Returns the shift of each channel (in the order R, G, B, A)
+// within a packed color of the given order.
+GM_COLOR_API inline void _gm_channel_shifts(ChannelOrder order, int shifts[4])
+{
+	switch (order)
+	{
+	case ChannelOrder::RGBA: shifts[0] = 24; shifts[1] = 16; shifts[2] = 8; shifts[3] = 0; break;
+	case ChannelOrder::BGRA: shifts[0] = 8; shifts[1] = 16; shifts[2] = 24; shifts[3] = 0; break;
+	case ChannelOrder::ABGR: shifts[0] = 0; shifts[1] = 8; shifts[2] = 16; shifts[3] = 24; break;
+	case ChannelOrder::ARGB:
+	default:                 shifts[0] = 16; shifts[1] = 8; shifts[2] = 0; shifts[3] = 24; break;
+	}
+}
+
+
+GM_COLOR_API inline void int2rgb(
+	const int *rgb,
+	unsigned char *r, unsigned char *g, unsigned char *b, unsigned char *a,
+	size_t count, ChannelOrder order)
+{
+	int shifts[4];
+	_gm_channel_shifts(order, shifts);
+
+	unsigned char *channels[4] = { r, g, b, a };
+
+	size_t i = 0;
+
+#if defined(__SSSE3__) && !defined(GM_SIMD_SCALAR)
+	// Shuffle each group of 4 pixels so that every 32-bit lane holds
+	// one channel, and then transpose the 4x4 lanes of 4 groups.
+	GM_SIMD_ALIGN(16) unsigned char indices[16];
+
+	for (int channel = 0; channel < 4; ++channel)
+		for (int pixel = 0; pixel < 4; ++pixel)
+			indices[channel * 4 + pixel] = static_cast<unsigned char>(pixel * 4 + shifts[channel] / 8);
+
+	const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(indices));
+
+	for (; (i + 16) <= count; i += 16)
+	{
+		const __m128i *src = reinterpret_cast<const __m128i*>(rgb + i);
+
+		const __m128i x0 = _mm_shuffle_epi8(_mm_loadu_si128(src + 0), shuffle);
+		const __m128i x1 = _mm_shuffle_epi8(_mm_loadu_si128(src + 1), shuffle);
+		const __m128i x2 = _mm_shuffle_epi8(_mm_loadu_si128(src + 2), shuffle);
+		const __m128i x3 = _mm_shuffle_epi8(_mm_loadu_si128(src + 3), shuffle);
+
+		const __m128i t0 = _mm_unpacklo_epi32(x0, x1);
+		const __m128i t1 = _mm_unpacklo_epi32(x2, x3);
+		const __m128i t2 = _mm_unpackhi_epi32(x0, x1);
+		const __m128i t3 = _mm_unpackhi_epi32(x2, x3);
+
+		if (r) _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i), _mm_unpacklo_epi64(t0, t1));
+		if (g) _mm_storeu_si128(reinterpret_cast<__m128i*>(g + i), _mm_unpackhi_epi64(t0, t1));
+		if (b) _mm_storeu_si128(reinterpret_cast<__m128i*>(b + i), _mm_unpacklo_epi64(t2, t3));
+		if (a) _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), _mm_unpackhi_epi64(t2, t3));
+	}
+#elif !defined(GM_SIMD_SCALAR)
+	const __m128i mask = _mm_set1_epi32(0xFF);
+
+	for (; (i + 16) <= count; i += 16)
+	{
+		const __m128i *src = reinterpret_cast<const __m128i*>(rgb + i);
+
+		const __m128i x0 = _mm_loadu_si128(src + 0);
+		const __m128i x1 = _mm_loadu_si128(src + 1);
+		const __m128i x2 = _mm_loadu_si128(src + 2);
+		const __m128i x3 = _mm_loadu_si128(src + 3);
+
+		for (int channel = 0; channel < 4; ++channel)
+		{
+			if (!channels[channel])
+				continue;
+
+			const __m128i shift = _mm_cvtsi32_si128(shifts[channel]);
+
+			const __m128i c0 = _mm_and_si128(_mm_srl_epi32(x0, shift), mask);
+			const __m128i c1 = _mm_and_si128(_mm_srl_epi32(x1, shift), mask);
+			const __m128i c2 = _mm_and_si128(_mm_srl_epi32(x2, shift), mask);
+			const __m128i c3 = _mm_and_si128(_mm_srl_epi32(x3, shift), mask);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(channels[channel] + i), _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3)));
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+		for (int channel = 0; channel < 4; ++channel)
+			if (channels[channel])
+				channels[channel][i] = static_cast<unsigned char>(static_cast<unsigned int>(rgb[i]) >> shifts[channel]);
+}
+
+GM_COLOR_API inline void int2rgb(
+	const int *rgb,
+	float *r, float *g, float *b, float *a,
+	size_t count, ChannelOrder order)
+{
+	typedef simd::vfloat V;
+	typedef simd::vint VI;
+
+	int shifts[4];
+	_gm_channel_shifts(order, shifts);
+
+	float *channels[4] = { r, g, b, a };
+
+	size_t i = 0;
+
+	for (; (i + V::width) <= count; i += V::width)
+	{
+		const VI x = VI::loadu(rgb + i);
+
+		for (int channel = 0; channel < 4; ++channel)
+			if (channels[channel])
+				(simd::toFloat(simd::srl(x, shifts[channel]) & VI(0xFF)) * V(1.0f / 255.0f)).storeu(channels[channel] + i);
+	}
+
+	for (; i < count; ++i)
+		for (int channel = 0; channel < 4; ++channel)
+			if (channels[channel])
+				channels[channel][i] = static_cast<float>((static_cast<unsigned int>(rgb[i]) >> shifts[channel]) & 0xFF) * (1.0f / 255.0f);
+}
+
+
+GM_COLOR_API inline void rgb2int(
+	const unsigned char *r, const unsigned char *g, const unsigned char *b, const unsigned char *a,
+	int *rgb,
+	size_t count, ChannelOrder order)
+{
+	int shifts[4];
+	_gm_channel_shifts(order, shifts);
+
+	const unsigned char *channels[4] = { r, g, b, a };
+
+	size_t i = 0;
+
+#if !defined(GM_SIMD_SCALAR)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i opaque = _mm_set1_epi32(0xFF << shifts[3]);
+
+	for (; (i + 16) <= count; i += 16)
+	{
+		__m128i x0 = a ? zero : opaque;
+		__m128i x1 = x0, x2 = x0, x3 = x0;
+
+		for (int channel = 0; channel < 4; ++channel)
+		{
+			if (!channels[channel])
+				continue;
+
+			const __m128i shift = _mm_cvtsi32_si128(shifts[channel]);
+
+			const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(channels[channel] + i));
+			const __m128i lo = _mm_unpacklo_epi8(c, zero);
+			const __m128i hi = _mm_unpackhi_epi8(c, zero);
+
+			x0 = _mm_or_si128(x0, _mm_sll_epi32(_mm_unpacklo_epi16(lo, zero), shift));
+			x1 = _mm_or_si128(x1, _mm_sll_epi32(_mm_unpackhi_epi16(lo, zero), shift));
+			x2 = _mm_or_si128(x2, _mm_sll_epi32(_mm_unpacklo_epi16(hi, zero), shift));
+			x3 = _mm_or_si128(x3, _mm_sll_epi32(_mm_unpackhi_epi16(hi, zero), shift));
+		}
+
+		__m128i *dst = reinterpret_cast<__m128i*>(rgb + i);
+
+		_mm_storeu_si128(dst + 0, x0);
+		_mm_storeu_si128(dst + 1, x1);
+		_mm_storeu_si128(dst + 2, x2);
+		_mm_storeu_si128(dst + 3, x3);
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		unsigned int x = a ? 0u : (0xFFu << shifts[3]);
+
+		for (int channel = 0; channel < 4; ++channel)
+			if (channels[channel])
+				x |= static_cast<unsigned int>(channels[channel][i]) << shifts[channel];
+
+		rgb[i] = static_cast<int>(x);
+	}
+}
+
+GM_COLOR_API inline void rgb2int(
+	const float *r, const float *g, const float *b, const float *a,
+	int *rgb,
+	size_t count, ChannelOrder order)
+{
+	typedef simd::vfloat V;
+	typedef simd::vint VI;
+
+	int shifts[4];
+	_gm_channel_shifts(order, shifts);
+
+	const float *channels[4] = { r, g, b, a };
+
+	const int opaque = static_cast<int>(0xFFu << shifts[3]);
+
+	size_t i = 0;
+
+	for (; (i + V::width) <= count; i += V::width)
+	{
+		VI x = a ? VI(0) : VI(opaque);
+
+		for (int channel = 0; channel < 4; ++channel)
+			if (channels[channel])
+				x = x | simd::sll(simd::toInt(simd::clamp(V::loadu(channels[channel] + i), V(0.0f), V(1.0f)) * V(255.0f) + V(0.5f)), shifts[channel]);
+
+		x.storeu(rgb + i);
+	}
+
+	for (; i < count; ++i)
+	{
+		unsigned int x = a ? 0u : static_cast<unsigned int>(opaque);
+
+		for (int channel = 0; channel < 4; ++channel)
+		{
+			if (!channels[channel])
+				continue;
+
+			const float c = channels[channel][i];
+			const float clamped = (c > 1.0f) ? 1.0f : ((0.0f < c) ? c : 0.0f);
+
+			x |= static_cast<unsigned int>(clamped * 255.0f + 0.5f) << shifts[channel];
+		}
+
+		rgb[i] = static_cast<int>(x);
+	}
+}
+
+
+GM_COLOR_API inline void swizzle(int *rgb, size_t count, ChannelOrder from, ChannelOrder to)
+{
+	if (from == to)
+		return;
+
+	int src[4], dst[4];
+	_gm_channel_shifts(from, src);
+	_gm_channel_shifts(to, dst);
+
+	// indices[i] is the byte of the source color, that
+	// ends up as byte i of the destination color.
+	unsigned char indices[4];
+
+	for (int channel = 0; channel < 4; ++channel)
+		indices[dst[channel] / 8] = static_cast<unsigned char>(src[channel] / 8);
+
+	size_t i = 0;
+
+#if defined(__SSSE3__) && !defined(GM_SIMD_SCALAR)
+	GM_SIMD_ALIGN(64) unsigned char shuffle[64];
+
+	for (int j = 0; j < 64; ++j)
+		shuffle[j] = static_cast<unsigned char>((j & 12) + indices[j & 3]);
+
+#	if defined(GM_SIMD_AVX512) && defined(__AVX512BW__)
+	const __m512i shuffle512 = _mm512_load_si512(shuffle);
+
+	for (; (i + 16) <= count; i += 16)
+		_mm512_storeu_si512(rgb + i, _mm512_shuffle_epi8(_mm512_loadu_si512(rgb + i), shuffle512));
+#	endif
+
+#	if defined(GM_SIMD_AVX2) || defined(GM_SIMD_AVX512)
+	const __m256i shuffle256 = _mm256_load_si256(reinterpret_cast<const __m256i*>(shuffle));
+
+	for (; (i + 8) <= count; i += 8)
+	{
+		__m256i *p = reinterpret_cast<__m256i*>(rgb + i);
+		_mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), shuffle256));
+	}
+#	endif
+
+	const __m128i shuffle128 = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle));
+
+	for (; (i + 4) <= count; i += 4)
+	{
+		__m128i *p = reinterpret_cast<__m128i*>(rgb + i);
+		_mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), shuffle128));
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		const unsigned int x = static_cast<unsigned int>(rgb[i]);
+
+		rgb[i] = static_cast<int>(
+			(((x >> (indices[0] * 8)) & 0xFF) << 0) |
+			(((x >> (indices[1] * 8)) & 0xFF) << 8) |
+			(((x >> (indices[2] * 8)) & 0xFF) << 16) |
+			(((x >> (indices[3] * 8)) & 0xFF) << 24));
+	}
+}
+
+
+// Every compositing operator is a pair of factors, by which
+// the source and destination are multiplied and then added.
+// The source factor depends on the destination alpha, and
+// the destination factor depends on the source alpha.
+enum
+{
+	_GM_FACTOR_ZERO,
+	_GM_FACTOR_ONE,
+	_GM_FACTOR_ALPHA,
+	_GM_FACTOR_ONE_MINUS_ALPHA,
+};
+
+template<template<int, int> class Kernel, typename... Args> GM_COLOR_API void _gm_composite_dispatch(CompositeMode mode, Args... args)
+{
+	switch (mode)
+	{
+	case CompositeMode::Clear:           Kernel<_GM_FACTOR_ZERO, _GM_FACTOR_ZERO>::run(args...); break;
+	case CompositeMode::Source:          Kernel<_GM_FACTOR_ONE, _GM_FACTOR_ZERO>::run(args...); break;
+	case CompositeMode::Destination:     Kernel<_GM_FACTOR_ZERO, _GM_FACTOR_ONE>::run(args...); break;
+	case CompositeMode::SourceOver:      Kernel<_GM_FACTOR_ONE, _GM_FACTOR_ONE_MINUS_ALPHA>::run(args...); break;
+	case CompositeMode::DestinationOver: Kernel<_GM_FACTOR_ONE_MINUS_ALPHA, _GM_FACTOR_ONE>::run(args...); break;
+	case CompositeMode::SourceIn:        Kernel<_GM_FACTOR_ALPHA, _GM_FACTOR_ZERO>::run(args...); break;
+	case CompositeMode::DestinationIn:   Kernel<_GM_FACTOR_ZERO, _GM_FACTOR_ALPHA>::run(args...); break;
+	case CompositeMode::SourceOut:       Kernel<_GM_FACTOR_ONE_MINUS_ALPHA, _GM_FACTOR_ZERO>::run(args...); break;
+	case CompositeMode::DestinationOut:  Kernel<_GM_FACTOR_ZERO, _GM_FACTOR_ONE_MINUS_ALPHA>::run(args...); break;
+	case CompositeMode::SourceAtop:      Kernel<_GM_FACTOR_ALPHA, _GM_FACTOR_ONE_MINUS_ALPHA>::run(args...); break;
+	case CompositeMode::DestinationAtop: Kernel<_GM_FACTOR_ONE_MINUS_ALPHA, _GM_FACTOR_ALPHA>::run(args...); break;
+	case CompositeMode::Xor:             Kernel<_GM_FACTOR_ONE_MINUS_ALPHA, _GM_FACTOR_ONE_MINUS_ALPHA>::run(args...); break;
+	case CompositeMode::Plus:            Kernel<_GM_FACTOR_ONE, _GM_FACTOR_ONE>::run(args...); break;
+	}
+}
+
+
+// Divides x (at most 255 * 255) by 255, rounded to the nearest integer.
+GM_COLOR_API inline unsigned int _gm_div255(unsigned int x)
+{
+	x += 128;
+	return (x + (x >> 8)) >> 8;
+}
+
+template<int Factor> GM_COLOR_API inline unsigned int _gm_factor8(unsigned int alpha)
+{
+	return (Factor == _GM_FACTOR_ZERO) ? 0 : ((Factor == _GM_FACTOR_ONE) ? 255 : ((Factor == _GM_FACTOR_ALPHA) ? alpha : (255 - alpha)));
+}
+
+template<int Factor, typename T> GM_COLOR_API inline T _gm_factorf(T alpha)
+{
+	return (Factor == _GM_FACTOR_ZERO) ? T(0) : ((Factor == _GM_FACTOR_ONE) ? T(1) : ((Factor == _GM_FACTOR_ALPHA) ? alpha : (T(1) - alpha)));
+}
+
+// A fully transparent source leaves the destination as is, and a
+// fully opaque source replaces it, depending on the operator. A
+// premultiplied source with alpha 0 can still add color, such that
+// it's only transparent when all of its channels are 0.
+template<int SrcFactor, int DstFactor> struct _gm_composite_skip
+{
+	enum
+	{
+		transparent = (DstFactor == _GM_FACTOR_ONE) || (DstFactor == _GM_FACTOR_ONE_MINUS_ALPHA),
+		opaque = (SrcFactor == _GM_FACTOR_ONE) && ((DstFactor == _GM_FACTOR_ZERO) || (DstFactor == _GM_FACTOR_ONE_MINUS_ALPHA)),
+	};
+};
+
+
+template<int SrcFactor, int DstFactor> GM_COLOR_API inline void _gm_composite_pixel8(const unsigned char *src, unsigned char *dst, bool straight)
+{
+	const unsigned int srcA = src[3], dstA = dst[3];
+
+	const unsigned int srcFactor = _gm_factor8<SrcFactor>(dstA);
+	const unsigned int dstFactor = _gm_factor8<DstFactor>(srcA);
+
+	unsigned int res[4];
+
+	for (int i = 0; i < 4; ++i)
+	{
+		const unsigned int s = (straight && (i < 3)) ? _gm_div255(src[i] * srcA) : src[i];
+		const unsigned int d = (straight && (i < 3)) ? _gm_div255(dst[i] * dstA) : dst[i];
+
+		const unsigned int x = _gm_div255(s * srcFactor) + _gm_div255(d * dstFactor);
+		res[i] = (x > 255) ? 255 : x;
+	}
+
+	if (straight)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			const unsigned int x = (res[3] == 0) ? 0 : static_cast<unsigned int>(static_cast<float>(res[i] * 255) / static_cast<float>(res[3]) + 0.5f);
+			res[i] = (x > 255) ? 255 : x;
+		}
+	}
+
+	for (int i = 0; i < 4; ++i)
+		dst[i] = static_cast<unsigned char>(res[i]);
+}
+
+template<int SrcFactor, int DstFactor, typename T> GM_COLOR_API inline void _gm_composite_pixelf(const T *src, T *dst, bool straight)
+{
+	const T srcA = src[3], dstA = dst[3];
+
+	const T srcFactor = _gm_factorf<SrcFactor>(dstA);
+	const T dstFactor = _gm_factorf<DstFactor>(srcA);
+
+	T res[4];
+
+	for (int i = 0; i < 4; ++i)
+	{
+		const T s = (straight && (i < 3)) ? (src[i] * srcA) : src[i];
+		const T d = (straight && (i < 3)) ? (dst[i] * dstA) : dst[i];
+
+		res[i] = s * srcFactor + d * dstFactor;
+
+		if ((SrcFactor == _GM_FACTOR_ONE) && (DstFactor == _GM_FACTOR_ONE))
+			res[i] = (res[i] > T(1)) ? T(1) : res[i];
+	}
+
+	if (straight)
+		for (int i = 0; i < 3; ++i)
+			res[i] = (res[3] > T(0)) ? (res[i] / res[3]) : T(0);
+
+	for (int i = 0; i < 4; ++i)
+		dst[i] = res[i];
+}
+
+
+#if !defined(GM_SIMD_SCALAR)
+
+// The 8-bit SIMD kernel works on 2 pixels at a time, each channel widened to 16 bits.
+
+GM_COLOR_API inline __m128i _gm_div255_epi16(__m128i x)
+{
+	x = _mm_add_epi16(x, _mm_set1_epi16(128));
+	return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+GM_COLOR_API inline __m128i _gm_alpha_epi16(__m128i x)
+{
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+template<int Factor> GM_COLOR_API inline __m128i _gm_factor_epi16(__m128i alpha)
+{
+	return (Factor == _GM_FACTOR_ZERO) ? _mm_setzero_si128() : ((Factor == _GM_FACTOR_ONE) ? _mm_set1_epi16(255) : ((Factor == _GM_FACTOR_ALPHA) ? alpha : _mm_sub_epi16(_mm_set1_epi16(255), alpha)));
+}
+
+template<int Factor> GM_COLOR_API inline __m128i _gm_mul_factor_epi16(__m128i x, __m128i factor)
+{
+	return (Factor == _GM_FACTOR_ZERO) ? _mm_setzero_si128() : ((Factor == _GM_FACTOR_ONE) ? x : _gm_div255_epi16(_mm_mullo_epi16(x, factor)));
+}
+
+GM_COLOR_API inline __m128i _gm_unpremultiply_epi32(__m128i x)
+{
+	const __m128 c = _mm_cvtepi32_ps(x);
+	const __m128 a = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+
+	const __m128 q = _mm_add_ps(_mm_div_ps(_mm_mul_ps(c, _mm_set1_ps(255.0f)), a), _mm_set1_ps(0.5f));
+	const __m128 zero = _mm_cmpeq_ps(a, _mm_setzero_ps());
+	const __m128 alpha = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+	const __m128 res = _mm_or_ps(_mm_and_ps(alpha, c), _mm_andnot_ps(alpha, _mm_andnot_ps(zero, q)));
+	return _mm_cvttps_epi32(res);
+}
+
+template<int SrcFactor, int DstFactor> GM_COLOR_API inline __m128i _gm_composite_epi16(__m128i s, __m128i d, bool straight)
+{
+	const __m128i srcA = _gm_alpha_epi16(s);
+	const __m128i dstA = _gm_alpha_epi16(d);
+
+	if (straight)
+	{
+		const __m128i alpha = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+		const __m128i opaque = _mm_set1_epi16(255);
+
+		s = _gm_div255_epi16(_mm_mullo_epi16(s, _mm_or_si128(_mm_andnot_si128(alpha, srcA), _mm_and_si128(alpha, opaque))));
+		d = _gm_div255_epi16(_mm_mullo_epi16(d, _mm_or_si128(_mm_andnot_si128(alpha, dstA), _mm_and_si128(alpha, opaque))));
+	}
+
+	const __m128i x = _mm_add_epi16(
+		_gm_mul_factor_epi16<SrcFactor>(s, _gm_factor_epi16<SrcFactor>(dstA)),
+		_gm_mul_factor_epi16<DstFactor>(d, _gm_factor_epi16<DstFactor>(srcA)));
+
+	__m128i res = _mm_min_epi16(x, _mm_set1_epi16(255));
+
+	if (straight)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		res = _mm_packs_epi32(_gm_unpremultiply_epi32(_mm_unpacklo_epi16(res, zero)), _gm_unpremultiply_epi32(_mm_unpackhi_epi16(res, zero)));
+	}
+
+	return res;
+}
+
+#endif
+
+
+template<int SrcFactor, int DstFactor> struct _gm_composite8_kernel
+{
+	static void run(const unsigned char *src, unsigned char *dst, size_t count, bool straight)
+	{
+		typedef _gm_composite_skip<SrcFactor, DstFactor> skip;
+
+		size_t i = 0;
+
+#if !defined(GM_SIMD_SCALAR)
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+		for (; (i + 4) <= count; i += 4)
+		{
+			const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+			const __m128i srcA = _mm_and_si128(s, alphaMask);
+
+			if (skip::transparent && (_mm_movemask_epi8(_mm_cmpeq_epi32(straight ? srcA : s, zero)) == 0xFFFF))
+				continue;
+
+			if (skip::opaque && (_mm_movemask_epi8(_mm_cmpeq_epi32(srcA, alphaMask)) == 0xFFFF))
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), s);
+				continue;
+			}
+
+			const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+
+			const __m128i lo = _gm_composite_epi16<SrcFactor, DstFactor>(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), straight);
+			const __m128i hi = _gm_composite_epi16<SrcFactor, DstFactor>(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), straight);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(lo, hi));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			const unsigned char srcA = src[i * 4 + 3];
+
+			if (skip::transparent && (srcA == 0) && (straight || ((src[i * 4] | src[i * 4 + 1] | src[i * 4 + 2]) == 0)))
+				continue;
+
+			if (skip::opaque && (srcA == 255))
+			{
+				memcpy(dst + i * 4, src + i * 4, 4);
+				continue;
+			}
+
+			_gm_composite_pixel8<SrcFactor, DstFactor>(src + i * 4, dst + i * 4, straight);
+		}
+	}
+};
+
+template<int SrcFactor, int DstFactor> struct _gm_compositef_kernel
+{
+	static void run(const float *src, float *dst, size_t count, bool straight)
+	{
+		typedef _gm_composite_skip<SrcFactor, DstFactor> skip;
+
+		size_t i = 0;
+
+#if GM_SIMD_FLOAT_WIDTH >= 4
+		typedef simd::vfloat V;
+
+		const size_t pixels = V::width / 4;
+
+		GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float lanes[V::width];
+
+		for (int lane = 0; lane < V::width; ++lane)
+			lanes[lane] = ((lane & 3) == 3) ? 1.0f : 0.0f;
+
+		const simd::vmask alpha = (V::load(lanes) != V(0.0f));
+
+		for (; (i + pixels) <= count; i += pixels)
+		{
+			const V s = V::loadu(src + i * 4);
+			const V srcA = simd::splat4<3>(s);
+
+			if (skip::transparent && (straight ? simd::all(srcA <= V(0.0f)) : simd::all(s == V(0.0f))))
+				continue;
+
+			if (skip::opaque && simd::all(srcA >= V(1.0f)))
+			{
+				s.storeu(dst + i * 4);
+				continue;
+			}
+
+			const V d = V::loadu(dst + i * 4);
+			const V dstA = simd::splat4<3>(d);
+
+			const V srcFactor = _gm_factorf<SrcFactor>(dstA);
+			const V dstFactor = _gm_factorf<DstFactor>(srcA);
+
+			V res = straight ?
+				(simd::select(alpha, s, s * srcA) * srcFactor + simd::select(alpha, d, d * dstA) * dstFactor) :
+				(s * srcFactor + d * dstFactor);
+
+			if ((SrcFactor == _GM_FACTOR_ONE) && (DstFactor == _GM_FACTOR_ONE))
+				res = simd::min(res, V(1.0f));
+
+			if (straight)
+			{
+				const V resA = simd::splat4<3>(res);
+				res = simd::select(alpha, res, simd::select(resA > V(0.0f), res / resA, V(0.0f)));
+			}
+
+			res.storeu(dst + i * 4);
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			const float srcA = src[i * 4 + 3];
+
+			if (skip::transparent && (straight ? (srcA <= 0.0f) : ((srcA == 0.0f) && (src[i * 4] == 0.0f) && (src[i * 4 + 1] == 0.0f) && (src[i * 4 + 2] == 0.0f))))
+				continue;
+
+			if (skip::opaque && (srcA >= 1.0f))
+			{
+				memcpy(dst + i * 4, src + i * 4, 4 * sizeof(float));
+				continue;
+			}
+
+			_gm_composite_pixelf<SrcFactor, DstFactor>(src + i * 4, dst + i * 4, straight);
+		}
+	}
+};
+
+
+GM_COLOR_API inline void composite(
+	const unsigned char *src, unsigned char *dst, size_t count,
+	CompositeMode mode, AlphaMode alphaMode)
+{
+	_gm_composite_dispatch<_gm_composite8_kernel>(mode, src, dst, count, alphaMode == AlphaMode::Straight);
+}
+
+GM_COLOR_API inline void composite(
+	const float *src, float *dst, size_t count,
+	CompositeMode mode, AlphaMode alphaMode)
+{
+	_gm_composite_dispatch<_gm_compositef_kernel>(mode, src, dst, count, alphaMode == AlphaMode::Straight);
+}
+
+
+GM_COLOR_API inline void composite(
+	const unsigned char *src, size_t srcStride,
+	unsigned char *dst, size_t dstStride,
+	size_t width, size_t height,
+	CompositeMode mode, AlphaMode alphaMode)
+{
+	for (size_t y = 0; y < height; ++y)
+		composite(src + y * srcStride * 4, dst + y * dstStride * 4, width, mode, alphaMode);
+}
+
+GM_COLOR_API inline void composite(
+	const float *src, size_t srcStride,
+	float *dst, size_t dstStride,
+	size_t width, size_t height,
+	CompositeMode mode, AlphaMode alphaMode)
+{
+	for (size_t y = 0; y < height; ++y)
+		composite(src + y * srcStride * 4, dst + y * dstStride * 4, width, mode, alphaMode);
+}
+
+
+GM_COLOR_API inline void _gm_luma_weights(LumaWeights weights, int w[3])
+{
+	switch (weights)
+	{
+	case LumaWeights::Rec601: w[0] = 9798; w[1] = 19235; w[2] = 3735; break;
+	case LumaWeights::Rec709:
+	default:                  w[0] = 6966; w[1] = 23436; w[2] = 2366; break;
+	}
+}
+
+
+#if !defined(GM_SIMD_SCALAR)
+
+// Given 4 RGBA (or RGB0) pixels, returns the weighted sums
+// of the 4 pixels as 32-bit integers (not yet shifted).
+GM_COLOR_API inline __m128i _gm_luma_epi32(__m128i pixels, __m128i weights)
+{
+	const __m128i zero = _mm_setzero_si128();
+
+	// [R0*Wr + G0*Wg, B0*Wb, R1*Wr + G1*Wg, B1*Wb]
+	const __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), weights);
+	const __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), weights);
+
+	const __m128 even = _mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0));
+	const __m128 odd = _mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(3, 1, 3, 1));
+
+	return _mm_add_epi32(_mm_castps_si128(even), _mm_castps_si128(odd));
+}
+
+// Loads 4 pixels, expanding RGB to RGB0. For RGB this
+// reads 16 bytes, i.e. 4 bytes past the 4th pixel.
+GM_COLOR_API inline __m128i _gm_luma_load(const unsigned char *rgb, int channels)
+{
+	const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb));
+
+#if defined(__SSSE3__)
+	if (channels == 3)
+		return _mm_shuffle_epi8(pixels, _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1));
+#else
+	(void) channels;
+#endif
+
+	return pixels;
+}
+
+GM_COLOR_API inline bool _gm_luma_simd(int channels)
+{
+#if defined(__SSSE3__)
+	return (channels == 3) || (channels == 4);
+#else
+	return (channels == 4);
+#endif
+}
+
+#endif
+
+
+template<typename T> GM_COLOR_API void _gm_grayscale(
+	const unsigned char *rgb, T *gray, size_t count,
+	int channels, LumaWeights weights)
+{
+	int w[3];
+	_gm_luma_weights(weights, w);
+
+	// 8-bit output is (sum + 16384) >> 15, 16-bit output is (sum * 257 + 16384) >> 15
+	const bool wide = (sizeof(T) > 1);
+
+	const size_t stride = static_cast<size_t>(channels);
+
+	size_t i = 0;
+
+#if !defined(GM_SIMD_SCALAR)
+	if (_gm_luma_simd(channels))
+	{
+		const __m128i weights128 = _mm_setr_epi16(
+			static_cast<short>(w[0]), static_cast<short>(w[1]), static_cast<short>(w[2]), 0,
+			static_cast<short>(w[0]), static_cast<short>(w[1]), static_cast<short>(w[2]), 0);
+
+		const __m128i half = _mm_set1_epi32(16384);
+
+		// 16 pixels per iteration, making sure the RGB loads stay in bounds
+		for (; ((i + 12) * stride + 16) <= (count * stride); i += 16)
+		{
+			__m128i y[4];
+
+			for (int j = 0; j < 4; ++j)
+			{
+				__m128i sum = _gm_luma_epi32(_gm_luma_load(rgb + (i + j * 4) * stride, channels), weights128);
+
+				if (wide)
+					sum = _mm_add_epi32(_mm_slli_epi32(sum, 8), sum);
+
+				y[j] = _mm_srli_epi32(_mm_add_epi32(sum, half), 15);
+			}
+
+			if (wide)
+			{
+				// There's no unsigned saturating 32 to 16-bit pack in SSE2,
+				// so bias to signed and back.
+				const __m128i bias32 = _mm_set1_epi32(32768);
+				const __m128i bias16 = _mm_set1_epi16(-32768);
+
+				const __m128i lo = _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(y[0], bias32), _mm_sub_epi32(y[1], bias32)), bias16);
+				const __m128i hi = _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(y[2], bias32), _mm_sub_epi32(y[3], bias32)), bias16);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(gray + i), lo);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(gray + i + 8), hi);
+			}
+			else
+			{
+				const __m128i lo = _mm_packs_epi32(y[0], y[1]);
+				const __m128i hi = _mm_packs_epi32(y[2], y[3]);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(gray + i), _mm_packus_epi16(lo, hi));
+			}
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		const unsigned char *pixel = rgb + i * stride;
+
+		unsigned int sum = w[0] * pixel[0] + w[1] * pixel[1] + w[2] * pixel[2];
+
+		if (wide)
+			sum *= 257;
+
+		gray[i] = static_cast<T>((sum + 16384) >> 15);
+	}
+}
+
+
+GM_COLOR_API inline void grayscale(
+	const unsigned char *rgb, unsigned char *gray, size_t count,
+	int channels, LumaWeights weights)
+{
+	_gm_grayscale(rgb, gray, count, channels, weights);
+}
+
+GM_COLOR_API inline void grayscale(
+	const unsigned char *rgb, unsigned short *gray, size_t count,
+	int channels, LumaWeights weights)
+{
+	_gm_grayscale(rgb, gray, count, channels, weights);
+}
+
+
+template<typename T> GM_COLOR_API T srgb2linear(const T &x)
+{
+	return ((x <= T(0.04045)) ? (x / T(12.92)) : T(pow((x + T(0.055)) / T(1.055), T(2.4))));
+}
+
+template<typename T> GM_COLOR_API T linear2srgb(const T &x)
+{
+	return ((x <= T(0.0031308)) ? (x * T(12.92)) : (T(1.055) * T(pow(x, T(1) / T(2.4))) - T(0.055)));
+}
+
+
+struct _gm_srgb2linear_table
+{
+	float values[256];
+
+	_gm_srgb2linear_table()
+	{
+		for (int i = 0; i < 256; ++i)
+			values[i] = static_cast<float>(srgb2linear<double>(static_cast<double>(i) / 255.0));
+	}
+};
+
+GM_COLOR_API inline const float* _gm_srgb2linear_lut()
+{
+	static const _gm_srgb2linear_table table;
+	return table.values;
+}
+
+
+struct _gm_srgb2linear_kernel
+{
+	template<typename V> V operator()(const V &x) const
+	{
+		const V lo = x * V(1.0f / 12.92f);
+		const V hi = simd::pow((x + V(0.055f)) * V(1.0f / 1.055f), V(2.4f));
+
+		return simd::select(x <= V(0.04045f), lo, hi);
+	}
+};
+
+struct _gm_linear2srgb_kernel
+{
+	template<typename V> V operator()(const V &x) const
+	{
+		const V lo = x * V(12.92f);
+		const V hi = V(1.055f) * simd::pow(x, V(1.0f / 2.4f)) - V(0.055f);
+
+		return simd::select(x <= V(0.0031308f), lo, hi);
+	}
+};
+
+template<typename Kernel> GM_COLOR_API void _gm_transfer(const float *in, float *out, size_t count, const Kernel &kernel)
+{
+	typedef simd::vfloat V;
+
+	size_t i = 0;
+
+	for (; (i + V::width) <= count; i += V::width)
+		kernel(V::loadu(in + i)).storeu(out + i);
+
+	if (i < count)
+		simd::storePartial(kernel(simd::loadPartial<V>(in + i, count - i)), out + i, count - i);
+}
+
+
+// Encodes count linear values (each stride floats apart) to 8-bit sRGB.
+GM_COLOR_API inline void _gm_linear2srgb8(const float *linear, size_t stride, unsigned char *srgb, size_t count)
+{
+	typedef simd::vfloat V;
+
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float in[V::width];
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) int out[V::width];
+
+	for (size_t i = 0; i < count; i += V::width)
+	{
+		const size_t n = ((count - i) < static_cast<size_t>(V::width)) ? (count - i) : static_cast<size_t>(V::width);
+
+		if (stride == 1)
+			memcpy(in, linear + i, n * sizeof(float));
+		else
+			for (size_t j = 0; j < n; ++j)
+				in[j] = linear[(i + j) * stride];
+
+		const V x = simd::clamp(V::load(in), V(0.0f), V(1.0f));
+		simd::toInt(_gm_linear2srgb_kernel()(x) * V(255.0f) + V(0.5f)).store(out);
+
+		for (size_t j = 0; j < n; ++j)
+			srgb[(i + j) * stride] = static_cast<unsigned char>(out[j]);
+	}
+}
+
+
+GM_COLOR_API inline void srgb2linear(const unsigned char *srgb, float *linear, size_t count)
+{
+	const float *lut = _gm_srgb2linear_lut();
+
+	for (size_t i = 0; i < count; ++i)
+		linear[i] = lut[srgb[i]];
+}
+
+GM_COLOR_API inline void srgb2linear(const float *srgb, float *linear, size_t count)
+{
+	_gm_transfer(srgb, linear, count, _gm_srgb2linear_kernel());
+}
+
+
+GM_COLOR_API inline void linear2srgb(const float *linear, float *srgb, size_t count)
+{
+	_gm_transfer(linear, srgb, count, _gm_linear2srgb_kernel());
+}
+
+GM_COLOR_API inline void linear2srgb(const float *linear, unsigned char *srgb, size_t count)
+{
+	_gm_linear2srgb8(linear, 1, srgb, count);
+}
+
+
+GM_COLOR_API inline void compositeSRGB(
+	const unsigned char *src, unsigned char *dst, size_t count,
+	CompositeMode mode, AlphaMode alphaMode)
+{
+	const size_t BLOCK_SIZE = 64;
+
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float srcBlock[BLOCK_SIZE * 4];
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float dstBlock[BLOCK_SIZE * 4];
+
+	const float *lut = _gm_srgb2linear_lut();
+
+	for (size_t first = 0; first < count; first += BLOCK_SIZE)
+	{
+		const size_t n = ((count - first) < BLOCK_SIZE) ? (count - first) : BLOCK_SIZE;
+
+		const unsigned char *s = src + first * 4;
+		unsigned char *d = dst + first * 4;
+
+		for (size_t i = 0; i < n * 4; i += 4)
+		{
+			srcBlock[i + 0] = lut[s[i + 0]];
+			srcBlock[i + 1] = lut[s[i + 1]];
+			srcBlock[i + 2] = lut[s[i + 2]];
+			srcBlock[i + 3] = static_cast<float>(s[i + 3]) * (1.0f / 255.0f);
+
+			dstBlock[i + 0] = lut[d[i + 0]];
+			dstBlock[i + 1] = lut[d[i + 1]];
+			dstBlock[i + 2] = lut[d[i + 2]];
+			dstBlock[i + 3] = static_cast<float>(d[i + 3]) * (1.0f / 255.0f);
+		}
+
+		composite(srcBlock, dstBlock, n, mode, alphaMode);
+
+		_gm_linear2srgb8(dstBlock + 0, 4, d + 0, n);
+		_gm_linear2srgb8(dstBlock + 1, 4, d + 1, n);
+		_gm_linear2srgb8(dstBlock + 2, 4, d + 2, n);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const float a = dstBlock[i * 4 + 3];
+			d[i * 4 + 3] = static_cast<unsigned char>(((a > 1.0f) ? 1.0f : ((a > 0.0f) ? a : 0.0f)) * 255.0f + 0.5f);
+		}
+	}
+}
+
+GM_COLOR_API inline void grayscaleSRGB(
+	const unsigned char *rgb, unsigned char *gray, size_t count,
+	int channels, LumaWeights weights)
+{
+	const size_t BLOCK_SIZE = 256;
+
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float block[BLOCK_SIZE];
+
+	const float *lut = _gm_srgb2linear_lut();
+
+	const float wr = (weights == LumaWeights::Rec601) ? 0.299f : 0.2126f;
+	const float wg = (weights == LumaWeights::Rec601) ? 0.587f : 0.7152f;
+	const float wb = (weights == LumaWeights::Rec601) ? 0.114f : 0.0722f;
+
+	const size_t stride = static_cast<size_t>(channels);
+
+	for (size_t first = 0; first < count; first += BLOCK_SIZE)
+	{
+		const size_t n = ((count - first) < BLOCK_SIZE) ? (count - first) : BLOCK_SIZE;
+
+		const unsigned char *pixels = rgb + first * stride;
+
+		for (size_t i = 0; i < n; ++i)
+			block[i] = lut[pixels[i * stride + 0]] * wr + lut[pixels[i * stride + 1]] * wg + lut[pixels[i * stride + 2]] * wb;
+
+		_gm_linear2srgb8(block, 1, gray + first, n);
+	}
+}
+
+
+inline ColorLUT::ColorLUT(int size)
+	: n((size < 2) ? 2 : size)
+	, table(static_cast<size_t>(n) * n * n * 4, 0.0f)
+	, isBaked(false)
+	, hasParams(false)
+{}
+
+
+inline int ColorLUT::size() const
+{
+	return n;
+}
+
+inline bool ColorLUT::baked() const
+{
+	return isBaked;
+}
+
+
+template<typename Transform> inline void ColorLUT::bake(const Transform &transform, ThreadPool &pool)
+{
+	const float scale = 1.0f / static_cast<float>(n - 1);
+
+	float *entries = table.data();
+	const size_t side = static_cast<size_t>(n);
+
+	hasParams = false;
+
+	parallelFor(pool, side, 1, [&](size_t first, size_t last)
+	{
+		for (size_t z = first; z < last; ++z)
+			for (size_t y = 0; y < side; ++y)
+				for (size_t x = 0; x < side; ++x)
+				{
+					float *entry = entries + ((z * side + y) * side + x) * 4;
+
+					transform(
+						static_cast<float>(x) * scale, static_cast<float>(y) * scale, static_cast<float>(z) * scale,
+						entry + 0, entry + 1, entry + 2);
+				}
+	});
+
+	isBaked = true;
+}
+
+template<typename Params, typename Transform> inline bool ColorLUT::update(const Params &params, const Transform &transform, ThreadPool &pool)
+{
+	static_assert(std::is_trivially_copyable<Params>::value, "ColorLUT::update() requires trivially copyable parameters");
+
+	const unsigned char *bytes = reinterpret_cast<const unsigned char*>(&params);
+
+	if (isBaked && hasParams && (this->params.size() == sizeof(Params)) && (memcmp(this->params.data(), bytes, sizeof(Params)) == 0))
+		return false;
+
+	bake(transform, pool);
+
+	this->params.assign(bytes, bytes + sizeof(Params));
+	hasParams = true;
+
+	return true;
+}
+
+inline void ColorLUT::invalidate()
+{
+	hasParams = false;
+}
+
+
+// The lookups gather the entries of the corners of the cell
+// containing each color. The indices are clamped as well, such
+// that NaN can't result in reading outside the table.
+template<LUTInterpolation Interpolation> struct _gm_lut_kernel
+{
+	const float *table;
+	int n;
+
+	void _corner(const simd::vint &index, simd::vfloat &r, simd::vfloat &g, simd::vfloat &b) const
+	{
+		r = simd::gather(table + 0, index);
+		g = simd::gather(table + 1, index);
+		b = simd::gather(table + 2, index);
+	}
+
+	void operator()(
+		const simd::vfloat &r, const simd::vfloat &g, const simd::vfloat &b,
+		simd::vfloat &outR, simd::vfloat &outG, simd::vfloat &outB) const
+	{
+		typedef simd::vfloat V;
+		typedef simd::vint VI;
+
+		const V scale(static_cast<float>(n - 1));
+		const VI first(0), last(n - 2);
+
+		const V x = simd::clamp(r, V(0.0f), V(1.0f)) * scale;
+		const V y = simd::clamp(g, V(0.0f), V(1.0f)) * scale;
+		const V z = simd::clamp(b, V(0.0f), V(1.0f)) * scale;
+
+		const VI xi = simd::max(simd::min(simd::toInt(x), last), first);
+		const VI yi = simd::max(simd::min(simd::toInt(y), last), first);
+		const VI zi = simd::max(simd::min(simd::toInt(z), last), first);
+
+		const V fx = x - simd::toFloat(xi);
+		const V fy = y - simd::toFloat(yi);
+		const V fz = z - simd::toFloat(zi);
+
+		const int dx = 4, dy = n * 4, dz = n * n * 4;
+
+		const VI base = simd::sll<2>(xi + yi * VI(n) + zi * VI(n * n));
+
+		V r0, g0, b0, r1, g1, b1;
+
+		_corner(base, r0, g0, b0);
+		_corner(base + VI(dx + dy + dz), r1, g1, b1);
+
+		if (Interpolation == LUTInterpolation::Tetrahedral)
+		{
+			// Split the cell into 6 tetrahedra along the diagonal,
+			// i.e. visit the axes ordered by their fraction
+			const auto xy = (fx >= fy);
+			const auto yz = (fy >= fz);
+			const auto xz = (fx >= fz);
+
+			const auto xMax = xy & xz;
+			const auto yMax = ~xy & yz;
+			const auto xMin = ~xy & ~xz;
+			const auto yMin = xy & ~yz;
+
+			const V f1 = simd::max(fx, simd::max(fy, fz));
+			const V f3 = simd::min(fx, simd::min(fy, fz));
+			const V f2 = fx + fy + fz - f1 - f3;
+
+			const VI o1 = simd::select(xMax, VI(dx), simd::select(yMax, VI(dy), VI(dz)));
+			const VI o3 = simd::select(xMin, VI(dx), simd::select(yMin, VI(dy), VI(dz)));
+
+			V ra, ga, ba, rb, gb, bb;
+
+			_corner(base + o1, ra, ga, ba);
+			_corner(base + VI(dx + dy + dz) - o3, rb, gb, bb);
+
+			const V w0 = V(1.0f) - f1;
+			const V wa = f1 - f2;
+			const V wb = f2 - f3;
+
+			outR = r0 * w0 + ra * wa + rb * wb + r1 * f3;
+			outG = g0 * w0 + ga * wa + gb * wb + g1 * f3;
+			outB = b0 * w0 + ba * wa + bb * wb + b1 * f3;
+		}
+		else
+		{
+			V r100, g100, b100, r010, g010, b010, r110, g110, b110;
+			V r001, g001, b001, r101, g101, b101, r011, g011, b011;
+
+			_corner(base + VI(dx), r100, g100, b100);
+			_corner(base + VI(dy), r010, g010, b010);
+			_corner(base + VI(dx + dy), r110, g110, b110);
+			_corner(base + VI(dz), r001, g001, b001);
+			_corner(base + VI(dx + dz), r101, g101, b101);
+			_corner(base + VI(dy + dz), r011, g011, b011);
+
+			const auto lerp = [](const V &a, const V &b, const V &t) { return simd::fmadd(b - a, t, a); };
+
+			outR = lerp(lerp(lerp(r0, r100, fx), lerp(r010, r110, fx), fy), lerp(lerp(r001, r101, fx), lerp(r011, r1, fx), fy), fz);
+			outG = lerp(lerp(lerp(g0, g100, fx), lerp(g010, g110, fx), fy), lerp(lerp(g001, g101, fx), lerp(g011, g1, fx), fy), fz);
+			outB = lerp(lerp(lerp(b0, b100, fx), lerp(b010, b110, fx), fy), lerp(lerp(b001, b101, fx), lerp(b011, b1, fx), fy), fz);
+		}
+	}
+};
+
+inline void ColorLUT::apply(
+	const float *r, const float *g, const float *b,
+	float *outR, float *outG, float *outB,
+	size_t count, LUTInterpolation interpolation) const
+{
+	if (interpolation == LUTInterpolation::Tetrahedral)
+		_gm_color_planar(r, g, b, outR, outG, outB, count, _gm_lut_kernel<LUTInterpolation::Tetrahedral> { table.data(), n });
+	else
+		_gm_color_planar(r, g, b, outR, outG, outB, count, _gm_lut_kernel<LUTInterpolation::Trilinear> { table.data(), n });
+}
+
+inline void ColorLUT::apply(const float *rgb, float *out, size_t count, int channels, LUTInterpolation interpolation) const
+{
+	if (interpolation == LUTInterpolation::Tetrahedral)
+		_gm_color_interleaved(rgb, out, count, channels, _gm_lut_kernel<LUTInterpolation::Tetrahedral> { table.data(), n });
+	else
+		_gm_color_interleaved(rgb, out, count, channels, _gm_lut_kernel<LUTInterpolation::Trilinear> { table.data(), n });
+}
+
+
+inline double ColorStageStats::throughput() const
+{
+	return (seconds > 0.0) ? (static_cast<double>(pixels) / seconds) : 0.0;
+}
+
+
+inline ColorPipeline::ColorPipeline(size_t tileSize)
+	: tileSize((tileSize < 1) ? 1 : tileSize)
+	, totalSeconds(0.0)
+	, totalPixels(0)
+{
+	clear();
+}
+
+
+inline ColorPipeline& ColorPipeline::add(const std::string &name, const ColorStage &stage)
+{
+	stages.push_back(stage);
+
+	ColorStageStats stats = { name, 0.0, 0 };
+	statistics.insert(statistics.end() - 1, stats);
+
+	return *this;
+}
+
+inline void ColorPipeline::clear()
+{
+	stages.clear();
+	statistics.clear();
+
+	ColorStageStats unpack = { "int2rgb", 0.0, 0 };
+	ColorStageStats pack = { "rgb2int", 0.0, 0 };
+
+	statistics.push_back(unpack);
+	statistics.push_back(pack);
+
+	totalSeconds = 0.0;
+	totalPixels = 0;
+}
+
+
+inline size_t ColorPipeline::size() const
+{
+	return stages.size();
+}
+
+
+inline void ColorPipeline::run(const int *src, int *dst, size_t count, ChannelOrder order, ThreadPool &pool)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	const auto elapsed = [](const Clock::time_point &start, const Clock::time_point &end)
+	{
+		return std::chrono::duration<double>(end - start).count();
+	};
+
+	const size_t tiles = (count + tileSize - 1) / tileSize;
+
+	std::vector<double> seconds(statistics.size(), 0.0);
+	std::mutex mutex;
+
+	const Clock::time_point start = Clock::now();
+
+	parallelFor(pool, tiles, 1, [&](size_t firstTile, size_t lastTile)
+	{
+		std::vector<float> buffer(tileSize * 4);
+		std::vector<double> local(seconds.size(), 0.0);
+
+		ColorTile tile;
+		tile.r = buffer.data();
+		tile.g = tile.r + tileSize;
+		tile.b = tile.g + tileSize;
+		tile.a = tile.b + tileSize;
+
+		for (size_t i = firstTile; i < lastTile; ++i)
+		{
+			tile.first = i * tileSize;
+			tile.count = ((count - tile.first) < tileSize) ? (count - tile.first) : tileSize;
+
+			Clock::time_point previous = Clock::now();
+
+			int2rgb(src + tile.first, tile.r, tile.g, tile.b, tile.a, tile.count, order);
+
+			for (size_t stage = 0; stage <= stages.size(); ++stage)
+			{
+				const Clock::time_point now = Clock::now();
+				local[stage] += elapsed(previous, now);
+				previous = now;
+
+				if (stage < stages.size())
+					stages[stage](tile);
+			}
+
+			rgb2int(tile.r, tile.g, tile.b, tile.a, dst + tile.first, tile.count, order);
+
+			local.back() += elapsed(previous, Clock::now());
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		for (size_t stage = 0; stage < seconds.size(); ++stage)
+			seconds[stage] += local[stage];
+	});
+
+	totalSeconds += elapsed(start, Clock::now());
+	totalPixels += count;
+
+	for (size_t stage = 0; stage < statistics.size(); ++stage)
+	{
+		statistics[stage].seconds += seconds[stage];
+		statistics[stage].pixels += count;
+	}
+}
+
+
+inline const std::vector<ColorStageStats>& ColorPipeline::stats() const
+{
+	return statistics;
+}
+
+inline double ColorPipeline::seconds() const
+{
+	return totalSeconds;
+}
+
+inline size_t ColorPipeline::pixels() const
+{
+	return totalPixels;
+}
+
+inline double ColorPipeline::throughput() const
+{
+	return (totalSeconds > 0.0) ? (static_cast<double>(totalPixels) / totalSeconds) : 0.0;
+}
+
+inline void ColorPipeline::resetStats()
+{
+	for (ColorStageStats &stats : statistics)
+	{
+		stats.seconds = 0.0;
+		stats.pixels = 0;
+	}
+
+	totalSeconds = 0.0;
+	totalPixels = 0;
+}
+
+
+struct _gm_adjust_hsl_kernel
+{
+	float hueShift, saturation, lightness;
+
+	template<typename V> void operator()(const V &r, const V &g, const V &b, V &outR, V &outG, V &outB) const
+	{
+		V h, s, l;
+		_gm_rgb2hsl_kernel()(r, g, b, h, s, l);
+
+		h = h + V(hueShift);
+		h = h - simd::floor(h);
+		s = simd::clamp(s * V(saturation), V(0.0f), V(1.0f));
+		l = simd::clamp(l * V(lightness), V(0.0f), V(1.0f));
+
+		_gm_hsl2rgb_kernel()(h, s, l, outR, outG, outB);
+	}
+};
+
+struct _gm_grayscale_kernel
+{
+	float wr, wg, wb;
+
+	template<typename V> void operator()(const V &r, const V &g, const V &b, V &outR, V &outG, V &outB) const
+	{
+		const V luma = r * V(wr) + g * V(wg) + b * V(wb);
+
+		outR = luma;
+		outG = luma;
+		outB = luma;
+	}
+};
+
+// Blends src (with straight alpha) over dst in place, like blend().
+GM_COLOR_API inline void _gm_blend_planar(
+	const float *srcR, const float *srcG, const float *srcB, const float *srcA,
+	float *dstR, float *dstG, float *dstB, float *dstA,
+	size_t count)
+{
+	typedef simd::vfloat V;
+
+	const size_t width = V::width;
+
+	for (size_t i = 0; i < count; i += width)
+	{
+		const size_t n = ((count - i) < width) ? (count - i) : width;
+
+		const V a = simd::loadPartial<V>(srcA + i, n);
+		const V ia = V(1.0f) - a;
+
+		simd::storePartial(simd::loadPartial<V>(srcR + i, n) * a + simd::loadPartial<V>(dstR + i, n) * ia, dstR + i, n);
+		simd::storePartial(simd::loadPartial<V>(srcG + i, n) * a + simd::loadPartial<V>(dstG + i, n) * ia, dstG + i, n);
+		simd::storePartial(simd::loadPartial<V>(srcB + i, n) * a + simd::loadPartial<V>(dstB + i, n) * ia, dstB + i, n);
+		simd::storePartial(a * a + simd::loadPartial<V>(dstA + i, n) * ia, dstA + i, n);
+	}
+}
+
+
+GM_COLOR_API inline ColorStage adjustHSLStage(float hueShift, float saturation, float lightness)
+{
+	const _gm_adjust_hsl_kernel kernel = { hueShift, saturation, lightness };
+
+	return [kernel](ColorTile &tile)
+	{
+		_gm_color_planar(tile.r, tile.g, tile.b, tile.r, tile.g, tile.b, tile.count, kernel);
+	};
+}
+
+
+GM_COLOR_API inline ColorStage blendStage(float r, float g, float b, float a)
+{
+	return [r, g, b, a](ColorTile &tile)
+	{
+		typedef simd::vfloat V;
+
+		const V ia(1.0f - a);
+		const V sr(r * a), sg(g * a), sb(b * a), sa(a * a);
+
+		const size_t width = V::width;
+
+		for (size_t i = 0; i < tile.count; i += width)
+		{
+			const size_t n = ((tile.count - i) < width) ? (tile.count - i) : width;
+
+			simd::storePartial(sr + simd::loadPartial<V>(tile.r + i, n) * ia, tile.r + i, n);
+			simd::storePartial(sg + simd::loadPartial<V>(tile.g + i, n) * ia, tile.g + i, n);
+			simd::storePartial(sb + simd::loadPartial<V>(tile.b + i, n) * ia, tile.b + i, n);
+			simd::storePartial(sa + simd::loadPartial<V>(tile.a + i, n) * ia, tile.a + i, n);
+		}
+	};
+}
+
+GM_COLOR_API inline ColorStage blendStage(const int *overlay, ChannelOrder order)
+{
+	return [overlay, order](ColorTile &tile)
+	{
+		const size_t BLOCK_SIZE = 256;
+
+		GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float block[4][BLOCK_SIZE];
+
+		for (size_t first = 0; first < tile.count; first += BLOCK_SIZE)
+		{
+			const size_t n = ((tile.count - first) < BLOCK_SIZE) ? (tile.count - first) : BLOCK_SIZE;
+
+			int2rgb(overlay + tile.first + first, block[0], block[1], block[2], block[3], n, order);
+
+			_gm_blend_planar(
+				block[0], block[1], block[2], block[3],
+				tile.r + first, tile.g + first, tile.b + first, tile.a + first,
+				n);
+		}
+	};
+}
+
+
+GM_COLOR_API inline ColorStage grayscaleStage(LumaWeights weights)
+{
+	const _gm_grayscale_kernel kernel =
+	{
+		(weights == LumaWeights::Rec601) ? 0.299f : 0.2126f,
+		(weights == LumaWeights::Rec601) ? 0.587f : 0.7152f,
+		(weights == LumaWeights::Rec601) ? 0.114f : 0.0722f,
+	};
+
+	return [kernel](ColorTile &tile)
+	{
+		_gm_color_planar(tile.r, tile.g, tile.b, tile.r, tile.g, tile.b, tile.count, kernel);
+	};
+}
+
+
+GM_COLOR_API inline ColorStage lutStage(const ColorLUT &lut, LUTInterpolation interpolation)
+{
+	const ColorLUT *table = &lut;
+
+	return [table, interpolation](ColorTile &tile)
+	{
+		table->apply(tile.r, tile.g, tile.b, tile.r, tile.g, tile.b, tile.count, interpolation);
+	};
+}
+
+
+inline float LuminanceStats::percentile(float p) const
+{
+	if ((count == 0) || histogram.empty())
+		return 0.0f;
+
+	p = (p < 0.0f) ? 0.0f : ((p > 1.0f) ? 1.0f : p);
+
+	// The rank of the pixel, i.e. the smallest value
+	// such that at least p of the pixels are below it
+	const double target = static_cast<double>(p) * static_cast<double>(count);
+
+	double below = 0.0;
+	size_t bin = 0;
+
+	for (; bin < (histogram.size() - 1); ++bin)
+	{
+		if ((below + static_cast<double>(histogram[bin])) >= target)
+			break;
+
+		below += static_cast<double>(histogram[bin]);
+	}
+
+	float value;
+
+	if (logarithmic)
+	{
+		const double fraction = histogram[bin] ? ((target - below) / static_cast<double>(histogram[bin])) : 0.0;
+		const double width = static_cast<double>(histogramMax - histogramMin) / static_cast<double>(histogram.size());
+
+		value = static_cast<float>(::exp2(static_cast<double>(histogramMin) + (static_cast<double>(bin) + fraction) * width));
+	}
+	else
+		value = histogramMin + (histogramMax - histogramMin) * static_cast<float>(bin) / static_cast<float>(histogram.size() - 1);
+
+	return (value < min) ? min : ((value > max) ? max : value);
+}
+
+
+GM_COLOR_API inline LuminanceStats luminanceStats(
+	const unsigned char *rgb, size_t count,
+	int channels, LumaWeights weights,
+	ThreadPool &pool)
+{
+	const size_t BINS = 256;
+
+	LuminanceStats stats;
+	stats.count = count;
+	stats.histogram.assign(BINS, 0);
+	stats.histogramMin = 0.0f;
+	stats.histogramMax = 1.0f;
+	stats.logarithmic = false;
+
+	const size_t stride = static_cast<size_t>(channels);
+
+	std::mutex mutex;
+
+	parallelFor(pool, count, 16 * 1024, [&](size_t first, size_t last)
+	{
+		const size_t BLOCK_SIZE = 1024;
+
+		unsigned char block[BLOCK_SIZE];
+
+		// Interleaving 4 histograms avoids stalling on
+		// consecutive increments of the same bin
+		size_t histogram[4][BINS] = {};
+
+		for (size_t i = first; i < last; i += BLOCK_SIZE)
+		{
+			const size_t n = ((last - i) < BLOCK_SIZE) ? (last - i) : BLOCK_SIZE;
+
+			grayscale(rgb + i * stride, block, n, channels, weights);
+
+			size_t j = 0;
+
+			for (; (j + 4) <= n; j += 4)
+			{
+				++histogram[0][block[j + 0]];
+				++histogram[1][block[j + 1]];
+				++histogram[2][block[j + 2]];
+				++histogram[3][block[j + 3]];
+			}
+
+			for (; j < n; ++j)
+				++histogram[0][block[j]];
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		for (size_t bin = 0; bin < BINS; ++bin)
+			stats.histogram[bin] += histogram[0][bin] + histogram[1][bin] + histogram[2][bin] + histogram[3][bin];
+	});
+
+	// Everything else follows from the (exact) histogram
+	double sum = 0.0, logSum = 0.0;
+	size_t min = BINS, max = 0;
+
+	for (size_t bin = 0; bin < BINS; ++bin)
+	{
+		if (stats.histogram[bin] == 0)
+			continue;
+
+		const double y = static_cast<double>(bin) / 255.0;
+		const double n = static_cast<double>(stats.histogram[bin]);
+
+		sum += y * n;
+		logSum += ::log(y + 1E-4) * n;
+
+		min = (bin < min) ? bin : min;
+		max = bin;
+	}
+
+	if (count > 0)
+	{
+		stats.min = static_cast<float>(min) / 255.0f;
+		stats.max = static_cast<float>(max) / 255.0f;
+		stats.mean = static_cast<float>(sum / static_cast<double>(count));
+		stats.logAverage = static_cast<float>(::exp(logSum / static_cast<double>(count)) - 1E-4);
+	}
+	else
+		stats.min = stats.max = stats.mean = stats.logAverage = 0.0f;
+
+	return stats;
+}
+
+
+GM_COLOR_API inline LuminanceStats luminanceStats(
+	const float *rgb, size_t count,
+	int channels, LumaWeights weights,
+	float minLog2, float maxLog2, size_t bins,
+	ThreadPool &pool)
+{
+	typedef simd::vfloat V;
+	typedef simd::vint VI;
+
+	if (bins < 1)
+		bins = 1;
+
+	if (maxLog2 <= minLog2)
+		maxLog2 = minLog2 + 1.0f;
+
+	LuminanceStats stats;
+	stats.count = count;
+	stats.histogram.assign(bins, 0);
+	stats.histogramMin = minLog2;
+	stats.histogramMax = maxLog2;
+	stats.logarithmic = true;
+
+	const float wr = (weights == LumaWeights::Rec601) ? 0.299f : 0.2126f;
+	const float wg = (weights == LumaWeights::Rec601) ? 0.587f : 0.7152f;
+	const float wb = (weights == LumaWeights::Rec601) ? 0.114f : 0.0722f;
+
+	const float scale = static_cast<float>(bins) / (maxLog2 - minLog2);
+	const float delta = 1E-4f;
+
+	const size_t stride = static_cast<size_t>(channels);
+	const size_t width = V::width;
+
+	float min = INFINITY, max = -INFINITY;
+	double sum = 0.0, logSum = 0.0;
+
+	std::mutex mutex;
+
+	parallelFor(pool, count, 16 * 1024, [&](size_t first, size_t last)
+	{
+		const size_t BLOCK_SIZE = 256;
+
+		GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float luma[BLOCK_SIZE];
+		GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float lanes[3][V::width];
+		GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) int index[BLOCK_SIZE];
+
+		std::vector<size_t> histogram(bins, 0);
+
+		float localMin = INFINITY, localMax = -INFINITY;
+		double localSum = 0.0, localLogSum = 0.0;
+
+		for (size_t i = first; i < last; i += BLOCK_SIZE)
+		{
+			const size_t n = ((last - i) < BLOCK_SIZE) ? (last - i) : BLOCK_SIZE;
+			const float *pixels = rgb + i * stride;
+
+			for (size_t j = 0; j < n; ++j)
+				luma[j] = pixels[j * stride + 0] * wr + pixels[j * stride + 1] * wg + pixels[j * stride + 2] * wb;
+
+			V vmin(INFINITY), vmax(-INFINITY), vsum(0.0f), vlogSum(0.0f);
+
+			size_t j = 0;
+
+			for (; (j + width) <= n; j += width)
+			{
+				const V y = V::load(luma + j);
+				const V l = simd::log2(y + V(delta));
+
+				vmin = simd::min(vmin, y);
+				vmax = simd::max(vmax, y);
+				vsum = vsum + y;
+				vlogSum = vlogSum + l;
+
+				const VI bin = simd::toInt(simd::floor((l - V(minLog2)) * V(scale)));
+				simd::max(simd::min(bin, VI(static_cast<int>(bins) - 1)), VI(0)).store(index + j);
+			}
+
+			vmin.store(lanes[0]);
+			vmax.store(lanes[1]);
+
+			float blockSum = 0.0f, blockLogSum = 0.0f;
+
+			vsum.store(lanes[2]);
+			for (size_t k = 0; k < width; ++k) blockSum += lanes[2][k];
+
+			vlogSum.store(lanes[2]);
+			for (size_t k = 0; k < width; ++k) blockLogSum += lanes[2][k];
+
+			for (size_t k = 0; k < width; ++k)
+			{
+				localMin = (lanes[0][k] < localMin) ? lanes[0][k] : localMin;
+				localMax = (lanes[1][k] > localMax) ? lanes[1][k] : localMax;
+			}
+
+			for (; j < n; ++j)
+			{
+				const float y = luma[j];
+				const float l = log2f(y + delta);
+
+				localMin = (y < localMin) ? y : localMin;
+				localMax = (y > localMax) ? y : localMax;
+				blockSum += y;
+				blockLogSum += l;
+
+				const float bin = floorf((l - minLog2) * scale);
+				index[j] = (bin < 0.0f) ? 0 : ((bin >= static_cast<float>(bins)) ? static_cast<int>(bins) - 1 : static_cast<int>(bin));
+			}
+
+			for (j = 0; j < n; ++j)
+				++histogram[static_cast<size_t>(index[j])];
+
+			localSum += blockSum;
+			localLogSum += blockLogSum;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		for (size_t bin = 0; bin < bins; ++bin)
+			stats.histogram[bin] += histogram[bin];
+
+		min = (localMin < min) ? localMin : min;
+		max = (localMax > max) ? localMax : max;
+		sum += localSum;
+		logSum += localLogSum;
+	});
+
+	if (count > 0)
+	{
+		stats.min = min;
+		stats.max = max;
+		stats.mean = static_cast<float>(sum / static_cast<double>(count));
+		stats.logAverage = static_cast<float>(::exp2(logSum / static_cast<double>(count)) - 1E-4);
+	}
+	else
+		stats.min = stats.max = stats.mean = stats.logAverage = 0.0f;
+
+	return stats;
+}
+
+
+static const int _GM_PALETTE_GRID_SIZE = 16;
+
+// The size of the direct mapped cache of the batch nearest()
+static const size_t _GM_PALETTE_CACHE_SIZE = 4096;
+
+inline Palette::Palette(const int *colors, size_t count, PaletteDistance distance, ChannelOrder order)
+	: distance(distance)
+	, colors(colors, colors + ((count < 256) ? count : 256))
+{
+	_gm_channel_shifts(order, shifts);
+
+	const size_t n = this->colors.size();
+
+	points.resize(n * 3);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		float rgb[3];
+		_unpack(this->colors[i], rgb);
+		_embed(rgb[0], rgb[1], rgb[2], &points[i * 3]);
+	}
+
+	const float upper[3] = { 255.0f, 255.0f, 255.0f };
+
+	if (distance == PaletteDistance::RGB)
+		lower[0] = lower[1] = lower[2] = 0.0f;
+	else
+	{
+		lower[0] = lower[1] = -255.0f;
+		lower[2] = 0.0f;
+	}
+
+	const size_t GRID_SIZE = static_cast<size_t>(_GM_PALETTE_GRID_SIZE);
+
+	float cellSize[3];
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		cellSize[axis] = (upper[axis] - lower[axis]) / static_cast<float>(GRID_SIZE);
+		scale[axis] = 1.0f / cellSize[axis];
+	}
+
+	offsets.reserve(GRID_SIZE * GRID_SIZE * GRID_SIZE + 1);
+	offsets.push_back(0);
+
+	std::vector<float> nearest(n), farthest(n);
+
+	for (size_t z = 0; z < GRID_SIZE; ++z)
+		for (size_t y = 0; y < GRID_SIZE; ++y)
+			for (size_t x = 0; x < GRID_SIZE; ++x)
+			{
+				const size_t cell[3] = { x, y, z };
+
+				// The color closest to the farthest point of the cell bounds
+				// the distance to the nearest color of any point in the cell.
+				// Thereby only colors closer than that to the cell matter.
+				float threshold = INFINITY;
+
+				for (size_t i = 0; i < n; ++i)
+				{
+					float dmin = 0.0f, dmax = 0.0f;
+
+					for (int axis = 0; axis < 3; ++axis)
+					{
+						const float low = lower[axis] + static_cast<float>(cell[axis]) * cellSize[axis];
+						const float high = low + cellSize[axis];
+						const float p = points[i * 3 + axis];
+
+						const float below = (p < low) ? (low - p) : ((p > high) ? (p - high) : 0.0f);
+						const float above = ((p - low) > (high - p)) ? (p - low) : (high - p);
+
+						dmin += below * below;
+						dmax += above * above;
+					}
+
+					nearest[i] = dmin;
+					farthest[i] = dmax;
+
+					threshold = (dmax < threshold) ? dmax : threshold;
+				}
+
+				for (size_t i = 0; i < n; ++i)
+					if (nearest[i] <= threshold)
+						candidates.push_back(static_cast<unsigned char>(i));
+
+				offsets.push_back(static_cast<unsigned int>(candidates.size()));
+			}
+}
+
+
+inline size_t Palette::size() const
+{
+	return colors.size();
+}
+
+inline int Palette::color(size_t index) const
+{
+	return colors[index];
+}
+
+
+inline void Palette::_unpack(int color, float rgb[3]) const
+{
+	const unsigned int c = static_cast<unsigned int>(color);
+
+	rgb[0] = static_cast<float>((c >> shifts[0]) & 0xFF);
+	rgb[1] = static_cast<float>((c >> shifts[1]) & 0xFF);
+	rgb[2] = static_cast<float>((c >> shifts[2]) & 0xFF);
+}
+
+inline void Palette::_embed(float r, float g, float b, float point[3]) const
+{
+	if (distance == PaletteDistance::RGB)
+	{
+		point[0] = r;
+		point[1] = g;
+		point[2] = b;
+	}
+	else
+	{
+		float h, s, l;
+		rgb2hsl(r * (1.0f / 255.0f), g * (1.0f / 255.0f), b * (1.0f / 255.0f), &h, &s, &l);
+
+		// Scaled to the same range as RGB
+		const float angle = h * 6.283185307179586f;
+
+		point[0] = s * cosf(angle) * 255.0f;
+		point[1] = s * sinf(angle) * 255.0f;
+		point[2] = l * 255.0f;
+	}
+}
+
+
+inline size_t Palette::_nearest(const float rgb[3]) const
+{
+	if (colors.empty())
+		return 0;
+
+	float point[3];
+	_embed(rgb[0], rgb[1], rgb[2], point);
+
+	size_t cell = 0;
+
+	for (int axis = 2; axis >= 0; --axis)
+	{
+		const int i = static_cast<int>((point[axis] - lower[axis]) * scale[axis]);
+
+		cell = cell * static_cast<size_t>(_GM_PALETTE_GRID_SIZE) + static_cast<size_t>((i < 0) ? 0 : ((i >= _GM_PALETTE_GRID_SIZE) ? (_GM_PALETTE_GRID_SIZE - 1) : i));
+	}
+
+	float best = INFINITY;
+	size_t bestIndex = 0;
+
+	for (unsigned int i = offsets[cell]; i < offsets[cell + 1]; ++i)
+	{
+		const size_t index = candidates[i];
+		const float *p = &points[index * 3];
+
+		const float dx = point[0] - p[0];
+		const float dy = point[1] - p[1];
+		const float dz = point[2] - p[2];
+		const float d = dx * dx + dy * dy + dz * dz;
+
+		if (d < best)
+		{
+			best = d;
+			bestIndex = index;
+		}
+	}
+
+	return bestIndex;
+}
+
+
+inline size_t Palette::nearest(int color) const
+{
+	float rgb[3];
+	_unpack(color, rgb);
+
+	return _nearest(rgb);
+}
+
+// A direct mapped cache, as images tend to repeat colors. The keys only
+// contain the 3 color channels, such that 0xFFFFFFFF marks an empty slot.
+inline void Palette::_nearest(const int *colors, unsigned char *indices, size_t count, unsigned int *cacheKeys, unsigned char *cacheValues) const
+{
+	const unsigned int mask = (0xFFu << shifts[0]) | (0xFFu << shifts[1]) | (0xFFu << shifts[2]);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const unsigned int key = static_cast<unsigned int>(colors[i]) & mask;
+		const size_t slot = ((key * 2654435761u) >> 20) & (_GM_PALETTE_CACHE_SIZE - 1);
+
+		if (cacheKeys[slot] != key)
+		{
+			cacheKeys[slot] = key;
+			cacheValues[slot] = static_cast<unsigned char>(nearest(colors[i]));
+		}
+
+		indices[i] = cacheValues[slot];
+	}
+}
+
+inline void Palette::nearest(const int *colors, unsigned char *indices, size_t count) const
+{
+	std::vector<unsigned int> keys(_GM_PALETTE_CACHE_SIZE, 0xFFFFFFFFu);
+	std::vector<unsigned char> values(_GM_PALETTE_CACHE_SIZE, 0);
+
+	_nearest(colors, indices, count, keys.data(), values.data());
+}
+
+inline void Palette::remap(const int *colors, int *result, size_t count) const
+{
+	const size_t BLOCK_SIZE = 1024;
+
+	if (this->colors.empty())
+		return;
+
+	unsigned char indices[BLOCK_SIZE];
+
+	// The cache is shared by all blocks
+	std::vector<unsigned int> keys(_GM_PALETTE_CACHE_SIZE, 0xFFFFFFFFu);
+	std::vector<unsigned char> values(_GM_PALETTE_CACHE_SIZE, 0);
+
+	for (size_t first = 0; first < count; first += BLOCK_SIZE)
+	{
+		const size_t n = ((count - first) < BLOCK_SIZE) ? (count - first) : BLOCK_SIZE;
+
+		_nearest(colors + first, indices, n, keys.data(), values.data());
+
+		for (size_t i = 0; i < n; ++i)
+			result[first + i] = this->colors[indices[i]];
+	}
+}
+
+
+inline void Palette::dither(const int *image, size_t width, size_t height, size_t stride, unsigned char *indices) const
+{
+	if (colors.empty())
+		return;
+
+	// The error carried to the current and the next row, with
+	// a column of padding on either side
+	std::vector<float> errors[2] =
+	{
+		std::vector<float>((width + 2) * 3, 0.0f),
+		std::vector<float>((width + 2) * 3, 0.0f),
+	};
+
+	for (size_t y = 0; y < height; ++y)
+	{
+		float *current = errors[y & 1].data() + 3;
+		float *next = errors[(y + 1) & 1].data() + 3;
+
+		std::fill(errors[(y + 1) & 1].begin(), errors[(y + 1) & 1].end(), 0.0f);
+
+		for (size_t x = 0; x < width; ++x)
+		{
+			float rgb[3];
+			_unpack(image[y * stride + x], rgb);
+
+			for (int c = 0; c < 3; ++c)
+			{
+				const float value = rgb[c] + current[x * 3 + c];
+				rgb[c] = (value < 0.0f) ? 0.0f : ((value > 255.0f) ? 255.0f : value);
+			}
+
+			const size_t index = _nearest(rgb);
+			indices[y * width + x] = static_cast<unsigned char>(index);
+
+			float target[3];
+			_unpack(colors[index], target);
+
+			float *right = current + (x + 1) * 3;
+			float *below = next + x * 3;
+
+			for (int c = 0; c < 3; ++c)
+			{
+				const float error = rgb[c] - target[c];
+
+				right[c] += error * (7.0f / 16.0f);
+				below[c - 3] += error * (3.0f / 16.0f);
+				below[c] += error * (5.0f / 16.0f);
+				below[c + 3] += error * (1.0f / 16.0f);
+			}
+		}
+	}
+}
+
+
 #ifndef GM_NO_NAMESPACE
 }
 #endif
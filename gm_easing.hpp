@@ -4,7 +4,7 @@
 // Repository: https://github.com/MrVallentin/GameMath
 //
 // Date Created: November 12, 2012
-// Last Modified: July 24, 2016
+// Last Modified: October 18, 2026
 
 // Copyright (c) 2012-2016 Christian Vallentin <mail@vallentinsource.com>
 //
@@ -47,7 +47,7 @@
 #define GM_EASING_NAME "GameMath Easing"
 
 #define GM_EASING_VERSION_MAJOR 1
-#define GM_EASING_VERSION_MINOR 0
+#define GM_EASING_VERSION_MINOR 1
 #define GM_EASING_VERSION_PATCH 0
 
 #define GM_EASING_VERSION GM_STRINGIFY_VERSION(GM_EASING_VERSION_MAJOR, GM_EASING_VERSION_MINOR, GM_EASING_VERSION_PATCH)
@@ -55,8 +55,23 @@
 #define GM_EASING_NAME_VERSION GM_EASING_NAME " " GM_EASING_VERSION
 
 
-#define _GM_EASING_FEPSILON 1E-4
-#define _GM_EASING_DEPSILON 1E-4f
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "gm_parallel.hpp"
+#include "gm_simd.hpp"
+
+
+#define _GM_EASING_FEPSILON 1E-4f
+#define _GM_EASING_DEPSILON 1E-4
 
 #define _GM_EASING_FEQUAL(x, y) ((((y) - _GM_EASING_FEPSILON) < (x)) && ((x) < ((y) + _GM_EASING_FEPSILON)))
 #define _GM_EASING_DEQUAL(x, y) ((((y) - _GM_EASING_DEPSILON) < (x)) && ((x) < ((y) + _GM_EASING_DEPSILON)))
@@ -114,6 +129,451 @@ template<typename T> GM_EASING_API T easeInBounce(const T time);
 template<typename T> GM_EASING_API T easeOutBounce(const T time);
 template<typename T> GM_EASING_API T easeInOutBounce(const T time);
 
+// Batch versions of all the above, which evaluate count times at
+// a time, GM_SIMD_FLOAT_WIDTH (or GM_SIMD_DOUBLE_WIDTH) per iteration
+// (see gm_simd.hpp). T must be float or double, and result may alias
+// time. The piecewise curves evaluate every piece and select the
+// result per lane, instead of branching.
+//
+// The results match the scalar functions within 1E-6 for floats and
+// 1E-12 for doubles, for time in [0;1].
+
+template<typename T> GM_EASING_API void easeLinear(const T *time, T *result, size_t count);
+
+template<typename T> GM_EASING_API void easeInQuad(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutQuad(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutQuad(const T *time, T *result, size_t count);
+
+template<typename T> GM_EASING_API void easeInCubic(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutCubic(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutCubic(const T *time, T *result, size_t count);
+
+template<typename T> GM_EASING_API void easeInQuart(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutQuart(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutQuart(const T *time, T *result, size_t count);
+
+template<typename T> GM_EASING_API void easeInQuint(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutQuint(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutQuint(const T *time, T *result, size_t count);
+
+template<typename T> GM_EASING_API void easeInSine(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutSine(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutSine(const T *time, T *result, size_t count);
+
+template<typename T> GM_EASING_API void easeInExpo(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutExpo(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutExpo(const T *time, T *result, size_t count);
+
+template<typename T> GM_EASING_API void easeInCirc(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutCirc(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutCirc(const T *time, T *result, size_t count);
+
+template<typename T> GM_EASING_API void easeInBack(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutBack(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutBack(const T *time, T *result, size_t count);
+
+template<typename T> GM_EASING_API void easeInElastic(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutElastic(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutElastic(const T *time, T *result, size_t count);
+
+template<typename T> GM_EASING_API void easeInBounce(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutBounce(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutBounce(const T *time, T *result, size_t count);
+
+
+// Fast versions of the Sine, Expo and Elastic curves for floats,
+// which avoid calling sin(), cos() and pow(). Each curve is baked
+// (on first use) into a table of 256 cubic polynomials over [0;1],
+// which are evaluated using Horner's method. The tables take 36 KB
+// in total, and are shared by the scalar and batch functions.
+//
+// The max absolute error compared to the exact curves is 3E-7, i.e.
+// about the precision of a float. Unlike the other functions, time
+// is clamped to [0;1].
+namespace fast {
+
+GM_EASING_API float easeInSine(const float time);
+GM_EASING_API float easeOutSine(const float time);
+GM_EASING_API float easeInOutSine(const float time);
+
+GM_EASING_API float easeInExpo(const float time);
+GM_EASING_API float easeOutExpo(const float time);
+GM_EASING_API float easeInOutExpo(const float time);
+
+GM_EASING_API float easeInElastic(const float time);
+GM_EASING_API float easeOutElastic(const float time);
+GM_EASING_API float easeInOutElastic(const float time);
+
+GM_EASING_API void easeInSine(const float *time, float *result, size_t count);
+GM_EASING_API void easeOutSine(const float *time, float *result, size_t count);
+GM_EASING_API void easeInOutSine(const float *time, float *result, size_t count);
+
+GM_EASING_API void easeInExpo(const float *time, float *result, size_t count);
+GM_EASING_API void easeOutExpo(const float *time, float *result, size_t count);
+GM_EASING_API void easeInOutExpo(const float *time, float *result, size_t count);
+
+GM_EASING_API void easeInElastic(const float *time, float *result, size_t count);
+GM_EASING_API void easeOutElastic(const float *time, float *result, size_t count);
+GM_EASING_API void easeInOutElastic(const float *time, float *result, size_t count);
+
+}
+
+
+// Identifies the curves, for choosing them at runtime,
+// e.g. when loaded from a file.
+enum class Curve
+{
+	Linear,
+
+	InQuad, OutQuad, InOutQuad,
+	InCubic, OutCubic, InOutCubic,
+	InQuart, OutQuart, InOutQuart,
+	InQuint, OutQuint, InOutQuint,
+	InSine, OutSine, InOutSine,
+	InExpo, OutExpo, InOutExpo,
+	InCirc, OutCirc, InOutCirc,
+	InBack, OutBack, InOutBack,
+	InElastic, OutElastic, InOutElastic,
+	InBounce, OutBounce, InOutBounce,
+};
+
+template<typename T> using EaseFunction = T (*)(T time);
+template<typename T> using EaseBatchFunction = void (*)(const T *time, T *result, size_t count);
+
+// Returns the scalar or batch function of the curve, from a
+// table indexed by the curve. T must be float or double.
+template<typename T> GM_EASING_API EaseFunction<T> easeFunction(const Curve curve);
+template<typename T> GM_EASING_API EaseBatchFunction<T> easeBatchFunction(const Curve curve);
+
+template<typename T> GM_EASING_API T ease(const Curve curve, const T time);
+template<typename T> GM_EASING_API void ease(const Curve curve, const T *time, T *result, size_t count);
+
+// Evaluates curves[i] at time[i] for mixed curves. The elements are
+// grouped by curve (in blocks of 1024), and every group is evaluated
+// by the batch function of its curve, instead of dispatching every
+// element on its own.
+template<typename T> GM_EASING_API void ease(const Curve *curves, const T *time, T *result, size_t count);
+
+
+// Identifies a tween of a TweenPool. The low 24 bits index the
+// tween, and are reused by later calls to add() once it's removed.
+// The high 8 bits count the reuses, such that an id kept after
+// its tween was removed (or the pool cleared) isn't contained,
+// until the same index was reused 256 times.
+typedef unsigned int TweenId;
+
+// Advances many float tweens at once. Rather than objects, the tweens
+// are stored as a struct of arrays (start, end, duration, elapsed,
+// value, curve and id), all carved out of a single allocation. Thereby
+// update() streams through contiguous arrays, and evaluates the curves
+// using the grouped batch version of ease().
+//
+// Tweens live in slots [0;slots()). remove() only marks a slot as free,
+// and the slots are compacted (moving the last tweens into the holes)
+// by compact(), which update() calls once a quarter of them are free.
+// Hence slots, unlike ids, only stay the same between calls to update().
+//
+// A pool holds at most 2^24 - 1 tweens at a time.
+class TweenPool
+{
+public:
+	explicit TweenPool(size_t capacity = 256);
+
+	TweenPool(const TweenPool&) = delete;
+	TweenPool& operator=(const TweenPool&) = delete;
+
+	// A duration of 0 finishes on the next update().
+	TweenId add(float start, float end, float duration, Curve curve = Curve::Linear);
+	void remove(TweenId id);
+
+	bool contains(TweenId id) const;
+
+	// Ids that aren't contained have the value 0 and are finished.
+	float value(TweenId id) const;
+	bool finished(TweenId id) const;
+
+	// Advances every tween by deltaTime. Pools larger than a few
+	// thousand tweens are split across the threads of the pool.
+	void update(float deltaTime, ThreadPool &pool = defaultThreadPool());
+
+	void compact();
+	void clear();
+
+	// The number of tweens, excluding the removed ones.
+	size_t size() const;
+
+	size_t slots() const;
+	TweenId id(size_t slot) const;
+	const float* values() const;
+
+	// Bit (slot % 64) of word (slot / 64) is set for the tweens which
+	// finished during the last update(), instead of using callbacks.
+	const std::vector<unsigned long long>& completed() const;
+
+private:
+	void _reserve(size_t capacity);
+	void _move(size_t from, size_t to);
+
+	std::vector<unsigned char> arena;
+	size_t capacity;
+	size_t count;
+	size_t removed;
+
+	float *starts;
+	float *ends;
+	float *durations;
+	float *elapsed;
+	float *results;
+	Curve *curves;
+	TweenId *ids;
+
+	// The slot of every index, and the (last) ids of
+	// the indices free for reuse
+	std::vector<unsigned int> slotOf;
+	std::vector<TweenId> freeIds;
+
+	std::vector<unsigned long long> completions;
+};
+
+
+struct _gm_cubic_bezier_table;
+
+// A CSS style cubic-bezier(x1, y1, x2, y2) timing curve, going from
+// (0, 0) to (1, 1). x1 and x2 are clamped to [0;1], such that the
+// curve is a function of x, while y1 and y2 may over- or undershoot.
+//
+// Evaluating the curve at time means solving x(t) = time for t.
+// The initial guess is interpolated from a table of x(t) sampled at
+// 17 points, and refined by Newton-Raphson, or by bisection where the
+// slope is too flat. The tables are created on construction, and
+// shared between curves with the same control points.
+//
+// The max error in time is about 1E-6, and time is clamped to [0;1].
+class CubicBezier
+{
+public:
+	CubicBezier(float x1, float y1, float x2, float y2);
+
+	float operator()(float time) const;
+	void operator()(const float *time, float *result, size_t count) const;
+
+private:
+	std::shared_ptr<const _gm_cubic_bezier_table> table;
+};
+
+
+// A key of a KeyframeTrack, where curve eases
+// from this key to the next.
+struct Keyframe
+{
+	float time;
+	float value;
+	Curve curve;
+};
+
+// Remembers the segment (the pair of keys) last sampled from a
+// KeyframeTrack, such that sampling forward in time is amortized
+// O(1). Only seeking further than the next segment, or backwards,
+// falls back to a binary search.
+struct KeyframeCursor
+{
+	size_t segment = 0;
+};
+
+// A sequence of keys ordered by time, stored contiguously. Before the
+// first and after the last key, the track holds the value of that key.
+class KeyframeTrack
+{
+public:
+	KeyframeTrack() = default;
+	KeyframeTrack(const Keyframe *keys, size_t count);
+
+	// Inserted after any keys with the same time.
+	void add(float time, float value, Curve curve = Curve::Linear);
+	void clear();
+
+	size_t size() const;
+	const Keyframe& key(size_t index) const;
+
+	float startTime() const;
+	float endTime() const;
+
+	float sample(float time) const;
+	float sample(float time, KeyframeCursor &cursor) const;
+
+	// Moves the cursor to the segment containing time (or the first or
+	// the last segment), and gives the time relative to the segment in
+	// [0;1]. Used by sample(), requires at least 2 keys.
+	size_t seek(float time, KeyframeCursor &cursor, float *t) const;
+
+private:
+	std::vector<Keyframe> keys;
+};
+
+// Samples tracks[i] at time[i] using cursors[i], for many tracks at
+// once. The segments are found per track, after which the curves
+// are evaluated in batch, grouped by curve (see ease()).
+GM_EASING_API void sample(const KeyframeTrack *tracks, KeyframeCursor *cursors, const float *time, float *result, size_t count);
+
+
+// The derivatives d/dt of the above, i.e. the velocity of the eased
+// motion. The overloads taking a derivative output compute the value
+// and the derivative together, sharing terms such as sin() and pow().
+// As elsewhere, derivative may be nullptr.
+//
+// Where the curves are constant around 0 and 1 (Expo) the derivative
+// is 0, and at the ends of the Circ curves it's infinite.
+
+
+template<typename T> GM_EASING_API T easeLinearDerivative(const T time);
+template<typename T> GM_EASING_API T easeLinear(const T time, T *derivative);
+
+template<typename T> GM_EASING_API T easeInQuadDerivative(const T time);
+template<typename T> GM_EASING_API T easeOutQuadDerivative(const T time);
+template<typename T> GM_EASING_API T easeInOutQuadDerivative(const T time);
+template<typename T> GM_EASING_API T easeInQuad(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeOutQuad(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeInOutQuad(const T time, T *derivative);
+
+template<typename T> GM_EASING_API T easeInCubicDerivative(const T time);
+template<typename T> GM_EASING_API T easeOutCubicDerivative(const T time);
+template<typename T> GM_EASING_API T easeInOutCubicDerivative(const T time);
+template<typename T> GM_EASING_API T easeInCubic(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeOutCubic(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeInOutCubic(const T time, T *derivative);
+
+template<typename T> GM_EASING_API T easeInQuartDerivative(const T time);
+template<typename T> GM_EASING_API T easeOutQuartDerivative(const T time);
+template<typename T> GM_EASING_API T easeInOutQuartDerivative(const T time);
+template<typename T> GM_EASING_API T easeInQuart(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeOutQuart(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeInOutQuart(const T time, T *derivative);
+
+template<typename T> GM_EASING_API T easeInQuintDerivative(const T time);
+template<typename T> GM_EASING_API T easeOutQuintDerivative(const T time);
+template<typename T> GM_EASING_API T easeInOutQuintDerivative(const T time);
+template<typename T> GM_EASING_API T easeInQuint(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeOutQuint(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeInOutQuint(const T time, T *derivative);
+
+template<typename T> GM_EASING_API T easeInSineDerivative(const T time);
+template<typename T> GM_EASING_API T easeOutSineDerivative(const T time);
+template<typename T> GM_EASING_API T easeInOutSineDerivative(const T time);
+template<typename T> GM_EASING_API T easeInSine(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeOutSine(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeInOutSine(const T time, T *derivative);
+
+template<typename T> GM_EASING_API T easeInExpoDerivative(const T time);
+template<typename T> GM_EASING_API T easeOutExpoDerivative(const T time);
+template<typename T> GM_EASING_API T easeInOutExpoDerivative(const T time);
+template<typename T> GM_EASING_API T easeInExpo(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeOutExpo(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeInOutExpo(const T time, T *derivative);
+
+template<typename T> GM_EASING_API T easeInCircDerivative(const T time);
+template<typename T> GM_EASING_API T easeOutCircDerivative(const T time);
+template<typename T> GM_EASING_API T easeInOutCircDerivative(const T time);
+template<typename T> GM_EASING_API T easeInCirc(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeOutCirc(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeInOutCirc(const T time, T *derivative);
+
+template<typename T> GM_EASING_API T easeInBackDerivative(const T time);
+template<typename T> GM_EASING_API T easeOutBackDerivative(const T time);
+template<typename T> GM_EASING_API T easeInOutBackDerivative(const T time);
+template<typename T> GM_EASING_API T easeInBack(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeOutBack(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeInOutBack(const T time, T *derivative);
+
+template<typename T> GM_EASING_API T easeInElasticDerivative(const T time);
+template<typename T> GM_EASING_API T easeOutElasticDerivative(const T time);
+template<typename T> GM_EASING_API T easeInOutElasticDerivative(const T time);
+template<typename T> GM_EASING_API T easeInElastic(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeOutElastic(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeInOutElastic(const T time, T *derivative);
+
+template<typename T> GM_EASING_API T easeInBounceDerivative(const T time);
+template<typename T> GM_EASING_API T easeOutBounceDerivative(const T time);
+template<typename T> GM_EASING_API T easeInOutBounceDerivative(const T time);
+template<typename T> GM_EASING_API T easeInBounce(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeOutBounce(const T time, T *derivative);
+template<typename T> GM_EASING_API T easeInOutBounce(const T time, T *derivative);
+
+// Batch versions of the derivatives, see the other batch
+// functions above. value and derivative may be nullptr.
+
+template<typename T> GM_EASING_API void easeLinearDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeLinear(const T *time, T *value, T *derivative, size_t count);
+
+template<typename T> GM_EASING_API void easeInQuadDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutQuadDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutQuadDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInQuad(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeOutQuad(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeInOutQuad(const T *time, T *value, T *derivative, size_t count);
+
+template<typename T> GM_EASING_API void easeInCubicDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutCubicDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutCubicDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInCubic(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeOutCubic(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeInOutCubic(const T *time, T *value, T *derivative, size_t count);
+
+template<typename T> GM_EASING_API void easeInQuartDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutQuartDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutQuartDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInQuart(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeOutQuart(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeInOutQuart(const T *time, T *value, T *derivative, size_t count);
+
+template<typename T> GM_EASING_API void easeInQuintDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutQuintDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutQuintDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInQuint(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeOutQuint(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeInOutQuint(const T *time, T *value, T *derivative, size_t count);
+
+template<typename T> GM_EASING_API void easeInSineDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutSineDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutSineDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInSine(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeOutSine(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeInOutSine(const T *time, T *value, T *derivative, size_t count);
+
+template<typename T> GM_EASING_API void easeInExpoDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutExpoDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutExpoDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInExpo(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeOutExpo(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeInOutExpo(const T *time, T *value, T *derivative, size_t count);
+
+template<typename T> GM_EASING_API void easeInCircDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutCircDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutCircDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInCirc(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeOutCirc(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeInOutCirc(const T *time, T *value, T *derivative, size_t count);
+
+template<typename T> GM_EASING_API void easeInBackDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutBackDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutBackDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInBack(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeOutBack(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeInOutBack(const T *time, T *value, T *derivative, size_t count);
+
+template<typename T> GM_EASING_API void easeInElasticDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutElasticDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutElasticDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInElastic(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeOutElastic(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeInOutElastic(const T *time, T *value, T *derivative, size_t count);
+
+template<typename T> GM_EASING_API void easeInBounceDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeOutBounceDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInOutBounceDerivative(const T *time, T *result, size_t count);
+template<typename T> GM_EASING_API void easeInBounce(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeOutBounce(const T *time, T *value, T *derivative, size_t count);
+template<typename T> GM_EASING_API void easeInOutBounce(const T *time, T *value, T *derivative, size_t count);
+
 
 // After this point everything you'll see is all
 // the definitions to the prior declarations.
@@ -137,7 +597,11 @@ template<typename T> GM_EASING_API inline T easeOutQuad(const T time)
 
 template<typename T> GM_EASING_API inline T easeInOutQuad(T time)
 {
-	return (((time *= T(2)) < T(1)) ? (T(0.5) * time * time) : (T(-0.5) * ((time -= T(2)) * time - T(2))));
+	if ((time *= T(2)) < T(1))
+		return (T(0.5) * time * time);
+
+	time -= T(2);
+	return (T(-0.5) * (time * time - T(2)));
 }
 
 
@@ -169,7 +633,11 @@ template<typename T> GM_EASING_API inline T easeOutQuart(const T time)
 
 template<typename T> GM_EASING_API inline T easeInOutQuart(T time)
 {
-	return (((time *= T(2)) < T(1)) ? (T(0.5) * time * time * time * time) : (-T(0.5) * ((time -= T(2)) * time * time * time - T(2))));
+	if ((time *= T(2)) < T(1))
+		return (T(0.5) * time * time * time * time);
+
+	time -= T(2);
+	return (-T(0.5) * (time * time * time * time - T(2)));
 }
 
 
@@ -194,7 +662,7 @@ template<typename T> GM_EASING_API inline T easeInSine(const T time)
 	return -cos(time * (T(3.1415926535897932) / T(2))) + T(1);
 }
 
-template<> GM_EASING_API inline float easeInSine(const float time)
+template<> inline float easeInSine(const float time)
 {
 	return -cosf(time * (3.1415926535897932f / 2.0f)) + 1.0f;
 }
@@ -204,7 +672,7 @@ template<typename T> GM_EASING_API inline T easeOutSine(const T time)
 	return sin(time * (T(3.1415926535897932) / T(2)));
 }
 
-template<> GM_EASING_API inline float easeOutSine(const float time)
+template<> inline float easeOutSine(const float time)
 {
 	return sinf(time * (3.1415926535897932f / 2.0f));
 }
@@ -214,7 +682,7 @@ template<typename T> GM_EASING_API inline T easeInOutSine(const T time)
 	return (T(-0.5) * (cos(T(3.1415926535897932) * time) - T(1)));
 }
 
-template<> GM_EASING_API inline float easeInOutSine(const float time)
+template<> inline float easeInOutSine(const float time)
 {
 	return (-0.5f * (cosf(3.1415926535897932f * time) - 1.0f));
 }
@@ -225,7 +693,7 @@ template<typename T> GM_EASING_API inline T easeInExpo(const T time)
 	return (_GM_EASING_DEQUAL(time, T(0)) ? T(0) : pow(T(2), T(10) * (time - T(1))));
 }
 
-template<> GM_EASING_API inline float easeInExpo(const float time)
+template<> inline float easeInExpo(const float time)
 {
 	return (_GM_EASING_FEQUAL(time, 0.0f) ? 0.0f : powf(2.0f, 10.0f * (time - 1.0f)));
 }
@@ -235,7 +703,7 @@ template<typename T> GM_EASING_API inline T easeOutExpo(const T time)
 	return (_GM_EASING_DEQUAL(time, T(1)) ? T(1) : -pow(T(2), T(-10) * time) + T(1));
 }
 
-template<> GM_EASING_API inline float easeOutExpo(const float time)
+template<> inline float easeOutExpo(const float time)
 {
 	return (_GM_EASING_FEQUAL(time, 1.0f) ? 1.0f : -powf(2.0f, -10.0f * time) + 1.0f);
 }
@@ -245,7 +713,7 @@ template<typename T> GM_EASING_API inline T easeInOutExpo(T time)
 	return (_GM_EASING_DEQUAL(time, T(0)) ? T(0) : (_GM_EASING_DEQUAL(time, T(1)) ? T(1) : (((time *= T(2)) < T(1)) ? (T(0.5) * pow(T(2), T(10) * (time - T(1)))) : (T(0.5) * (-pow(T(2), T(-10) * --time) + T(2))))));
 }
 
-template<> GM_EASING_API inline float easeInOutExpo(float time)
+template<> inline float easeInOutExpo(float time)
 {
 	return (_GM_EASING_FEQUAL(time, 0.0f) ? 0.0f : (_GM_EASING_FEQUAL(time, 1.0f) ? 1.0f : (((time *= 2.0f) < 1.0f) ? (0.5f * powf(2.0f, 10.0f * (time - 1.0f))) : (0.5f * (-powf(2.0f, -10.0f * --time) + 2.0f)))));
 }
@@ -256,7 +724,7 @@ template<typename T> GM_EASING_API inline T easeInCirc(const T time)
 	return -(sqrt(T(1) - time * time) - T(1));
 }
 
-template<> GM_EASING_API inline float easeInCirc(const float time)
+template<> inline float easeInCirc(const float time)
 {
 	return -(sqrtf(1.0f - time * time) - 1.0f);
 }
@@ -266,19 +734,27 @@ template<typename T> GM_EASING_API inline T easeOutCirc(const T time)
 	return sqrt(T(1) - (time - T(1)) * (time - T(1)));
 }
 
-template<> GM_EASING_API inline float easeOutCirc(const float time)
+template<> inline float easeOutCirc(const float time)
 {
 	return sqrtf(1.0f - (time - 1.0f) * (time - 1.0f));
 }
 
 template<typename T> GM_EASING_API inline T easeInOutCirc(T time)
 {
-	return (((time *= T(2)) < T(1)) ? (T(-0.5) * (sqrt(T(1) - time * time) - T(1))) : (T(0.5) * (sqrt(T(1) - (time -= T(2)) * time) + T(1))));
+	if ((time *= T(2)) < T(1))
+		return (T(-0.5) * (sqrt(T(1) - time * time) - T(1)));
+
+	time -= T(2);
+	return (T(0.5) * (sqrt(T(1) - time * time) + T(1)));
 }
 
-template<> GM_EASING_API inline float easeInOutCirc(float time)
+template<> inline float easeInOutCirc(float time)
 {
-	return (((time *= 2.0f) < 1.0f) ? (-0.5f * (sqrtf(1.0f - time * time) - 1.0f)) : (0.5f * (sqrtf(1.0f - (time -= 2.0f) * time) + 1.0f)));
+	if ((time *= 2.0f) < 1.0f)
+		return (-0.5f * (sqrtf(1.0f - time * time) - 1.0f));
+
+	time -= 2.0f;
+	return (0.5f * (sqrtf(1.0f - time * time) + 1.0f));
 }
 
 
@@ -287,15 +763,24 @@ template<typename T> GM_EASING_API inline T easeInBack(const T time)
 	return (time * time * (T(2.70158) * time - T(1.70158)));
 }
 
+// The time is modified in a statement of its own, as the order
+// the operands are evaluated in is unspecified.
+
 template<typename T> GM_EASING_API inline T easeOutBack(T time)
 {
-	return ((time -= T(1)) * time * (T(2.70158) * time + T(1.70158)) + T(1));
+	time -= T(1);
+	return (time * time * (T(2.70158) * time + T(1.70158)) + T(1));
 }
 
 template<typename T> GM_EASING_API inline T easeInOutBack(T time)
 {
-	T s = T(1.70158);
-	return (((time *= T(2)) < T(1)) ? (T(0.5) * (time * time * (((s *= T(1.525)) + T(1)) * time - s))) : (T(0.5) * ((time -= T(2)) * time * (((s *= T(1.525)) + T(1)) * time + s) + T(2))));
+	const T s = T(1.70158) * T(1.525);
+
+	if ((time *= T(2)) < T(1))
+		return (T(0.5) * (time * time * ((s + T(1)) * time - s)));
+
+	time -= T(2);
+	return (T(0.5) * (time * time * ((s + T(1)) * time + s) + T(2)));
 }
 
 
@@ -304,7 +789,7 @@ template<typename T> GM_EASING_API T easeInElastic(const T time)
 	return sin(T(13) * (T(3.1415926535897932) / T(2)) * time) * pow(T(2), T(10) * (time - T(1)));
 }
 
-template<> GM_EASING_API float easeInElastic(const float time)
+template<> inline float easeInElastic(const float time)
 {
 	return sinf(13.0f * (3.1415926535897932f / 2.0f) * time) * powf(2.0f, 10.0f * (time - 1.0f));
 }
@@ -314,7 +799,7 @@ template<typename T> GM_EASING_API T easeOutElastic(const T time)
 	return sin(T(-13) * (T(3.1415926535897932) / T(2)) * (time + T(1))) * pow(T(2), T(-10) * time) + T(1);
 }
 
-template<> GM_EASING_API float easeOutElastic(const float time)
+template<> inline float easeOutElastic(const float time)
 {
 	return sinf(-13.0f * (3.1415926535897932f / 2.0f) * (time + 1.0f)) * powf(2.0f, -10.0f * time) + 1.0f;
 }
@@ -327,7 +812,7 @@ template<typename T> GM_EASING_API T easeInOutElastic(const T time)
 		return T(0.5) * (sin(T(-13) * (T(3.1415926535897932) / T(2)) * ((T(2) * time - T(1)) + T(1))) * pow(T(2), T(-10) * (T(2) * time - T(1))) + T(2));
 }
 
-template<> GM_EASING_API float easeInOutElastic(const float time)
+template<> inline float easeInOutElastic(const float time)
 {
 	if (time < 0.5f)
 		return 0.5f * sinf(13.0f * (3.1415926535897932f / 2.0f) * (2.0f * time)) * powf(2.0f, 10.0f * ((2.0f * time) - 1.0f));
@@ -338,7 +823,23 @@ template<> GM_EASING_API float easeInOutElastic(const float time)
 
 template<typename T> GM_EASING_API T easeInBounce(T time)
 {
-	return ((time < (T(1) / T(2.75))) ? (T(7.5625) * time * time) : ((time < (T(2) / T(2.75))) ? (T(7.5625) * (time -= (T(1.5) / T(2.75))) * time + T(0.75)) : ((time < (T(2.5) / T(2.75))) ? (T(7.5625) * (time -= (T(2.25) / T(2.75))) * time + T(0.9375)) : (T(7.5625) * (time -= (T(2.625) / T(2.75))) * time + T(0.984375)))));
+	if (time < (T(1) / T(2.75)))
+		return (T(7.5625) * time * time);
+
+	if (time < (T(2) / T(2.75)))
+	{
+		time -= (T(1.5) / T(2.75));
+		return (T(7.5625) * time * time + T(0.75));
+	}
+
+	if (time < (T(2.5) / T(2.75)))
+	{
+		time -= (T(2.25) / T(2.75));
+		return (T(7.5625) * time * time + T(0.9375));
+	}
+
+	time -= (T(2.625) / T(2.75));
+	return (T(7.5625) * time * time + T(0.984375));
 }
 
 template<typename T> GM_EASING_API T easeOutBounce(const T time)
@@ -352,6 +853,1812 @@ template<typename T> GM_EASING_API T easeInOutBounce(const T time)
 }
 
 
+// The kernels of the batch functions, which mirror the scalar
+// functions using the vector types of gm_simd.hpp. T is the
+// scalar type of V.
+
+template<typename Kernel, typename T> GM_EASING_API void _gm_ease_batch(const T *time, T *result, size_t count, const Kernel &kernel = Kernel())
+{
+	typedef typename simd::vector<T>::type V;
+
+	size_t i = 0;
+
+	for (; (i + V::width) <= count; i += V::width)
+		kernel(V::loadu(time + i)).storeu(result + i);
+
+	if (i < count)
+		simd::storePartial(kernel(simd::loadPartial<V>(time + i, count - i)), result + i, count - i);
+}
+
+
+#define _GM_EASING_KERNEL(name) \
+	struct _gm_##name##_kernel \
+	{ \
+		template<typename V> V operator()(const V &time) const; \
+	}; \
+	\
+	template<typename T> GM_EASING_API inline void name(const T *time, T *result, size_t count) \
+	{ \
+		_gm_ease_batch<_gm_##name##_kernel>(time, result, count); \
+	} \
+	\
+	template<typename V> inline V _gm_##name##_kernel::operator()(const V &time) const
+
+
+_GM_EASING_KERNEL(easeLinear)
+{
+	return time;
+}
+
+
+_GM_EASING_KERNEL(easeInQuad)
+{
+	return (time * time);
+}
+
+_GM_EASING_KERNEL(easeOutQuad)
+{
+	typedef typename V::scalar T;
+
+	const V t = time - V(T(1));
+	return -(t * t - V(T(1)));
+}
+
+_GM_EASING_KERNEL(easeInOutQuad)
+{
+	typedef typename V::scalar T;
+
+	const V t = time * V(T(2));
+	const V u = t - V(T(2));
+
+	return simd::select(t < V(T(1)), V(T(0.5)) * t * t, V(T(-0.5)) * (u * u - V(T(2))));
+}
+
+
+_GM_EASING_KERNEL(easeInCubic)
+{
+	return (time * time * time);
+}
+
+_GM_EASING_KERNEL(easeOutCubic)
+{
+	typedef typename V::scalar T;
+
+	const V t = time - V(T(1));
+	return (t * t * t + V(T(1)));
+}
+
+_GM_EASING_KERNEL(easeInOutCubic)
+{
+	typedef typename V::scalar T;
+
+	const V t = time / V(T(0.5));
+	const V u = t - V(T(2));
+
+	return simd::select(t < V(T(1)), V(T(0.5)) * t * t * t, V(T(0.5)) * (u * u * u + V(T(2))));
+}
+
+
+_GM_EASING_KERNEL(easeInQuart)
+{
+	return (time * time * time * time);
+}
+
+_GM_EASING_KERNEL(easeOutQuart)
+{
+	typedef typename V::scalar T;
+
+	const V t = time - V(T(1));
+	return -(t * t * t * t - V(T(1)));
+}
+
+_GM_EASING_KERNEL(easeInOutQuart)
+{
+	typedef typename V::scalar T;
+
+	const V t = time * V(T(2));
+	const V u = t - V(T(2));
+
+	return simd::select(t < V(T(1)), V(T(0.5)) * t * t * t * t, V(T(-0.5)) * (u * u * u * u - V(T(2))));
+}
+
+
+_GM_EASING_KERNEL(easeInQuint)
+{
+	return (time * time * time * time * time);
+}
+
+_GM_EASING_KERNEL(easeOutQuint)
+{
+	typedef typename V::scalar T;
+
+	const V t = time - V(T(1));
+	return (t * t * t * t * t + V(T(1)));
+}
+
+_GM_EASING_KERNEL(easeInOutQuint)
+{
+	typedef typename V::scalar T;
+
+	const V t = time * V(T(2));
+	const V u = t - V(T(2));
+
+	return simd::select(t < V(T(1)), V(T(0.5)) * t * t * t * t * t, V(T(0.5)) * (u * u * u * u * u + V(T(2))));
+}
+
+
+_GM_EASING_KERNEL(easeInSine)
+{
+	typedef typename V::scalar T;
+
+	return -simd::cos(time * V(T(3.1415926535897932) / T(2))) + V(T(1));
+}
+
+_GM_EASING_KERNEL(easeOutSine)
+{
+	typedef typename V::scalar T;
+
+	return simd::sin(time * V(T(3.1415926535897932) / T(2)));
+}
+
+_GM_EASING_KERNEL(easeInOutSine)
+{
+	typedef typename V::scalar T;
+
+	return (V(T(-0.5)) * (simd::cos(V(T(3.1415926535897932)) * time) - V(T(1))));
+}
+
+
+// The scalar functions use pow(2, x), i.e. exp2(x). The comparisons are
+// written exactly like _GM_EASING_FEQUAL() and _GM_EASING_DEQUAL(), as
+// |time - y| < epsilon rounds differently right at the boundary.
+
+template<typename T> GM_EASING_API inline T _gm_ease_epsilon()
+{
+	return T(_GM_EASING_DEPSILON);
+}
+
+template<> inline float _gm_ease_epsilon()
+{
+	return _GM_EASING_FEPSILON;
+}
+
+_GM_EASING_KERNEL(easeInExpo)
+{
+	typedef typename V::scalar T;
+
+	const auto zero = ((V(-_gm_ease_epsilon<T>()) < time) & (time < V(_gm_ease_epsilon<T>())));
+
+	return simd::select(zero, V(T(0)), simd::exp2(V(T(10)) * (time - V(T(1)))));
+}
+
+_GM_EASING_KERNEL(easeOutExpo)
+{
+	typedef typename V::scalar T;
+
+	const auto one = ((V(T(1) - _gm_ease_epsilon<T>()) < time) & (time < V(T(1) + _gm_ease_epsilon<T>())));
+
+	return simd::select(one, V(T(1)), -simd::exp2(V(T(-10)) * time) + V(T(1)));
+}
+
+_GM_EASING_KERNEL(easeInOutExpo)
+{
+	typedef typename V::scalar T;
+
+	const auto zero = ((V(-_gm_ease_epsilon<T>()) < time) & (time < V(_gm_ease_epsilon<T>())));
+	const auto one = ((V(T(1) - _gm_ease_epsilon<T>()) < time) & (time < V(T(1) + _gm_ease_epsilon<T>())));
+
+	const V t = time * V(T(2));
+	const V u = t - V(T(1));
+
+	const V in = V(T(0.5)) * simd::exp2(V(T(10)) * u);
+	const V out = V(T(0.5)) * (-simd::exp2(V(T(-10)) * u) + V(T(2)));
+
+	return simd::select(zero, V(T(0)), simd::select(one, V(T(1)), simd::select(t < V(T(1)), in, out)));
+}
+
+
+_GM_EASING_KERNEL(easeInCirc)
+{
+	typedef typename V::scalar T;
+
+	return -(simd::sqrt(V(T(1)) - time * time) - V(T(1)));
+}
+
+_GM_EASING_KERNEL(easeOutCirc)
+{
+	typedef typename V::scalar T;
+
+	const V t = time - V(T(1));
+	return simd::sqrt(V(T(1)) - t * t);
+}
+
+_GM_EASING_KERNEL(easeInOutCirc)
+{
+	typedef typename V::scalar T;
+
+	const V t = time * V(T(2));
+	const V u = t - V(T(2));
+
+	// Only one of the square roots is in range, hence
+	// clamp both to avoid computing NaN in the other
+	const V in = V(T(-0.5)) * (simd::sqrt(simd::max(V(T(1)) - t * t, V(T(0)))) - V(T(1)));
+	const V out = V(T(0.5)) * (simd::sqrt(simd::max(V(T(1)) - u * u, V(T(0)))) + V(T(1)));
+
+	return simd::select(t < V(T(1)), in, out);
+}
+
+
+_GM_EASING_KERNEL(easeInBack)
+{
+	typedef typename V::scalar T;
+
+	return (time * time * (V(T(2.70158)) * time - V(T(1.70158))));
+}
+
+_GM_EASING_KERNEL(easeOutBack)
+{
+	typedef typename V::scalar T;
+
+	const V t = time - V(T(1));
+	return (t * t * (V(T(2.70158)) * t + V(T(1.70158))) + V(T(1)));
+}
+
+_GM_EASING_KERNEL(easeInOutBack)
+{
+	typedef typename V::scalar T;
+
+	const T s = T(1.70158) * T(1.525);
+
+	const V t = time * V(T(2));
+	const V u = t - V(T(2));
+
+	const V in = V(T(0.5)) * (t * t * (V(s + T(1)) * t - V(s)));
+	const V out = V(T(0.5)) * (u * u * (V(s + T(1)) * u + V(s)) + V(T(2)));
+
+	return simd::select(t < V(T(1)), in, out);
+}
+
+
+_GM_EASING_KERNEL(easeInElastic)
+{
+	typedef typename V::scalar T;
+
+	return simd::sin(V(T(13) * (T(3.1415926535897932) / T(2))) * time) * simd::exp2(V(T(10)) * (time - V(T(1))));
+}
+
+_GM_EASING_KERNEL(easeOutElastic)
+{
+	typedef typename V::scalar T;
+
+	return simd::sin(V(T(-13) * (T(3.1415926535897932) / T(2))) * (time + V(T(1)))) * simd::exp2(V(T(-10)) * time) + V(T(1));
+}
+
+_GM_EASING_KERNEL(easeInOutElastic)
+{
+	typedef typename V::scalar T;
+
+	const V t = V(T(2)) * time;
+	const V u = t - V(T(1));
+
+	const V in = V(T(0.5)) * simd::sin(V(T(13) * (T(3.1415926535897932) / T(2))) * t) * simd::exp2(V(T(10)) * u);
+	const V out = V(T(0.5)) * (simd::sin(V(T(-13) * (T(3.1415926535897932) / T(2))) * (u + V(T(1)))) * simd::exp2(V(T(-10)) * u) + V(T(2)));
+
+	return simd::select(time < V(T(0.5)), in, out);
+}
+
+
+_GM_EASING_KERNEL(easeInBounce)
+{
+	typedef typename V::scalar T;
+
+	const V a = time - V(T(1.5) / T(2.75));
+	const V b = time - V(T(2.25) / T(2.75));
+	const V c = time - V(T(2.625) / T(2.75));
+
+	const V first = V(T(7.5625)) * time * time;
+	const V second = V(T(7.5625)) * a * a + V(T(0.75));
+	const V third = V(T(7.5625)) * b * b + V(T(0.9375));
+	const V fourth = V(T(7.5625)) * c * c + V(T(0.984375));
+
+	return simd::select(time < V(T(1) / T(2.75)), first,
+		simd::select(time < V(T(2) / T(2.75)), second,
+		simd::select(time < V(T(2.5) / T(2.75)), third, fourth)));
+}
+
+_GM_EASING_KERNEL(easeOutBounce)
+{
+	typedef typename V::scalar T;
+
+	return (V(T(1)) - _gm_easeInBounce_kernel()(V(T(1)) - time));
+}
+
+_GM_EASING_KERNEL(easeInOutBounce)
+{
+	typedef typename V::scalar T;
+
+	const V in = V(T(0.5)) * _gm_easeOutBounce_kernel()(time * V(T(2)));
+	const V out = V(T(0.5)) * _gm_easeInBounce_kernel()(time * V(T(2)) - V(T(1))) + V(T(0.5));
+
+	return simd::select(time < V(T(0.5)), in, out);
+}
+
+
+#undef _GM_EASING_KERNEL
+
+
+#define _GM_EASING_FAST_INTERVALS 256
+
+
+// The Expo curves without the special cases at 0 and 1,
+// such that the tables interpolate a smooth curve.
+
+GM_EASING_API inline double _gm_easeInExpo_raw(const double time)
+{
+	return pow(2.0, 10.0 * (time - 1.0));
+}
+
+GM_EASING_API inline double _gm_easeOutExpo_raw(const double time)
+{
+	return -pow(2.0, -10.0 * time) + 1.0;
+}
+
+GM_EASING_API inline double _gm_easeInOutExpo_raw(const double time)
+{
+	return ((time < 0.5) ? (0.5 * pow(2.0, 10.0 * (2.0 * time - 1.0))) : (0.5 * (-pow(2.0, -10.0 * (2.0 * time - 1.0)) + 2.0)));
+}
+
+
+// Every interval [i/n;(i+1)/n] of a curve is stored as the 4
+// coefficients of the cubic polynomial passing through the
+// curve at u = 0, 1/3, 2/3 and 1 (where u is the position
+// within the interval). The samples are all taken within the
+// interval, so the kinks of the InOut curves at 0.5 are kept.
+struct _gm_ease_fast_tables
+{
+	float coefficients[9][_GM_EASING_FAST_INTERVALS * 4];
+
+	_gm_ease_fast_tables();
+};
+
+inline _gm_ease_fast_tables::_gm_ease_fast_tables()
+{
+	double (*const curves[9])(const double) = {
+		easeInSine<double>, easeOutSine<double>, easeInOutSine<double>,
+		_gm_easeInExpo_raw, _gm_easeOutExpo_raw, _gm_easeInOutExpo_raw,
+		easeInElastic<double>, easeOutElastic<double>, easeInOutElastic<double>,
+	};
+
+	for (int curve = 0; curve < 9; ++curve)
+	{
+		float *c = coefficients[curve];
+
+		for (int i = 0; i < _GM_EASING_FAST_INTERVALS; ++i, c += 4)
+		{
+			const double h = 1.0 / double(_GM_EASING_FAST_INTERVALS);
+			const double x = double(i) * h;
+
+			const double f0 = curves[curve](x);
+			const double f1 = curves[curve](x + h / 3.0);
+			const double f2 = curves[curve](x + h * 2.0 / 3.0);
+			const double f3 = curves[curve](x + h);
+
+			c[0] = float(f0);
+			c[1] = float((-11.0 * f0 + 18.0 * f1 - 9.0 * f2 + 2.0 * f3) * 0.5);
+			c[2] = float((18.0 * f0 - 45.0 * f1 + 36.0 * f2 - 9.0 * f3) * 0.5);
+			c[3] = float((-9.0 * f0 + 27.0 * f1 - 27.0 * f2 + 9.0 * f3) * 0.5);
+		}
+	}
+}
+
+// The tables are baked on first use and shared
+// between translation units (hence not static).
+inline const _gm_ease_fast_tables& _gm_ease_fast_get()
+{
+	static const _gm_ease_fast_tables tables;
+	return tables;
+}
+
+
+GM_EASING_API inline float _gm_ease_fast_clamp(const float time)
+{
+	return (time > 0.0f) ? ((time < 1.0f) ? time : 1.0f) : 0.0f;
+}
+
+template<int Curve> GM_EASING_API inline float _gm_ease_fast(float time)
+{
+	const float *c = _gm_ease_fast_get().coefficients[Curve];
+
+	time = _gm_ease_fast_clamp(time);
+
+	const float x = time * float(_GM_EASING_FAST_INTERVALS);
+
+	int i = static_cast<int>(x);
+	i = (i < (_GM_EASING_FAST_INTERVALS - 1)) ? i : (_GM_EASING_FAST_INTERVALS - 1);
+
+	const float u = x - float(i);
+
+	c += i * 4;
+
+	return ((c[3] * u + c[2]) * u + c[1]) * u + c[0];
+}
+
+template<int Curve> struct _gm_ease_fast_kernel
+{
+	simd::vfloat operator()(const simd::vfloat &time) const
+	{
+		const float *c = _gm_ease_fast_get().coefficients[Curve];
+
+		const simd::vfloat x = simd::clamp(time, simd::vfloat(0.0f), simd::vfloat(1.0f)) * simd::vfloat(float(_GM_EASING_FAST_INTERVALS));
+		const simd::vint i = simd::min(simd::toInt(x), simd::vint(_GM_EASING_FAST_INTERVALS - 1));
+
+		const simd::vfloat u = x - simd::toFloat(i);
+		const simd::vint index = simd::sll<2>(i);
+
+		simd::vfloat result = simd::gather(c + 3, index);
+		result = simd::fmadd(result, u, simd::gather(c + 2, index));
+		result = simd::fmadd(result, u, simd::gather(c + 1, index));
+		result = simd::fmadd(result, u, simd::gather(c, index));
+
+		return result;
+	}
+};
+
+// The Expo kernels add the special cases at 0 and 1
+// of the exact curves on top of the tables. Time is
+// clamped first, such that the special cases also
+// cover the time outside of [0;1].
+struct _gm_ease_fast_in_expo_kernel
+{
+	simd::vfloat operator()(const simd::vfloat &time) const
+	{
+		const simd::vfloat t = simd::clamp(time, simd::vfloat(0.0f), simd::vfloat(1.0f));
+		return simd::select(t < simd::vfloat(_GM_EASING_FEPSILON), simd::vfloat(0.0f), _gm_ease_fast_kernel<3>()(t));
+	}
+};
+
+struct _gm_ease_fast_out_expo_kernel
+{
+	simd::vfloat operator()(const simd::vfloat &time) const
+	{
+		const simd::vfloat t = simd::clamp(time, simd::vfloat(0.0f), simd::vfloat(1.0f));
+		return simd::select((simd::vfloat(1.0f) - t) < simd::vfloat(_GM_EASING_FEPSILON), simd::vfloat(1.0f), _gm_ease_fast_kernel<4>()(t));
+	}
+};
+
+struct _gm_ease_fast_in_out_expo_kernel
+{
+	simd::vfloat operator()(const simd::vfloat &time) const
+	{
+		const simd::vfloat t = simd::clamp(time, simd::vfloat(0.0f), simd::vfloat(1.0f));
+
+		const simd::vfloat result = simd::select(t < simd::vfloat(_GM_EASING_FEPSILON), simd::vfloat(0.0f), _gm_ease_fast_kernel<5>()(t));
+		return simd::select((simd::vfloat(1.0f) - t) < simd::vfloat(_GM_EASING_FEPSILON), simd::vfloat(1.0f), result);
+	}
+};
+
+
+namespace fast {
+
+GM_EASING_API inline float easeInSine(const float time)
+{
+	return _gm_ease_fast<0>(time);
+}
+
+GM_EASING_API inline float easeOutSine(const float time)
+{
+	return _gm_ease_fast<1>(time);
+}
+
+GM_EASING_API inline float easeInOutSine(const float time)
+{
+	return _gm_ease_fast<2>(time);
+}
+
+
+GM_EASING_API inline float easeInExpo(const float time)
+{
+	const float t = _gm_ease_fast_clamp(time);
+	return (_GM_EASING_FEQUAL(t, 0.0f) ? 0.0f : _gm_ease_fast<3>(t));
+}
+
+GM_EASING_API inline float easeOutExpo(const float time)
+{
+	const float t = _gm_ease_fast_clamp(time);
+	return (_GM_EASING_FEQUAL(t, 1.0f) ? 1.0f : _gm_ease_fast<4>(t));
+}
+
+GM_EASING_API inline float easeInOutExpo(const float time)
+{
+	const float t = _gm_ease_fast_clamp(time);
+	return (_GM_EASING_FEQUAL(t, 0.0f) ? 0.0f : (_GM_EASING_FEQUAL(t, 1.0f) ? 1.0f : _gm_ease_fast<5>(t)));
+}
+
+
+GM_EASING_API inline float easeInElastic(const float time)
+{
+	return _gm_ease_fast<6>(time);
+}
+
+GM_EASING_API inline float easeOutElastic(const float time)
+{
+	return _gm_ease_fast<7>(time);
+}
+
+GM_EASING_API inline float easeInOutElastic(const float time)
+{
+	return _gm_ease_fast<8>(time);
+}
+
+
+GM_EASING_API inline void easeInSine(const float *time, float *result, size_t count)
+{
+	_gm_ease_batch<_gm_ease_fast_kernel<0>>(time, result, count);
+}
+
+GM_EASING_API inline void easeOutSine(const float *time, float *result, size_t count)
+{
+	_gm_ease_batch<_gm_ease_fast_kernel<1>>(time, result, count);
+}
+
+GM_EASING_API inline void easeInOutSine(const float *time, float *result, size_t count)
+{
+	_gm_ease_batch<_gm_ease_fast_kernel<2>>(time, result, count);
+}
+
+
+GM_EASING_API inline void easeInExpo(const float *time, float *result, size_t count)
+{
+	_gm_ease_batch<_gm_ease_fast_in_expo_kernel>(time, result, count);
+}
+
+GM_EASING_API inline void easeOutExpo(const float *time, float *result, size_t count)
+{
+	_gm_ease_batch<_gm_ease_fast_out_expo_kernel>(time, result, count);
+}
+
+GM_EASING_API inline void easeInOutExpo(const float *time, float *result, size_t count)
+{
+	_gm_ease_batch<_gm_ease_fast_in_out_expo_kernel>(time, result, count);
+}
+
+
+GM_EASING_API inline void easeInElastic(const float *time, float *result, size_t count)
+{
+	_gm_ease_batch<_gm_ease_fast_kernel<6>>(time, result, count);
+}
+
+GM_EASING_API inline void easeOutElastic(const float *time, float *result, size_t count)
+{
+	_gm_ease_batch<_gm_ease_fast_kernel<7>>(time, result, count);
+}
+
+GM_EASING_API inline void easeInOutElastic(const float *time, float *result, size_t count)
+{
+	_gm_ease_batch<_gm_ease_fast_kernel<8>>(time, result, count);
+}
+
+}
+
+
+#undef _GM_EASING_FAST_INTERVALS
+
+
+#define _GM_EASING_CURVE_COUNT 31
+#define _GM_EASING_GROUP_BLOCK_SIZE 1024
+
+
+template<typename T> GM_EASING_API inline EaseFunction<T> easeFunction(const Curve curve)
+{
+	static const EaseFunction<T> functions[_GM_EASING_CURVE_COUNT] = {
+		easeLinear<T>,
+		easeInQuad<T>, easeOutQuad<T>, easeInOutQuad<T>,
+		easeInCubic<T>, easeOutCubic<T>, easeInOutCubic<T>,
+		easeInQuart<T>, easeOutQuart<T>, easeInOutQuart<T>,
+		easeInQuint<T>, easeOutQuint<T>, easeInOutQuint<T>,
+		easeInSine<T>, easeOutSine<T>, easeInOutSine<T>,
+		easeInExpo<T>, easeOutExpo<T>, easeInOutExpo<T>,
+		easeInCirc<T>, easeOutCirc<T>, easeInOutCirc<T>,
+		easeInBack<T>, easeOutBack<T>, easeInOutBack<T>,
+		easeInElastic<T>, easeOutElastic<T>, easeInOutElastic<T>,
+		easeInBounce<T>, easeOutBounce<T>, easeInOutBounce<T>,
+	};
+
+	return functions[static_cast<int>(curve)];
+}
+
+template<typename T> GM_EASING_API inline EaseBatchFunction<T> easeBatchFunction(const Curve curve)
+{
+	static const EaseBatchFunction<T> functions[_GM_EASING_CURVE_COUNT] = {
+		easeLinear<T>,
+		easeInQuad<T>, easeOutQuad<T>, easeInOutQuad<T>,
+		easeInCubic<T>, easeOutCubic<T>, easeInOutCubic<T>,
+		easeInQuart<T>, easeOutQuart<T>, easeInOutQuart<T>,
+		easeInQuint<T>, easeOutQuint<T>, easeInOutQuint<T>,
+		easeInSine<T>, easeOutSine<T>, easeInOutSine<T>,
+		easeInExpo<T>, easeOutExpo<T>, easeInOutExpo<T>,
+		easeInCirc<T>, easeOutCirc<T>, easeInOutCirc<T>,
+		easeInBack<T>, easeOutBack<T>, easeInOutBack<T>,
+		easeInElastic<T>, easeOutElastic<T>, easeInOutElastic<T>,
+		easeInBounce<T>, easeOutBounce<T>, easeInOutBounce<T>,
+	};
+
+	return functions[static_cast<int>(curve)];
+}
+
+
+template<typename T> GM_EASING_API inline T ease(const Curve curve, const T time)
+{
+	return easeFunction<T>(curve)(time);
+}
+
+template<typename T> GM_EASING_API inline void ease(const Curve curve, const T *time, T *result, size_t count)
+{
+	easeBatchFunction<T>(curve)(time, result, count);
+}
+
+
+template<typename T> GM_EASING_API void ease(const Curve *curves, const T *time, T *result, size_t count)
+{
+	// The elements of a block are sorted by curve with a counting
+	// sort, such that every curve's times are contiguous, evaluated
+	// and then scattered back to their original positions
+	unsigned short order[_GM_EASING_GROUP_BLOCK_SIZE];
+	T times[_GM_EASING_GROUP_BLOCK_SIZE];
+	T results[_GM_EASING_GROUP_BLOCK_SIZE];
+
+	for (size_t first = 0; first < count; first += _GM_EASING_GROUP_BLOCK_SIZE)
+	{
+		const size_t n = ((count - first) < _GM_EASING_GROUP_BLOCK_SIZE) ? (count - first) : _GM_EASING_GROUP_BLOCK_SIZE;
+
+		const Curve *blockCurves = curves + first;
+		const T *blockTime = time + first;
+		T *blockResult = result + first;
+
+		size_t offsets[_GM_EASING_CURVE_COUNT + 1] = {};
+
+		for (size_t i = 0; i < n; ++i)
+			++offsets[static_cast<int>(blockCurves[i]) + 1];
+
+		for (int curve = 0; curve < _GM_EASING_CURVE_COUNT; ++curve)
+			offsets[curve + 1] += offsets[curve];
+
+		size_t next[_GM_EASING_CURVE_COUNT];
+
+		for (int curve = 0; curve < _GM_EASING_CURVE_COUNT; ++curve)
+			next[curve] = offsets[curve];
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const size_t j = next[static_cast<int>(blockCurves[i])]++;
+
+			order[j] = static_cast<unsigned short>(i);
+			times[j] = blockTime[i];
+		}
+
+		for (int curve = 0; curve < _GM_EASING_CURVE_COUNT; ++curve)
+		{
+			if (offsets[curve] < offsets[curve + 1])
+				easeBatchFunction<T>(static_cast<Curve>(curve))(times + offsets[curve], results + offsets[curve], offsets[curve + 1] - offsets[curve]);
+		}
+
+		for (size_t j = 0; j < n; ++j)
+			blockResult[order[j]] = results[j];
+	}
+}
+
+
+#undef _GM_EASING_CURVE_COUNT
+#undef _GM_EASING_GROUP_BLOCK_SIZE
+
+
+#define _GM_TWEEN_REMOVED 0xFFFFFFFFu
+
+// The index of an id, and what's added to reuse it
+#define _GM_TWEEN_INDEX_MASK 0x00FFFFFFu
+#define _GM_TWEEN_GENERATION 0x01000000u
+
+// Tweens per worker range, in 64-bit words of the completion mask
+#define _GM_TWEEN_GRAIN_WORDS 32
+
+
+inline TweenPool::TweenPool(size_t capacity)
+	: capacity(0)
+	, count(0)
+	, removed(0)
+	, starts(nullptr)
+	, ends(nullptr)
+	, durations(nullptr)
+	, elapsed(nullptr)
+	, results(nullptr)
+	, curves(nullptr)
+	, ids(nullptr)
+{
+	_reserve((capacity > 0) ? capacity : 1);
+}
+
+
+inline void TweenPool::_reserve(size_t capacity)
+{
+	// Rounded up to 16, such that every array starts 64-byte aligned
+	// relative to the arena, which keeps them from sharing cache lines
+	capacity = (capacity + 15) & ~static_cast<size_t>(15);
+
+	if (capacity <= this->capacity)
+		return;
+
+	static_assert(sizeof(Curve) == sizeof(float), "Curve is assumed to be 32-bit");
+	static_assert(sizeof(TweenId) == sizeof(float), "TweenId is assumed to be 32-bit");
+
+	std::vector<unsigned char> arena(capacity * sizeof(float) * 7);
+
+	float *base = reinterpret_cast<float*>(arena.data());
+
+	float *starts = base;
+	float *ends = base + capacity;
+	float *durations = base + capacity * 2;
+	float *elapsed = base + capacity * 3;
+	float *results = base + capacity * 4;
+	Curve *curves = reinterpret_cast<Curve*>(base + capacity * 5);
+	TweenId *ids = reinterpret_cast<TweenId*>(base + capacity * 6);
+
+	if (count > 0)
+	{
+		memcpy(starts, this->starts, count * sizeof(float));
+		memcpy(ends, this->ends, count * sizeof(float));
+		memcpy(durations, this->durations, count * sizeof(float));
+		memcpy(elapsed, this->elapsed, count * sizeof(float));
+		memcpy(results, this->results, count * sizeof(float));
+		memcpy(curves, this->curves, count * sizeof(Curve));
+		memcpy(ids, this->ids, count * sizeof(TweenId));
+	}
+
+	this->arena.swap(arena);
+	this->capacity = capacity;
+
+	this->starts = starts;
+	this->ends = ends;
+	this->durations = durations;
+	this->elapsed = elapsed;
+	this->results = results;
+	this->curves = curves;
+	this->ids = ids;
+}
+
+
+inline TweenId TweenPool::add(float start, float end, float duration, Curve curve)
+{
+	if (count == capacity)
+		_reserve(capacity * 2);
+
+	TweenId id;
+
+	// The generation wraps around, while the index stays the same.
+	// Within the limit of tweens, the indices stay below the mask,
+	// such that no id equals removed.
+	if (!freeIds.empty())
+	{
+		id = freeIds.back() + _GM_TWEEN_GENERATION;
+		freeIds.pop_back();
+	}
+	else
+	{
+		id = static_cast<TweenId>(slotOf.size());
+		slotOf.push_back(0);
+	}
+
+	const size_t slot = count++;
+
+	slotOf[id & _GM_TWEEN_INDEX_MASK] = static_cast<unsigned int>(slot);
+
+	// The smallest positive duration keeps elapsed / duration
+	// defined, and lets the tween finish on the next update()
+	starts[slot] = start;
+	ends[slot] = end;
+	durations[slot] = (duration > 0.0f) ? duration : 1E-30f;
+	elapsed[slot] = 0.0f;
+	results[slot] = start;
+	curves[slot] = curve;
+	ids[slot] = id;
+
+	return id;
+}
+
+inline void TweenPool::remove(TweenId id)
+{
+	if (!contains(id))
+		return;
+
+	const size_t slot = slotOf[id & _GM_TWEEN_INDEX_MASK];
+
+	// Marked as finished, such that it isn't reported as completed
+	elapsed[slot] = durations[slot];
+	ids[slot] = _GM_TWEEN_REMOVED;
+
+	slotOf[id & _GM_TWEEN_INDEX_MASK] = _GM_TWEEN_REMOVED;
+	freeIds.push_back(id);
+
+	++removed;
+}
+
+
+inline bool TweenPool::contains(TweenId id) const
+{
+	const TweenId index = id & _GM_TWEEN_INDEX_MASK;
+
+	// A stale id has the index of a tween, but another generation
+	return ((index < slotOf.size()) && (slotOf[index] != _GM_TWEEN_REMOVED) && (ids[slotOf[index]] == id));
+}
+
+
+inline float TweenPool::value(TweenId id) const
+{
+	if (!contains(id))
+		return 0.0f;
+
+	return results[slotOf[id & _GM_TWEEN_INDEX_MASK]];
+}
+
+inline bool TweenPool::finished(TweenId id) const
+{
+	if (!contains(id))
+		return true;
+
+	const size_t slot = slotOf[id & _GM_TWEEN_INDEX_MASK];
+	return (elapsed[slot] >= durations[slot]);
+}
+
+
+inline void TweenPool::update(float deltaTime, ThreadPool &pool)
+{
+	if ((removed * 4) > count)
+		compact();
+
+	const size_t words = (count + 63) / 64;
+
+	completions.assign(words, 0);
+
+	// Every range covers whole words of the completion mask,
+	// such that no two threads write to the same word
+	parallelFor(pool, words, _GM_TWEEN_GRAIN_WORDS, [this, deltaTime](size_t firstWord, size_t lastWord)
+	{
+		typedef simd::vfloat V;
+		const size_t width = V::width;
+
+		const size_t first = firstWord * 64;
+		const size_t last = ((lastWord * 64) < count) ? (lastWord * 64) : count;
+
+		for (size_t i = first; i < last; i += width)
+		{
+			const size_t n = ((last - i) < width) ? (last - i) : width;
+
+			// Loaded as zero past the end, and 0 < 0 never completes
+			const V duration = (n == width) ? V::loadu(durations + i) : simd::loadPartial<V>(durations + i, n);
+			const V previous = (n == width) ? V::loadu(elapsed + i) : simd::loadPartial<V>(elapsed + i, n);
+			const V current = simd::min(previous + V(deltaTime), duration);
+
+			const unsigned long long bits = static_cast<unsigned int>(simd::bits((previous < duration) & (current >= duration)));
+
+			if (bits)
+				completions[i / 64] |= bits << (i % 64);
+
+			if (n == width)
+			{
+				current.storeu(elapsed + i);
+				(current / duration).storeu(results + i);
+			}
+			else
+			{
+				simd::storePartial(current, elapsed + i, n);
+				simd::storePartial(current / duration, results + i, n);
+			}
+		}
+
+		ease(curves + first, results + first, results + first, last - first);
+
+		for (size_t i = first; i < last; ++i)
+			results[i] = starts[i] + (ends[i] - starts[i]) * results[i];
+	});
+}
+
+
+inline void TweenPool::_move(size_t from, size_t to)
+{
+	starts[to] = starts[from];
+	ends[to] = ends[from];
+	durations[to] = durations[from];
+	elapsed[to] = elapsed[from];
+	results[to] = results[from];
+	curves[to] = curves[from];
+	ids[to] = ids[from];
+
+	if (ids[to] != _GM_TWEEN_REMOVED)
+		slotOf[ids[to] & _GM_TWEEN_INDEX_MASK] = static_cast<unsigned int>(to);
+}
+
+inline void TweenPool::compact()
+{
+	size_t last = count;
+
+	for (size_t i = 0; i < last;)
+	{
+		if (ids[i] != _GM_TWEEN_REMOVED)
+		{
+			++i;
+			continue;
+		}
+
+		// The last tween might be removed as well, in which
+		// case slot i is checked again after the move
+		if (i != --last)
+			_move(last, i);
+	}
+
+	count = last;
+	removed = 0;
+
+	completions.clear();
+}
+
+inline void TweenPool::clear()
+{
+	// The indices are freed rather than forgotten, such
+	// that the ids given so far are no longer contained
+	for (size_t slot = 0; slot < count; ++slot)
+	{
+		if (ids[slot] != _GM_TWEEN_REMOVED)
+		{
+			slotOf[ids[slot] & _GM_TWEEN_INDEX_MASK] = _GM_TWEEN_REMOVED;
+			freeIds.push_back(ids[slot]);
+		}
+	}
+
+	count = 0;
+	removed = 0;
+
+	completions.clear();
+}
+
+
+inline size_t TweenPool::size() const
+{
+	return count - removed;
+}
+
+inline size_t TweenPool::slots() const
+{
+	return count;
+}
+
+inline TweenId TweenPool::id(size_t slot) const
+{
+	return ids[slot];
+}
+
+inline const float* TweenPool::values() const
+{
+	return results;
+}
+
+inline const std::vector<unsigned long long>& TweenPool::completed() const
+{
+	return completions;
+}
+
+
+#undef _GM_TWEEN_REMOVED
+#undef _GM_TWEEN_INDEX_MASK
+#undef _GM_TWEEN_GENERATION
+#undef _GM_TWEEN_GRAIN_WORDS
+
+
+#define _GM_BEZIER_INTERVALS 16
+
+#define _GM_BEZIER_NEWTON_ITERATIONS 4
+#define _GM_BEZIER_NEWTON_MIN_SLOPE 1E-3f
+#define _GM_BEZIER_BISECTION_ITERATIONS 20
+
+#define _GM_BEZIER_TOLERANCE 1E-6f
+
+
+// The curve in polynomial form, i.e. x(t) = ((ax * t + bx) * t + cx) * t,
+// along with x(t) at t = i / 16.
+struct _gm_cubic_bezier_table
+{
+	float ax, bx, cx;
+	float ay, by, cy;
+
+	float samples[_GM_BEZIER_INTERVALS + 1];
+
+	template<typename V> V x(const V &t) const { return ((V(ax) * t + V(bx)) * t + V(cx)) * t; }
+	template<typename V> V y(const V &t) const { return ((V(ay) * t + V(by)) * t + V(cy)) * t; }
+	template<typename V> V slope(const V &t) const { return (V(3.0f * ax) * t + V(2.0f * bx)) * t + V(cx); }
+};
+
+// The tables of every curve in use, by control points, shared
+// between translation units (hence not static). Expired tables
+// are erased whenever a new one is added.
+inline std::shared_ptr<const _gm_cubic_bezier_table> _gm_cubic_bezier_cache(float x1, float y1, float x2, float y2)
+{
+	typedef std::tuple<float, float, float, float> Key;
+
+	static std::mutex mutex;
+	static std::map<Key, std::weak_ptr<const _gm_cubic_bezier_table>> tables;
+
+	const Key key(x1, y1, x2, y2);
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto it = tables.find(key);
+
+	if (it != tables.end())
+	{
+		std::shared_ptr<const _gm_cubic_bezier_table> table = it->second.lock();
+
+		if (table)
+			return table;
+	}
+
+	for (auto expired = tables.begin(); expired != tables.end();)
+	{
+		if (expired->second.expired())
+			expired = tables.erase(expired);
+		else
+			++expired;
+	}
+
+	std::shared_ptr<_gm_cubic_bezier_table> table = std::make_shared<_gm_cubic_bezier_table>();
+
+	table->cx = 3.0f * x1;
+	table->bx = 3.0f * (x2 - x1) - table->cx;
+	table->ax = 1.0f - table->cx - table->bx;
+
+	table->cy = 3.0f * y1;
+	table->by = 3.0f * (y2 - y1) - table->cy;
+	table->ay = 1.0f - table->cy - table->by;
+
+	for (int i = 0; i <= _GM_BEZIER_INTERVALS; ++i)
+		table->samples[i] = table->x(float(i) / float(_GM_BEZIER_INTERVALS));
+
+	tables[key] = table;
+
+	return table;
+}
+
+
+inline CubicBezier::CubicBezier(float x1, float y1, float x2, float y2)
+{
+	x1 = (x1 > 0.0f) ? ((x1 < 1.0f) ? x1 : 1.0f) : 0.0f;
+	x2 = (x2 > 0.0f) ? ((x2 < 1.0f) ? x2 : 1.0f) : 0.0f;
+
+	table = _gm_cubic_bezier_cache(x1, y1, x2, y2);
+}
+
+
+// The scalar and the batch version take the same steps, such that
+// they give the same results. Newton-Raphson runs a fixed number of
+// iterations, and is discarded in favor of bisection (within the
+// sampled interval) where the initial slope is too flat or where
+// it hasn't converged, e.g. close to a point where the slope is 0.
+
+inline float CubicBezier::operator()(float time) const
+{
+	const _gm_cubic_bezier_table &table = *this->table;
+
+	const float x = (time > 0.0f) ? ((time < 1.0f) ? time : 1.0f) : 0.0f;
+
+	int i = 0;
+
+	for (int k = 1; k < _GM_BEZIER_INTERVALS; ++k)
+		i += (table.samples[k] <= x) ? 1 : 0;
+
+	const float distance = table.samples[i + 1] - table.samples[i];
+	const float fraction = (distance > 0.0f) ? ((x - table.samples[i]) / distance) : 0.0f;
+
+	const float lower = float(i) * (1.0f / float(_GM_BEZIER_INTERVALS));
+
+	float t = lower + fraction * (1.0f / float(_GM_BEZIER_INTERVALS));
+
+	if (table.slope(t) >= _GM_BEZIER_NEWTON_MIN_SLOPE)
+	{
+		for (int k = 0; k < _GM_BEZIER_NEWTON_ITERATIONS; ++k)
+			t -= (table.x(t) - x) / table.slope(t);
+
+		if (fabsf(table.x(t) - x) <= _GM_BEZIER_TOLERANCE)
+			return table.y(t);
+	}
+
+	float bisectionLower = lower;
+	float bisectionUpper = lower + (1.0f / float(_GM_BEZIER_INTERVALS));
+
+	for (int k = 0; k < _GM_BEZIER_BISECTION_ITERATIONS; ++k)
+	{
+		const float middle = (bisectionLower + bisectionUpper) * 0.5f;
+
+		if (table.x(middle) > x)
+			bisectionUpper = middle;
+		else
+			bisectionLower = middle;
+	}
+
+	return table.y((bisectionLower + bisectionUpper) * 0.5f);
+}
+
+inline void CubicBezier::operator()(const float *time, float *result, size_t count) const
+{
+	_gm_ease_batch(time, result, count, [this](const simd::vfloat &time) -> simd::vfloat
+	{
+		typedef simd::vfloat V;
+
+		const _gm_cubic_bezier_table &table = *this->table;
+
+		const V x = simd::clamp(time, V(0.0f), V(1.0f));
+
+		simd::vint i = simd::vint(0);
+
+		for (int k = 1; k < _GM_BEZIER_INTERVALS; ++k)
+			i = simd::select(V(table.samples[k]) <= x, i + simd::vint(1), i);
+
+		const V lowerSample = simd::gather(table.samples, i);
+		const V distance = simd::gather(table.samples + 1, i) - lowerSample;
+		const V fraction = simd::select(distance > V(0.0f), (x - lowerSample) / simd::max(distance, V(1E-30f)), V(0.0f));
+
+		const V lower = simd::toFloat(i) * V(1.0f / float(_GM_BEZIER_INTERVALS));
+
+		V t = lower + fraction * V(1.0f / float(_GM_BEZIER_INTERVALS));
+
+		// Lanes where Newton-Raphson isn't used compute garbage, which is
+		// then replaced as their residual fails (NaN) or they're flat
+		const auto flat = (table.slope(t) < V(_GM_BEZIER_NEWTON_MIN_SLOPE));
+
+		for (int k = 0; k < _GM_BEZIER_NEWTON_ITERATIONS; ++k)
+			t = t - (table.x(t) - x) / table.slope(t);
+
+		const auto converged = (simd::abs(table.x(t) - x) <= V(_GM_BEZIER_TOLERANCE));
+
+		if (!simd::all(converged) || simd::any(flat))
+		{
+			V bisectionLower = lower;
+			V bisectionUpper = lower + V(1.0f / float(_GM_BEZIER_INTERVALS));
+
+			for (int k = 0; k < _GM_BEZIER_BISECTION_ITERATIONS; ++k)
+			{
+				const V middle = (bisectionLower + bisectionUpper) * V(0.5f);
+				const auto above = (table.x(middle) > x);
+
+				bisectionUpper = simd::select(above, middle, bisectionUpper);
+				bisectionLower = simd::select(above, bisectionLower, middle);
+			}
+
+			t = simd::select(converged, t, (bisectionLower + bisectionUpper) * V(0.5f));
+			t = simd::select(flat, (bisectionLower + bisectionUpper) * V(0.5f), t);
+		}
+
+		return table.y(t);
+	});
+}
+
+
+#undef _GM_BEZIER_INTERVALS
+#undef _GM_BEZIER_NEWTON_ITERATIONS
+#undef _GM_BEZIER_NEWTON_MIN_SLOPE
+#undef _GM_BEZIER_BISECTION_ITERATIONS
+#undef _GM_BEZIER_TOLERANCE
+
+
+inline KeyframeTrack::KeyframeTrack(const Keyframe *keys, size_t count)
+	: keys(keys, keys + count)
+{
+	std::stable_sort(this->keys.begin(), this->keys.end(), [](const Keyframe &a, const Keyframe &b) { return (a.time < b.time); });
+}
+
+
+inline void KeyframeTrack::add(float time, float value, Curve curve)
+{
+	const Keyframe key = { time, value, curve };
+
+	auto it = std::upper_bound(keys.begin(), keys.end(), time, [](float time, const Keyframe &key) { return (time < key.time); });
+	keys.insert(it, key);
+}
+
+inline void KeyframeTrack::clear()
+{
+	keys.clear();
+}
+
+
+inline size_t KeyframeTrack::size() const
+{
+	return keys.size();
+}
+
+inline const Keyframe& KeyframeTrack::key(size_t index) const
+{
+	return keys[index];
+}
+
+
+inline float KeyframeTrack::startTime() const
+{
+	return keys.empty() ? 0.0f : keys.front().time;
+}
+
+inline float KeyframeTrack::endTime() const
+{
+	return keys.empty() ? 0.0f : keys.back().time;
+}
+
+
+inline size_t KeyframeTrack::seek(float time, KeyframeCursor &cursor, float *t) const
+{
+	const size_t last = keys.size() - 2;
+
+	size_t segment = (cursor.segment < last) ? cursor.segment : last;
+
+	// Playback mostly stays within the segment or moves on to the
+	// next one, anything else (seeking) uses a binary search
+	if ((time < keys[segment].time) && (segment > 0))
+	{
+		segment = std::upper_bound(keys.begin() + 1, keys.begin() + segment, time, [](float time, const Keyframe &key) { return (time < key.time); }) - keys.begin() - 1;
+	}
+	else if ((time >= keys[segment + 1].time) && (segment < last))
+	{
+		++segment;
+
+		if ((time >= keys[segment + 1].time) && (segment < last))
+			segment = std::upper_bound(keys.begin() + segment + 1, keys.end() - 1, time, [](float time, const Keyframe &key) { return (time < key.time); }) - keys.begin() - 1;
+	}
+
+	cursor.segment = segment;
+
+	const float start = keys[segment].time;
+	const float duration = keys[segment + 1].time - start;
+
+	// Segments of 0 duration are steps, taken at their time
+	const float relative = (time < start) ? 0.0f : ((duration > 0.0f) ? ((time - start) / duration) : 1.0f);
+
+	if (t) (*t) = (relative > 0.0f) ? ((relative < 1.0f) ? relative : 1.0f) : 0.0f;
+
+	return segment;
+}
+
+
+inline float KeyframeTrack::sample(float time) const
+{
+	KeyframeCursor cursor;
+	return sample(time, cursor);
+}
+
+inline float KeyframeTrack::sample(float time, KeyframeCursor &cursor) const
+{
+	if (keys.size() < 2)
+		return keys.empty() ? 0.0f : keys.front().value;
+
+	float t;
+	const size_t segment = seek(time, cursor, &t);
+
+	const Keyframe &from = keys[segment];
+	const Keyframe &to = keys[segment + 1];
+
+	return from.value + (to.value - from.value) * ease(from.curve, t);
+}
+
+
+#define _GM_KEYFRAME_BLOCK_SIZE 1024
+
+GM_EASING_API inline void sample(const KeyframeTrack *tracks, KeyframeCursor *cursors, const float *time, float *result, size_t count)
+{
+	Curve curves[_GM_KEYFRAME_BLOCK_SIZE];
+	float t[_GM_KEYFRAME_BLOCK_SIZE];
+	float from[_GM_KEYFRAME_BLOCK_SIZE];
+	float to[_GM_KEYFRAME_BLOCK_SIZE];
+
+	for (size_t first = 0; first < count; first += _GM_KEYFRAME_BLOCK_SIZE)
+	{
+		const size_t n = ((count - first) < _GM_KEYFRAME_BLOCK_SIZE) ? (count - first) : _GM_KEYFRAME_BLOCK_SIZE;
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const KeyframeTrack &track = tracks[first + i];
+
+			// Tracks with less than 2 keys are constant, which is
+			// the same as a linear segment between equal values
+			if (track.size() < 2)
+			{
+				curves[i] = Curve::Linear;
+				t[i] = 0.0f;
+				from[i] = to[i] = track.sample(0.0f);
+
+				continue;
+			}
+
+			const size_t segment = track.seek(time[first + i], cursors[first + i], t + i);
+
+			curves[i] = track.key(segment).curve;
+			from[i] = track.key(segment).value;
+			to[i] = track.key(segment + 1).value;
+		}
+
+		ease(curves, t, t, n);
+
+		for (size_t i = 0; i < n; ++i)
+			result[first + i] = from[i] + (to[i] - from[i]) * t[i];
+	}
+}
+
+#undef _GM_KEYFRAME_BLOCK_SIZE
+
+
+// The derivative kernels are written once for both scalars and
+// vectors, using the following overloads for the operations that
+// differ between them.
+
+template<typename V> struct _gm_ease_scalar { typedef typename V::scalar type; };
+template<> struct _gm_ease_scalar<float> { typedef float type; };
+template<> struct _gm_ease_scalar<double> { typedef double type; };
+
+GM_EASING_API inline float _gm_ease_select(bool mask, float a, float b) { return mask ? a : b; }
+GM_EASING_API inline double _gm_ease_select(bool mask, double a, double b) { return mask ? a : b; }
+template<typename M, typename V> GM_EASING_API inline V _gm_ease_select(const M &mask, const V &a, const V &b) { return simd::select(mask, a, b); }
+
+GM_EASING_API inline bool _gm_ease_and(bool a, bool b) { return (a && b); }
+template<typename M> GM_EASING_API inline M _gm_ease_and(const M &a, const M &b) { return (a & b); }
+
+GM_EASING_API inline float _gm_ease_sqrt(float x) { return sqrtf(x); }
+GM_EASING_API inline double _gm_ease_sqrt(double x) { return sqrt(x); }
+template<typename V> GM_EASING_API inline V _gm_ease_sqrt(const V &x) { return simd::sqrt(x); }
+
+GM_EASING_API inline float _gm_ease_exp2(float x) { return exp2f(x); }
+GM_EASING_API inline double _gm_ease_exp2(double x) { return exp2(x); }
+template<typename V> GM_EASING_API inline V _gm_ease_exp2(const V &x) { return simd::exp2(x); }
+
+GM_EASING_API inline void _gm_ease_sincos(float x, float *s, float *c) { *s = sinf(x); *c = cosf(x); }
+GM_EASING_API inline void _gm_ease_sincos(double x, double *s, double *c) { *s = sin(x); *c = cos(x); }
+template<typename V> GM_EASING_API inline void _gm_ease_sincos(const V &x, V *s, V *c) { simd::sincos(x, s, c); }
+
+
+template<typename Kernel, typename T> GM_EASING_API void _gm_ease_derivative_batch(const T *time, T *value, T *derivative, size_t count)
+{
+	typedef typename simd::vector<T>::type V;
+
+	const Kernel kernel = Kernel();
+	const size_t width = V::width;
+
+	for (size_t i = 0; i < count; i += width)
+	{
+		const size_t n = ((count - i) < width) ? (count - i) : width;
+
+		V d;
+		const V v = kernel((n == width) ? V::loadu(time + i) : simd::loadPartial<V>(time + i, n), &d);
+
+		if (n == width)
+		{
+			if (value) v.storeu(value + i);
+			if (derivative) d.storeu(derivative + i);
+		}
+		else
+		{
+			if (value) simd::storePartial(v, value + i, n);
+			if (derivative) simd::storePartial(d, derivative + i, n);
+		}
+	}
+}
+
+
+#define _GM_EASING_DERIVATIVE_KERNEL(name) \
+	struct _gm_##name##_derivative_kernel \
+	{ \
+		template<typename V> V operator()(const V &time, V *derivative) const; \
+	}; \
+	\
+	template<typename T> GM_EASING_API inline T name##Derivative(const T time) \
+	{ \
+		T derivative; \
+		_gm_##name##_derivative_kernel()(time, &derivative); \
+		return derivative; \
+	} \
+	\
+	template<typename T> GM_EASING_API inline T name(const T time, T *derivative) \
+	{ \
+		T d; \
+		const T value = _gm_##name##_derivative_kernel()(time, &d); \
+		if (derivative) (*derivative) = d; \
+		return value; \
+	} \
+	\
+	template<typename T> GM_EASING_API inline void name##Derivative(const T *time, T *result, size_t count) \
+	{ \
+		_gm_ease_derivative_batch<_gm_##name##_derivative_kernel>(time, static_cast<T*>(nullptr), result, count); \
+	} \
+	\
+	template<typename T> GM_EASING_API inline void name(const T *time, T *value, T *derivative, size_t count) \
+	{ \
+		_gm_ease_derivative_batch<_gm_##name##_derivative_kernel>(time, value, derivative, count); \
+	} \
+	\
+	template<typename V> inline V _gm_##name##_derivative_kernel::operator()(const V &time, V *derivative) const
+
+
+_GM_EASING_DERIVATIVE_KERNEL(easeLinear)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	*derivative = V(T(1));
+	return time;
+}
+
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInQuad)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	*derivative = V(T(2)) * time;
+	return (time * time);
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeOutQuad)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V t = time - V(T(1));
+
+	*derivative = V(T(-2)) * t;
+	return -(t * t - V(T(1)));
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInOutQuad)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V t = time * V(T(2));
+	const V u = t - V(T(2));
+	const auto in = (t < V(T(1)));
+
+	*derivative = _gm_ease_select(in, V(T(2)) * t, V(T(-2)) * u);
+	return _gm_ease_select(in, V(T(0.5)) * t * t, V(T(-0.5)) * (u * u - V(T(2))));
+}
+
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInCubic)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	*derivative = V(T(3)) * time * time;
+	return (time * time * time);
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeOutCubic)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V t = time - V(T(1));
+
+	*derivative = V(T(3)) * t * t;
+	return (t * t * t + V(T(1)));
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInOutCubic)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V t = time / V(T(0.5));
+	const V u = t - V(T(2));
+	const auto in = (t < V(T(1)));
+
+	*derivative = _gm_ease_select(in, V(T(3)) * t * t, V(T(3)) * u * u);
+	return _gm_ease_select(in, V(T(0.5)) * t * t * t, V(T(0.5)) * (u * u * u + V(T(2))));
+}
+
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInQuart)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	*derivative = V(T(4)) * time * time * time;
+	return (time * time * time * time);
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeOutQuart)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V t = time - V(T(1));
+
+	*derivative = V(T(-4)) * t * t * t;
+	return -(t * t * t * t - V(T(1)));
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInOutQuart)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V t = time * V(T(2));
+	const V u = t - V(T(2));
+	const auto in = (t < V(T(1)));
+
+	*derivative = _gm_ease_select(in, V(T(4)) * t * t * t, V(T(-4)) * u * u * u);
+	return _gm_ease_select(in, V(T(0.5)) * t * t * t * t, V(T(-0.5)) * (u * u * u * u - V(T(2))));
+}
+
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInQuint)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	*derivative = V(T(5)) * time * time * time * time;
+	return (time * time * time * time * time);
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeOutQuint)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V t = time - V(T(1));
+
+	*derivative = V(T(5)) * t * t * t * t;
+	return (t * t * t * t * t + V(T(1)));
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInOutQuint)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V t = time * V(T(2));
+	const V u = t - V(T(2));
+	const auto in = (t < V(T(1)));
+
+	*derivative = _gm_ease_select(in, V(T(5)) * t * t * t * t, V(T(5)) * u * u * u * u);
+	return _gm_ease_select(in, V(T(0.5)) * t * t * t * t * t, V(T(0.5)) * (u * u * u * u * u + V(T(2))));
+}
+
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInSine)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	V s, c;
+	_gm_ease_sincos(time * V(T(3.1415926535897932) / T(2)), &s, &c);
+
+	*derivative = V(T(3.1415926535897932) / T(2)) * s;
+	return -c + V(T(1));
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeOutSine)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	V s, c;
+	_gm_ease_sincos(time * V(T(3.1415926535897932) / T(2)), &s, &c);
+
+	*derivative = V(T(3.1415926535897932) / T(2)) * c;
+	return s;
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInOutSine)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	V s, c;
+	_gm_ease_sincos(V(T(3.1415926535897932)) * time, &s, &c);
+
+	*derivative = V(T(3.1415926535897932) / T(2)) * s;
+	return (V(T(-0.5)) * (c - V(T(1))));
+}
+
+
+// d/dt 2^(a * t) = a * ln(2) * 2^(a * t), where 10 * ln(2) is 6.93...
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInExpo)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const auto zero = _gm_ease_and(V(-_gm_ease_epsilon<T>()) < time, time < V(_gm_ease_epsilon<T>()));
+	const V p = _gm_ease_exp2(V(T(10)) * (time - V(T(1))));
+
+	*derivative = _gm_ease_select(zero, V(T(0)), V(T(6.9314718055994531)) * p);
+	return _gm_ease_select(zero, V(T(0)), p);
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeOutExpo)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const auto one = _gm_ease_and(V(T(1) - _gm_ease_epsilon<T>()) < time, time < V(T(1) + _gm_ease_epsilon<T>()));
+	const V p = _gm_ease_exp2(V(T(-10)) * time);
+
+	*derivative = _gm_ease_select(one, V(T(0)), V(T(6.9314718055994531)) * p);
+	return _gm_ease_select(one, V(T(1)), -p + V(T(1)));
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInOutExpo)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const auto zero = _gm_ease_and(V(-_gm_ease_epsilon<T>()) < time, time < V(_gm_ease_epsilon<T>()));
+	const auto one = _gm_ease_and(V(T(1) - _gm_ease_epsilon<T>()) < time, time < V(T(1) + _gm_ease_epsilon<T>()));
+
+	const V t = time * V(T(2));
+	const V u = t - V(T(1));
+	const auto in = (t < V(T(1)));
+
+	// Only one of the two powers is needed per lane
+	const V p = _gm_ease_exp2(_gm_ease_select(in, V(T(10)) * u, V(T(-10)) * u));
+
+	const V value = _gm_ease_select(in, V(T(0.5)) * p, V(T(0.5)) * (-p + V(T(2))));
+
+	*derivative = _gm_ease_select(zero, V(T(0)), _gm_ease_select(one, V(T(0)), V(T(6.9314718055994531)) * p));
+	return _gm_ease_select(zero, V(T(0)), _gm_ease_select(one, V(T(1)), value));
+}
+
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInCirc)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V root = _gm_ease_sqrt(V(T(1)) - time * time);
+
+	*derivative = time / root;
+	return -(root - V(T(1)));
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeOutCirc)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V t = time - V(T(1));
+	const V root = _gm_ease_sqrt(V(T(1)) - t * t);
+
+	*derivative = -t / root;
+	return root;
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInOutCirc)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V t = time * V(T(2));
+	const auto in = (t < V(T(1)));
+
+	// Both halves are the same circle, offset by 2
+	const V u = _gm_ease_select(in, t, t - V(T(2)));
+	const V root = _gm_ease_sqrt(V(T(1)) - u * u);
+
+	*derivative = _gm_ease_select(in, u / root, -u / root);
+	return _gm_ease_select(in, V(T(-0.5)) * (root - V(T(1))), V(T(0.5)) * (root + V(T(1))));
+}
+
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInBack)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	*derivative = time * (V(T(3) * T(2.70158)) * time - V(T(2) * T(1.70158)));
+	return (time * time * (V(T(2.70158)) * time - V(T(1.70158))));
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeOutBack)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V t = time - V(T(1));
+
+	*derivative = t * (V(T(3) * T(2.70158)) * t + V(T(2) * T(1.70158)));
+	return (t * t * (V(T(2.70158)) * t + V(T(1.70158))) + V(T(1)));
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInOutBack)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const T s = T(1.70158) * T(1.525);
+
+	const V t = time * V(T(2));
+	const V u = t - V(T(2));
+	const auto in = (t < V(T(1)));
+
+	*derivative = _gm_ease_select(in, t * (V(T(3) * (s + T(1))) * t - V(T(2) * s)), u * (V(T(3) * (s + T(1))) * u + V(T(2) * s)));
+	return _gm_ease_select(in, V(T(0.5)) * (t * t * (V(s + T(1)) * t - V(s))), V(T(0.5)) * (u * u * (V(s + T(1)) * u + V(s)) + V(T(2))));
+}
+
+
+// d/dt sin(w * t) * 2^(a * t) = 2^(a * t) * (w * cos(w * t) + a * ln(2) * sin(w * t))
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInElastic)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const T w = T(13) * (T(3.1415926535897932) / T(2));
+
+	V s, c;
+	_gm_ease_sincos(V(w) * time, &s, &c);
+
+	const V p = _gm_ease_exp2(V(T(10)) * (time - V(T(1))));
+
+	*derivative = p * (V(w) * c + V(T(6.9314718055994531)) * s);
+	return s * p;
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeOutElastic)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const T w = T(-13) * (T(3.1415926535897932) / T(2));
+
+	V s, c;
+	_gm_ease_sincos(V(w) * (time + V(T(1))), &s, &c);
+
+	const V p = _gm_ease_exp2(V(T(-10)) * time);
+
+	*derivative = p * (V(w) * c - V(T(6.9314718055994531)) * s);
+	return s * p + V(T(1));
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInOutElastic)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const T w = T(13) * (T(3.1415926535897932) / T(2));
+
+	const V t = V(T(2)) * time;
+	const V u = t - V(T(1));
+	const auto in = (time < V(T(0.5)));
+
+	// The second half is the first negated and mirrored, so both
+	// share one sin(), cos() and pow() per lane
+	V s, c;
+	_gm_ease_sincos(_gm_ease_select(in, V(w) * t, V(-w) * (u + V(T(1)))), &s, &c);
+
+	const V p = _gm_ease_exp2(_gm_ease_select(in, V(T(10)) * u, V(T(-10)) * u));
+
+	*derivative = _gm_ease_select(in, p * (V(w) * c + V(T(6.9314718055994531)) * s), p * (V(-w) * c - V(T(6.9314718055994531)) * s));
+	return _gm_ease_select(in, V(T(0.5)) * s * p, V(T(0.5)) * (s * p + V(T(2))));
+}
+
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInBounce)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V offset = _gm_ease_select(time < V(T(1) / T(2.75)), V(T(0)),
+		_gm_ease_select(time < V(T(2) / T(2.75)), V(T(1.5) / T(2.75)),
+		_gm_ease_select(time < V(T(2.5) / T(2.75)), V(T(2.25) / T(2.75)), V(T(2.625) / T(2.75)))));
+
+	const V base = _gm_ease_select(time < V(T(1) / T(2.75)), V(T(0)),
+		_gm_ease_select(time < V(T(2) / T(2.75)), V(T(0.75)),
+		_gm_ease_select(time < V(T(2.5) / T(2.75)), V(T(0.9375)), V(T(0.984375)))));
+
+	const V t = time - offset;
+
+	*derivative = V(T(2) * T(7.5625)) * t;
+	return V(T(7.5625)) * t * t + base;
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeOutBounce)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const V value = _gm_easeInBounce_derivative_kernel()(V(T(1)) - time, derivative);
+	return (V(T(1)) - value);
+}
+
+_GM_EASING_DERIVATIVE_KERNEL(easeInOutBounce)
+{
+	typedef typename _gm_ease_scalar<V>::type T;
+
+	const auto in = (time < V(T(0.5)));
+
+	// easeOutBounce(2t) is 1 - easeInBounce(1 - 2t)
+	V d;
+	const V value = _gm_easeInBounce_derivative_kernel()(_gm_ease_select(in, V(T(1)) - time * V(T(2)), time * V(T(2)) - V(T(1))), &d);
+
+	*derivative = d;
+	return _gm_ease_select(in, V(T(0.5)) * (V(T(1)) - value), V(T(0.5)) * value + V(T(0.5)));
+}
+
+
+#undef _GM_EASING_DERIVATIVE_KERNEL
+
+
 }
 
 #ifndef GM_NO_NAMESPACE
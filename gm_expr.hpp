@@ -0,0 +1,551 @@
+
+// Author: Christian Vallentin <mail@vallentinsource.com>
+// Website: http://vallentinsource.com
+// Repository: https://github.com/MrVallentin/GameMath
+//
+// Date Created: October 18, 2026
+// Last Modified: October 18, 2026
+
+// Copyright (c) 2012-2016 Christian Vallentin <mail@vallentinsource.com>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+
+// Refrain from using any exposed macros, functions
+// or structs prefixed with an underscore. As these
+// are only intended for internal purposes. Which
+// additionally means they can be removed, renamed
+// or changed between minor updates without notice.
+
+// This library contains lazy array expressions of the batch functions
+// of gm_math.hpp and gm_easing.hpp. Chaining them, e.g.
+//
+//   evaluate(smoothstep(0.0f, 1.0f, clamp(map(array(x, n), ...), ...)), result);
+//
+// only builds the expression (as a type), and evaluate() then runs the
+// whole chain in a single vectorized pass, without any intermediate
+// arrays. Every element is read once and written once, compared to a
+// read and a write per function when calling the batch functions one
+// after another.
+
+#ifndef GM_EXPR_HPP
+#define GM_EXPR_HPP
+
+
+#ifndef GM_STRINGIFY_VERSION
+#	define _GM_STRINGIFY(str) #str
+#	define _GM_STRINGIFY_TOKEN(str) _GM_STRINGIFY(str)
+#	define GM_STRINGIFY_VERSION(major, minor, patch) _GM_STRINGIFY(major) "." _GM_STRINGIFY(minor) "." _GM_STRINGIFY(patch)
+#endif
+
+
+#define GM_EXPR_NAME "GameMath Expr"
+
+#define GM_EXPR_VERSION_MAJOR 1
+#define GM_EXPR_VERSION_MINOR 0
+#define GM_EXPR_VERSION_PATCH 0
+
+#define GM_EXPR_VERSION GM_STRINGIFY_VERSION(GM_EXPR_VERSION_MAJOR, GM_EXPR_VERSION_MINOR, GM_EXPR_VERSION_PATCH)
+
+#define GM_EXPR_NAME_VERSION GM_EXPR_NAME " " GM_EXPR_VERSION
+
+
+#include <stddef.h>
+
+#include <type_traits>
+
+#include "gm_easing.hpp"
+#include "gm_math.hpp"
+#include "gm_simd.hpp"
+
+
+#define GM_EXPR_API static
+
+
+#ifndef GM_NO_NAMESPACE
+namespace gm {
+#endif
+
+namespace expr {
+
+
+// An expression is a type deriving from _gm_expr, with the scalar
+// type of its elements as scalar, and the number of elements as
+// size() (0 for constants). Calling it with (i, n) evaluates the
+// elements [i;i+n), returned as a vector of gm_simd.hpp (n is
+// the vector width, except at the head and the tail).
+//
+// Expressions hold their operands by value, and arrays only hold
+// a pointer, so they're cheap to copy and can be stored with auto.
+struct _gm_expr {};
+
+template<typename X> struct _gm_is_expr : std::is_base_of<_gm_expr, X> {};
+
+// Operands are either expressions, or floats and doubles, which
+// are converted to the scalar type and broadcasted.
+template<typename X> struct _gm_is_operand : std::integral_constant<bool, _gm_is_expr<X>::value || std::is_arithmetic<X>::value> {};
+
+
+template<typename T> struct _gm_expr_array;
+template<typename T> struct _gm_expr_constant;
+
+template<typename Op, typename A> struct _gm_expr_unary;
+template<typename Op, typename A, typename B> struct _gm_expr_binary;
+template<typename Op, typename A, typename B, typename C> struct _gm_expr_ternary;
+
+template<typename Op, typename A, typename = void> struct _gm_expr_result1 {};
+template<typename Op, typename A, typename B, typename = void> struct _gm_expr_result2 {};
+template<typename Op, typename A, typename B, typename C, typename = void> struct _gm_expr_result3 {};
+
+template<typename Op, typename A> using _gm_expr_unary_t = typename _gm_expr_result1<Op, A>::type;
+template<typename Op, typename A, typename B> using _gm_expr_binary_t = typename _gm_expr_result2<Op, A, B>::type;
+template<typename Op, typename A, typename B, typename C> using _gm_expr_ternary_t = typename _gm_expr_result3<Op, A, B, C>::type;
+
+struct _gm_expr_add;
+struct _gm_expr_sub;
+struct _gm_expr_mul;
+struct _gm_expr_div;
+struct _gm_expr_neg;
+struct _gm_expr_lerp;
+struct _gm_expr_fract;
+
+template<typename T> struct _gm_expr_affine;
+template<typename T> struct _gm_expr_clamp;
+template<typename T> struct _gm_expr_smoothstep;
+
+
+// The count elements of p, which must stay alive until the
+// expression is evaluated.
+template<typename T> GM_EXPR_API _gm_expr_array<T> array(const T *p, size_t count);
+
+
+// The operands of an expression must have the same size, and
+// can be mixed with floats and doubles, e.g. array(x, n) * 2.0f.
+template<typename A, typename B> GM_EXPR_API _gm_expr_binary_t<_gm_expr_add, A, B> operator+(const A &a, const B &b);
+template<typename A, typename B> GM_EXPR_API _gm_expr_binary_t<_gm_expr_sub, A, B> operator-(const A &a, const B &b);
+template<typename A, typename B> GM_EXPR_API _gm_expr_binary_t<_gm_expr_mul, A, B> operator*(const A &a, const B &b);
+template<typename A, typename B> GM_EXPR_API _gm_expr_binary_t<_gm_expr_div, A, B> operator/(const A &a, const B &b);
+template<typename A> GM_EXPR_API _gm_expr_unary_t<_gm_expr_neg, A> operator-(const A &a);
+
+
+// The same as the batch functions of gm_math.hpp, where the
+// parameters of map(), normalize(), clamp() and smoothstep()
+// are the same for every element.
+template<typename E> GM_EXPR_API _gm_expr_unary_t<_gm_expr_affine<typename E::scalar>, E> map(const E &value, const typename E::scalar &min1, const typename E::scalar &max1, const typename E::scalar &min2, const typename E::scalar &max2);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<_gm_expr_affine<typename E::scalar>, E> normalize(const typename E::scalar &from, const typename E::scalar &to, const E &value);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<_gm_expr_clamp<typename E::scalar>, E> clamp(const E &x, const typename E::scalar &min, const typename E::scalar &max);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<_gm_expr_smoothstep<typename E::scalar>, E> smoothstep(const typename E::scalar &edge0, const typename E::scalar &edge1, const E &x);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<_gm_expr_fract, E> fract(const E &x);
+
+template<typename A, typename B, typename C> GM_EXPR_API _gm_expr_ternary_t<_gm_expr_lerp, A, B, C> lerp(const A &from, const B &to, const C &t);
+
+
+// The easing curves of gm_easing.hpp, e.g. easeInOutSine(x).
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeLinear_kernel, E> easeLinear(const E &time);
+
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInQuad_kernel, E> easeInQuad(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeOutQuad_kernel, E> easeOutQuad(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInOutQuad_kernel, E> easeInOutQuad(const E &time);
+
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInCubic_kernel, E> easeInCubic(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeOutCubic_kernel, E> easeOutCubic(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInOutCubic_kernel, E> easeInOutCubic(const E &time);
+
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInQuart_kernel, E> easeInQuart(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeOutQuart_kernel, E> easeOutQuart(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInOutQuart_kernel, E> easeInOutQuart(const E &time);
+
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInQuint_kernel, E> easeInQuint(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeOutQuint_kernel, E> easeOutQuint(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInOutQuint_kernel, E> easeInOutQuint(const E &time);
+
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInSine_kernel, E> easeInSine(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeOutSine_kernel, E> easeOutSine(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInOutSine_kernel, E> easeInOutSine(const E &time);
+
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInExpo_kernel, E> easeInExpo(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeOutExpo_kernel, E> easeOutExpo(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInOutExpo_kernel, E> easeInOutExpo(const E &time);
+
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInCirc_kernel, E> easeInCirc(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeOutCirc_kernel, E> easeOutCirc(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInOutCirc_kernel, E> easeInOutCirc(const E &time);
+
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInBack_kernel, E> easeInBack(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeOutBack_kernel, E> easeOutBack(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInOutBack_kernel, E> easeInOutBack(const E &time);
+
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInElastic_kernel, E> easeInElastic(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeOutElastic_kernel, E> easeOutElastic(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInOutElastic_kernel, E> easeInOutElastic(const E &time);
+
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInBounce_kernel, E> easeInBounce(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeOutBounce_kernel, E> easeOutBounce(const E &time);
+template<typename E> GM_EXPR_API _gm_expr_unary_t<easing::_gm_easeInOutBounce_kernel, E> easeInOutBounce(const E &time);
+
+
+// Applies f to the elements of x, where f is callable with the
+// vector types of gm_simd.hpp, e.g. a generic lambda or a struct
+// with a templated operator().
+template<typename F, typename E> GM_EXPR_API _gm_expr_unary_t<F, E> apply(const E &x, const F &f);
+
+
+// Evaluates e into result, which must hold e.size() elements.
+// result can be one of the arrays of e.
+template<typename E> GM_EXPR_API void evaluate(const E &e, typename E::scalar *result);
+
+
+// After this point everything you'll see is all
+// the definitions to the prior declarations.
+
+
+template<typename T> struct _gm_expr_array : _gm_expr
+{
+	typedef T scalar;
+	typedef typename simd::vector<T>::type V;
+
+	const T *p;
+	size_t count;
+
+	_gm_expr_array(const T *p, size_t count) : p(p), count(count) {}
+
+	size_t size() const { return count; }
+	V operator()(size_t i, size_t n) const { return _gm_math_load<V>(p + i, n); }
+};
+
+template<typename T> struct _gm_expr_constant : _gm_expr
+{
+	typedef T scalar;
+	typedef typename simd::vector<T>::type V;
+
+	T value;
+
+	explicit _gm_expr_constant(const T &value) : value(value) {}
+
+	size_t size() const { return 0; }
+	V operator()(size_t, size_t) const { return V(value); }
+};
+
+
+template<typename Op, typename A> struct _gm_expr_unary : _gm_expr
+{
+	typedef typename A::scalar scalar;
+	typedef typename simd::vector<scalar>::type V;
+
+	Op op;
+	A a;
+
+	_gm_expr_unary(const Op &op, const A &a) : op(op), a(a) {}
+
+	size_t size() const { return a.size(); }
+	V operator()(size_t i, size_t n) const { return op(a(i, n)); }
+};
+
+template<typename Op, typename A, typename B> struct _gm_expr_binary : _gm_expr
+{
+	static_assert(std::is_same<typename A::scalar, typename B::scalar>::value, "The operands of an expression must have the same scalar type");
+
+	typedef typename A::scalar scalar;
+	typedef typename simd::vector<scalar>::type V;
+
+	Op op;
+	A a;
+	B b;
+
+	_gm_expr_binary(const Op &op, const A &a, const B &b) : op(op), a(a), b(b) {}
+
+	size_t size() const { return (a.size() != 0) ? a.size() : b.size(); }
+	V operator()(size_t i, size_t n) const { return op(a(i, n), b(i, n)); }
+};
+
+template<typename Op, typename A, typename B, typename C> struct _gm_expr_ternary : _gm_expr
+{
+	static_assert(std::is_same<typename A::scalar, typename B::scalar>::value && std::is_same<typename A::scalar, typename C::scalar>::value, "The operands of an expression must have the same scalar type");
+
+	typedef typename A::scalar scalar;
+	typedef typename simd::vector<scalar>::type V;
+
+	Op op;
+	A a;
+	B b;
+	C c;
+
+	_gm_expr_ternary(const Op &op, const A &a, const B &b, const C &c) : op(op), a(a), b(b), c(c) {}
+
+	size_t size() const { return (a.size() != 0) ? a.size() : ((b.size() != 0) ? b.size() : c.size()); }
+	V operator()(size_t i, size_t n) const { return op(a(i, n), b(i, n), c(i, n)); }
+};
+
+
+// Wraps a float or double as a constant of T, and
+// leaves expressions as they are.
+template<typename T, typename X, bool = _gm_is_expr<X>::value> struct _gm_expr_operand
+{
+	typedef X type;
+	static const X& wrap(const X &x) { return x; }
+};
+
+template<typename T, typename X> struct _gm_expr_operand<T, X, false>
+{
+	typedef _gm_expr_constant<T> type;
+	static type wrap(const X &x) { return type(static_cast<T>(x)); }
+};
+
+// The scalar type of the first expression of A, B and C
+template<typename A, typename B, typename C = A> struct _gm_expr_scalar
+{
+	typedef typename std::conditional<_gm_is_expr<A>::value, A, typename std::conditional<_gm_is_expr<B>::value, B, C>::type>::type::scalar type;
+};
+
+
+template<typename Op, typename A> struct _gm_expr_result1<Op, A, typename std::enable_if<_gm_is_expr<A>::value>::type>
+{
+	typedef _gm_expr_unary<Op, A> type;
+
+	static type make(const Op &op, const A &a) { return type(op, a); }
+};
+
+template<typename Op, typename A, typename B> struct _gm_expr_result2<Op, A, B, typename std::enable_if<(_gm_is_expr<A>::value || _gm_is_expr<B>::value) && _gm_is_operand<A>::value && _gm_is_operand<B>::value>::type>
+{
+	typedef typename _gm_expr_scalar<A, B>::type T;
+	typedef _gm_expr_binary<Op, typename _gm_expr_operand<T, A>::type, typename _gm_expr_operand<T, B>::type> type;
+
+	static type make(const Op &op, const A &a, const B &b) { return type(op, _gm_expr_operand<T, A>::wrap(a), _gm_expr_operand<T, B>::wrap(b)); }
+};
+
+template<typename Op, typename A, typename B, typename C> struct _gm_expr_result3<Op, A, B, C, typename std::enable_if<(_gm_is_expr<A>::value || _gm_is_expr<B>::value || _gm_is_expr<C>::value) && _gm_is_operand<A>::value && _gm_is_operand<B>::value && _gm_is_operand<C>::value>::type>
+{
+	typedef typename _gm_expr_scalar<A, B, C>::type T;
+	typedef _gm_expr_ternary<Op, typename _gm_expr_operand<T, A>::type, typename _gm_expr_operand<T, B>::type, typename _gm_expr_operand<T, C>::type> type;
+
+	static type make(const Op &op, const A &a, const B &b, const C &c) { return type(op, _gm_expr_operand<T, A>::wrap(a), _gm_expr_operand<T, B>::wrap(b), _gm_expr_operand<T, C>::wrap(c)); }
+};
+
+
+// The operations mirror the kernels of the batch functions, such
+// that the results are the same (unless the compiler contracts a
+// multiplication and an addition of different nodes into an FMA)
+
+struct _gm_expr_add { template<typename V> V operator()(const V &a, const V &b) const { return a + b; } };
+struct _gm_expr_sub { template<typename V> V operator()(const V &a, const V &b) const { return a - b; } };
+struct _gm_expr_mul { template<typename V> V operator()(const V &a, const V &b) const { return a * b; } };
+struct _gm_expr_div { template<typename V> V operator()(const V &a, const V &b) const { return a / b; } };
+struct _gm_expr_neg { template<typename V> V operator()(const V &a) const { return -a; } };
+
+struct _gm_expr_lerp
+{
+	template<typename V> V operator()(const V &from, const V &to, const V &t) const
+	{
+		typedef typename V::scalar T;
+		return simd::fmadd(t, to, (V(T(1)) - t) * from);
+	}
+};
+
+struct _gm_expr_fract
+{
+	template<typename V> V operator()(const V &x) const
+	{
+		return x - simd::floor(x);
+	}
+};
+
+// (x - offset) * scale + base
+template<typename T> struct _gm_expr_affine
+{
+	T offset, scale, base;
+
+	template<typename V> V operator()(const V &x) const
+	{
+		return simd::fmadd(x - V(offset), V(scale), V(base));
+	}
+};
+
+template<typename T> struct _gm_expr_clamp
+{
+	T min, max;
+
+	template<typename V> V operator()(const V &x) const
+	{
+		return simd::clamp(x, V(min), V(max));
+	}
+};
+
+template<typename T> struct _gm_expr_smoothstep
+{
+	T offset, scale;
+
+	template<typename V> V operator()(const V &x) const
+	{
+		const V t = simd::clamp((x - V(offset)) * V(scale), V(T(0)), V(T(1)));
+		return t * t * (V(T(3)) - V(T(2)) * t);
+	}
+};
+
+
+template<typename T> GM_EXPR_API inline _gm_expr_array<T> array(const T *p, size_t count)
+{
+	return _gm_expr_array<T>(p, count);
+}
+
+
+template<typename A, typename B> GM_EXPR_API inline _gm_expr_binary_t<_gm_expr_add, A, B> operator+(const A &a, const B &b)
+{
+	return _gm_expr_result2<_gm_expr_add, A, B>::make(_gm_expr_add(), a, b);
+}
+
+template<typename A, typename B> GM_EXPR_API inline _gm_expr_binary_t<_gm_expr_sub, A, B> operator-(const A &a, const B &b)
+{
+	return _gm_expr_result2<_gm_expr_sub, A, B>::make(_gm_expr_sub(), a, b);
+}
+
+template<typename A, typename B> GM_EXPR_API inline _gm_expr_binary_t<_gm_expr_mul, A, B> operator*(const A &a, const B &b)
+{
+	return _gm_expr_result2<_gm_expr_mul, A, B>::make(_gm_expr_mul(), a, b);
+}
+
+template<typename A, typename B> GM_EXPR_API inline _gm_expr_binary_t<_gm_expr_div, A, B> operator/(const A &a, const B &b)
+{
+	return _gm_expr_result2<_gm_expr_div, A, B>::make(_gm_expr_div(), a, b);
+}
+
+template<typename A> GM_EXPR_API inline _gm_expr_unary_t<_gm_expr_neg, A> operator-(const A &a)
+{
+	return _gm_expr_result1<_gm_expr_neg, A>::make(_gm_expr_neg(), a);
+}
+
+
+template<typename E> GM_EXPR_API inline _gm_expr_unary_t<_gm_expr_affine<typename E::scalar>, E> map(const E &value, const typename E::scalar &min1, const typename E::scalar &max1, const typename E::scalar &min2, const typename E::scalar &max2)
+{
+	typedef typename E::scalar T;
+
+	const _gm_expr_affine<T> op = { min1, (max2 - min2) / (max1 - min1), min2 };
+	return _gm_expr_result1<_gm_expr_affine<T>, E>::make(op, value);
+}
+
+template<typename E> GM_EXPR_API inline _gm_expr_unary_t<_gm_expr_affine<typename E::scalar>, E> normalize(const typename E::scalar &from, const typename E::scalar &to, const E &value)
+{
+	typedef typename E::scalar T;
+
+	const _gm_expr_affine<T> op = { from, T(1) / (to - from), T(0) };
+	return _gm_expr_result1<_gm_expr_affine<T>, E>::make(op, value);
+}
+
+template<typename E> GM_EXPR_API inline _gm_expr_unary_t<_gm_expr_clamp<typename E::scalar>, E> clamp(const E &x, const typename E::scalar &min, const typename E::scalar &max)
+{
+	typedef typename E::scalar T;
+
+	const _gm_expr_clamp<T> op = { min, max };
+	return _gm_expr_result1<_gm_expr_clamp<T>, E>::make(op, x);
+}
+
+template<typename E> GM_EXPR_API inline _gm_expr_unary_t<_gm_expr_smoothstep<typename E::scalar>, E> smoothstep(const typename E::scalar &edge0, const typename E::scalar &edge1, const E &x)
+{
+	typedef typename E::scalar T;
+
+	const _gm_expr_smoothstep<T> op = { edge0, T(1) / (edge1 - edge0) };
+	return _gm_expr_result1<_gm_expr_smoothstep<T>, E>::make(op, x);
+}
+
+template<typename E> GM_EXPR_API inline _gm_expr_unary_t<_gm_expr_fract, E> fract(const E &x)
+{
+	return _gm_expr_result1<_gm_expr_fract, E>::make(_gm_expr_fract(), x);
+}
+
+
+template<typename A, typename B, typename C> GM_EXPR_API inline _gm_expr_ternary_t<_gm_expr_lerp, A, B, C> lerp(const A &from, const B &to, const C &t)
+{
+	return _gm_expr_result3<_gm_expr_lerp, A, B, C>::make(_gm_expr_lerp(), from, to, t);
+}
+
+
+#define _GM_EXPR_EASING(name) \
+	template<typename E> GM_EXPR_API inline _gm_expr_unary_t<easing::_gm_##name##_kernel, E> name(const E &time) \
+	{ \
+		return _gm_expr_result1<easing::_gm_##name##_kernel, E>::make(easing::_gm_##name##_kernel(), time); \
+	}
+
+_GM_EXPR_EASING(easeLinear)
+
+_GM_EXPR_EASING(easeInQuad)
+_GM_EXPR_EASING(easeOutQuad)
+_GM_EXPR_EASING(easeInOutQuad)
+
+_GM_EXPR_EASING(easeInCubic)
+_GM_EXPR_EASING(easeOutCubic)
+_GM_EXPR_EASING(easeInOutCubic)
+
+_GM_EXPR_EASING(easeInQuart)
+_GM_EXPR_EASING(easeOutQuart)
+_GM_EXPR_EASING(easeInOutQuart)
+
+_GM_EXPR_EASING(easeInQuint)
+_GM_EXPR_EASING(easeOutQuint)
+_GM_EXPR_EASING(easeInOutQuint)
+
+_GM_EXPR_EASING(easeInSine)
+_GM_EXPR_EASING(easeOutSine)
+_GM_EXPR_EASING(easeInOutSine)
+
+_GM_EXPR_EASING(easeInExpo)
+_GM_EXPR_EASING(easeOutExpo)
+_GM_EXPR_EASING(easeInOutExpo)
+
+_GM_EXPR_EASING(easeInCirc)
+_GM_EXPR_EASING(easeOutCirc)
+_GM_EXPR_EASING(easeInOutCirc)
+
+_GM_EXPR_EASING(easeInBack)
+_GM_EXPR_EASING(easeOutBack)
+_GM_EXPR_EASING(easeInOutBack)
+
+_GM_EXPR_EASING(easeInElastic)
+_GM_EXPR_EASING(easeOutElastic)
+_GM_EXPR_EASING(easeInOutElastic)
+
+_GM_EXPR_EASING(easeInBounce)
+_GM_EXPR_EASING(easeOutBounce)
+_GM_EXPR_EASING(easeInOutBounce)
+
+#undef _GM_EXPR_EASING
+
+
+template<typename F, typename E> GM_EXPR_API inline _gm_expr_unary_t<F, E> apply(const E &x, const F &f)
+{
+	return _gm_expr_result1<F, E>::make(f, x);
+}
+
+
+template<typename E> GM_EXPR_API void evaluate(const E &e, typename E::scalar *result)
+{
+	typedef typename E::V V;
+
+	// Evaluated with the same loop as the batch functions, which
+	// handles the head and tail with partial loads and stores
+	_gm_math_batch(result, e.size(), [=](size_t i, size_t n) -> V { return e(i, n); });
+}
+
+
+}
+
+#ifndef GM_NO_NAMESPACE
+}
+#endif
+
+
+#endif
@@ -0,0 +1,564 @@
+
+// Author: Christian Vallentin <mail@vallentinsource.com>
+// Website: http://vallentinsource.com
+// Repository: https://github.com/MrVallentin/GameMath
+//
+// Date Created: October 18, 2026
+// Last Modified: October 18, 2026
+
+// Copyright (c) 2012-2016 Christian Vallentin <mail@vallentinsource.com>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+
+// Refrain from using any exposed macros, functions
+// or structs prefixed with an underscore. As these
+// are only intended for internal purposes. Which
+// additionally means they can be removed, renamed
+// or changed between minor updates without notice.
+
+// This library contains a Q16.16 fixed-point number type, for results
+// which must be bit identical across machines (e.g. lockstep games).
+// All arithmetic and math functions only use integer operations.
+//
+// It can be used as T with the templates of the other libraries,
+// e.g. lerp(), smoothstep(), smoothDamp(), the easing curves and
+// blend(), as it's constructible from the literals they use (such
+// as T(0.5)), and sqrt(), sin(), cos(), pow(), exp2() and abs()
+// are found by argument-dependent lookup.
+
+#ifndef GM_FIXED_HPP
+#define GM_FIXED_HPP
+
+
+#ifndef GM_STRINGIFY_VERSION
+#	define _GM_STRINGIFY(str) #str
+#	define _GM_STRINGIFY_TOKEN(str) _GM_STRINGIFY(str)
+#	define GM_STRINGIFY_VERSION(major, minor, patch) _GM_STRINGIFY(major) "." _GM_STRINGIFY(minor) "." _GM_STRINGIFY(patch)
+#endif
+
+
+#define GM_FIXED_NAME "GameMath Fixed"
+
+#define GM_FIXED_VERSION_MAJOR 1
+#define GM_FIXED_VERSION_MINOR 0
+#define GM_FIXED_VERSION_PATCH 0
+
+#define GM_FIXED_VERSION GM_STRINGIFY_VERSION(GM_FIXED_VERSION_MAJOR, GM_FIXED_VERSION_MINOR, GM_FIXED_VERSION_PATCH)
+
+#define GM_FIXED_NAME_VERSION GM_FIXED_NAME " " GM_FIXED_VERSION
+
+
+#include <stdint.h>
+
+#include <type_traits>
+
+
+#define GM_FIXED_API static
+
+
+#ifndef GM_NO_NAMESPACE
+namespace gm {
+#endif
+
+
+// A signed Q16.16 fixed-point number, i.e. a 32-bit integer counting
+// 1/65536ths, with a range of [-32768;32768) and a resolution of
+// about 1.5E-5.
+//
+// Addition, subtraction and multiplication wrap around on overflow,
+// like integers. Division saturates, and dividing by 0 gives the max
+// (or min) value, or 0 for 0 / 0. Multiplication and division round
+// to the nearest value.
+//
+// Integers convert implicitly, while floats and doubles convert
+// explicitly (rounding to nearest, saturating outside of the range,
+// and NaN giving 0). Mixed arithmetic with floats and
+// doubles converts them first, i.e. constants like 1E-4f behave the
+// same on every machine.
+class fixed
+{
+public:
+	fixed() = default;
+
+	template<typename I, typename std::enable_if<std::is_integral<I>::value, int>::type = 0>
+	fixed(I i) : value(static_cast<int32_t>(static_cast<uint32_t>(i) << 16)) {}
+
+	explicit fixed(float f);
+	explicit fixed(double d);
+
+	static fixed fromRaw(int32_t raw);
+	int32_t raw() const;
+
+	// Converting to int truncates towards zero, like floats.
+	explicit operator int() const;
+	explicit operator float() const;
+	explicit operator double() const;
+
+	fixed& operator+=(const fixed &b);
+	fixed& operator-=(const fixed &b);
+	fixed& operator*=(const fixed &b);
+	fixed& operator/=(const fixed &b);
+
+	fixed& operator++();
+	fixed& operator--();
+	fixed operator++(int);
+	fixed operator--(int);
+
+	// The math functions are friends defined in the class, so they're
+	// only found by argument-dependent lookup. Declared in the
+	// namespace they would hide the math.h functions from the code of
+	// the other libraries, if this header is included before them.
+
+	friend fixed abs(const fixed &x) { return _abs(x); }
+
+	friend fixed floor(const fixed &x) { return _floor(x); }
+	friend fixed ceil(const fixed &x) { return _ceil(x); }
+	friend fixed round(const fixed &x) { return _round(x); }
+
+	// Deterministic versions of the math.h functions. The max error of
+	// sqrt() is 0.5 (of the last bit), of sin() and cos() 1, and of log2()
+	// 1 (the result is truncated). exp2() is within 1 for results below
+	// 2^12, above which its relative error of about 2^-28 exceeds the
+	// last bit, up to 3.3 near the max.
+	//
+	// pow(x, y) is exp2(y * log2(x)), where the error of log2() is scaled
+	// by y, i.e. the relative error is about ln(2) * (|y| + 1) * 2^-16.
+	// Only handles x >= 0.
+	//
+	// sin() and cos() are reduced by 2pi in 4.28 fixed-point, and then
+	// evaluated with a polynomial of degree 9. exp2() evaluates a
+	// polynomial for the fractional part and shifts by the integer
+	// part, saturating on overflow. log2() computes one bit at a time,
+	// by repeatedly squaring the mantissa. sqrt() is the digit-by-digit
+	// integer square root.
+	friend fixed sqrt(const fixed &x) { return _sqrt(x); }
+
+	friend fixed sin(const fixed &x) { return _sin(x); }
+	friend fixed cos(const fixed &x) { return _cos(x); }
+
+	friend fixed exp2(const fixed &x) { return _exp2(x); }
+	friend fixed log2(const fixed &x) { return _log2(x); }
+	friend fixed pow(const fixed &x, const fixed &y) { return _pow(x, y); }
+
+private:
+	static fixed _abs(const fixed &x);
+
+	static fixed _floor(const fixed &x);
+	static fixed _ceil(const fixed &x);
+	static fixed _round(const fixed &x);
+
+	static fixed _sqrt(const fixed &x);
+
+	static fixed _sin(const fixed &x);
+	static fixed _cos(const fixed &x);
+
+	static fixed _exp2(const fixed &x);
+	static fixed _log2(const fixed &x);
+	static fixed _pow(const fixed &x, const fixed &y);
+
+	int32_t value;
+};
+
+
+GM_FIXED_API fixed operator+(const fixed &a, const fixed &b);
+GM_FIXED_API fixed operator-(const fixed &a, const fixed &b);
+GM_FIXED_API fixed operator*(const fixed &a, const fixed &b);
+GM_FIXED_API fixed operator/(const fixed &a, const fixed &b);
+GM_FIXED_API fixed operator-(const fixed &a);
+
+GM_FIXED_API bool operator==(const fixed &a, const fixed &b);
+GM_FIXED_API bool operator!=(const fixed &a, const fixed &b);
+GM_FIXED_API bool operator<(const fixed &a, const fixed &b);
+GM_FIXED_API bool operator<=(const fixed &a, const fixed &b);
+GM_FIXED_API bool operator>(const fixed &a, const fixed &b);
+GM_FIXED_API bool operator>=(const fixed &a, const fixed &b);
+
+
+// After this point everything you'll see is all
+// the definitions to the prior declarations.
+
+
+#define _GM_FIXED_ONE 65536
+
+
+// Converting a value outside the range of int32_t is undefined,
+// hence the bounds are checked (in a way that NaN fails) first
+GM_FIXED_API inline int32_t _gm_fixed_round(double scaled)
+{
+	if (scaled >= 2147483647.0)
+		return INT32_MAX;
+
+	if (scaled <= -2147483648.0)
+		return INT32_MIN;
+
+	if (!(scaled == scaled))
+		return 0;
+
+	return static_cast<int32_t>((scaled >= 0.0) ? (scaled + 0.5) : (scaled - 0.5));
+}
+
+inline fixed::fixed(float f)
+	: value(_gm_fixed_round(static_cast<double>(f) * 65536.0))
+{
+}
+
+inline fixed::fixed(double d)
+	: value(_gm_fixed_round(d * 65536.0))
+{
+}
+
+
+inline fixed fixed::fromRaw(int32_t raw)
+{
+	fixed x;
+	x.value = raw;
+	return x;
+}
+
+inline int32_t fixed::raw() const
+{
+	return value;
+}
+
+
+inline fixed::operator int() const
+{
+	return static_cast<int>(value / _GM_FIXED_ONE);
+}
+
+inline fixed::operator float() const
+{
+	return static_cast<float>(value) * (1.0f / 65536.0f);
+}
+
+inline fixed::operator double() const
+{
+	return static_cast<double>(value) * (1.0 / 65536.0);
+}
+
+
+inline fixed& fixed::operator+=(const fixed &b)
+{
+	return (*this = *this + b);
+}
+
+inline fixed& fixed::operator-=(const fixed &b)
+{
+	return (*this = *this - b);
+}
+
+inline fixed& fixed::operator*=(const fixed &b)
+{
+	return (*this = *this * b);
+}
+
+inline fixed& fixed::operator/=(const fixed &b)
+{
+	return (*this = *this / b);
+}
+
+
+inline fixed& fixed::operator++()
+{
+	return (*this += fixed(1));
+}
+
+inline fixed& fixed::operator--()
+{
+	return (*this -= fixed(1));
+}
+
+inline fixed fixed::operator++(int)
+{
+	const fixed x = *this;
+	++*this;
+	return x;
+}
+
+inline fixed fixed::operator--(int)
+{
+	const fixed x = *this;
+	--*this;
+	return x;
+}
+
+
+// The arithmetic is done on unsigned integers, such
+// that overflow wraps around instead of being undefined.
+
+GM_FIXED_API inline fixed operator+(const fixed &a, const fixed &b)
+{
+	return fixed::fromRaw(static_cast<int32_t>(static_cast<uint32_t>(a.raw()) + static_cast<uint32_t>(b.raw())));
+}
+
+GM_FIXED_API inline fixed operator-(const fixed &a, const fixed &b)
+{
+	return fixed::fromRaw(static_cast<int32_t>(static_cast<uint32_t>(a.raw()) - static_cast<uint32_t>(b.raw())));
+}
+
+GM_FIXED_API inline fixed operator*(const fixed &a, const fixed &b)
+{
+	const int64_t product = static_cast<int64_t>(a.raw()) * static_cast<int64_t>(b.raw());
+	return fixed::fromRaw(static_cast<int32_t>(static_cast<uint64_t>((product + 0x8000) >> 16)));
+}
+
+GM_FIXED_API inline fixed operator/(const fixed &a, const fixed &b)
+{
+	if (b.raw() == 0)
+		return fixed::fromRaw((a.raw() > 0) ? INT32_MAX : ((a.raw() < 0) ? INT32_MIN : 0));
+
+	const int64_t numerator = static_cast<int64_t>(a.raw()) * _GM_FIXED_ONE;
+	const int64_t denominator = b.raw();
+
+	// Rounded to nearest, by adding half the denominator
+	// (with the sign of the quotient) before truncating
+	const int64_t half = ((numerator < 0) == (denominator < 0)) ? (((denominator < 0) ? -denominator : denominator) / 2) : -(((denominator < 0) ? -denominator : denominator) / 2);
+	const int64_t quotient = (numerator + ((denominator < 0) ? -half : half)) / denominator;
+
+	return fixed::fromRaw(static_cast<int32_t>((quotient > INT32_MAX) ? INT32_MAX : ((quotient < INT32_MIN) ? INT32_MIN : quotient)));
+}
+
+GM_FIXED_API inline fixed operator-(const fixed &a)
+{
+	return fixed::fromRaw(static_cast<int32_t>(0u - static_cast<uint32_t>(a.raw())));
+}
+
+
+// Mixed arithmetic and comparisons with floats and doubles (e.g. the
+// constants of _GM_EASING_DEQUAL()), as they would otherwise convert
+// to int first.
+
+template<typename F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0> GM_FIXED_API inline fixed operator+(const fixed &a, F b) { return a + fixed(b); }
+template<typename F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0> GM_FIXED_API inline fixed operator-(const fixed &a, F b) { return a - fixed(b); }
+template<typename F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0> GM_FIXED_API inline fixed operator*(const fixed &a, F b) { return a * fixed(b); }
+template<typename F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0> GM_FIXED_API inline fixed operator/(const fixed &a, F b) { return a / fixed(b); }
+
+template<typename F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0> GM_FIXED_API inline fixed operator+(F a, const fixed &b) { return fixed(a) + b; }
+template<typename F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0> GM_FIXED_API inline fixed operator-(F a, const fixed &b) { return fixed(a) - b; }
+template<typename F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0> GM_FIXED_API inline fixed operator*(F a, const fixed &b) { return fixed(a) * b; }
+template<typename F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0> GM_FIXED_API inline fixed operator/(F a, const fixed &b) { return fixed(a) / b; }
+
+template<typename F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0> GM_FIXED_API inline bool operator<(const fixed &a, F b) { return (a < fixed(b)); }
+template<typename F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0> GM_FIXED_API inline bool operator>(const fixed &a, F b) { return (a > fixed(b)); }
+template<typename F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0> GM_FIXED_API inline bool operator<(F a, const fixed &b) { return (fixed(a) < b); }
+template<typename F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0> GM_FIXED_API inline bool operator>(F a, const fixed &b) { return (fixed(a) > b); }
+
+
+GM_FIXED_API inline bool operator==(const fixed &a, const fixed &b) { return (a.raw() == b.raw()); }
+GM_FIXED_API inline bool operator!=(const fixed &a, const fixed &b) { return (a.raw() != b.raw()); }
+GM_FIXED_API inline bool operator<(const fixed &a, const fixed &b) { return (a.raw() < b.raw()); }
+GM_FIXED_API inline bool operator<=(const fixed &a, const fixed &b) { return (a.raw() <= b.raw()); }
+GM_FIXED_API inline bool operator>(const fixed &a, const fixed &b) { return (a.raw() > b.raw()); }
+GM_FIXED_API inline bool operator>=(const fixed &a, const fixed &b) { return (a.raw() >= b.raw()); }
+
+
+inline fixed fixed::_abs(const fixed &x)
+{
+	return (x.raw() < 0) ? -x : x;
+}
+
+
+// Clearing the fractional bits rounds towards
+// negative infinity, as the raw value is signed.
+
+inline fixed fixed::_floor(const fixed &x)
+{
+	return fixed::fromRaw(static_cast<int32_t>(static_cast<uint32_t>(x.raw()) & 0xFFFF0000u));
+}
+
+inline fixed fixed::_ceil(const fixed &x)
+{
+	return _floor(x + fromRaw(0xFFFF));
+}
+
+inline fixed fixed::_round(const fixed &x)
+{
+	return _floor(x + fromRaw(0x8000));
+}
+
+
+inline fixed fixed::_sqrt(const fixed &x)
+{
+	if (x.raw() <= 0)
+		return fixed(0);
+
+	// sqrt(x * 2^16) * 2^8 = sqrt(x * 2^32), i.e. the integer
+	// square root of x shifted by 16 is the Q16.16 result
+	uint64_t remainder = static_cast<uint64_t>(x.raw()) << 16;
+	uint64_t root = 0;
+	uint64_t bit = static_cast<uint64_t>(1) << 46;
+
+	while (bit > remainder)
+		bit >>= 2;
+
+	// Branchless, as the branch is taken about half the time
+	while (bit != 0)
+	{
+		const uint64_t trial = root + bit;
+		const uint64_t mask = static_cast<uint64_t>(0) - static_cast<uint64_t>(remainder >= trial);
+
+		remainder -= trial & mask;
+		root = (root >> 1) + (bit & mask);
+
+		bit >>= 2;
+	}
+
+	if (remainder > root)
+		++root;
+
+	return fixed::fromRaw(static_cast<int32_t>(root));
+}
+
+
+// The Taylor series of sin() in 4.28 fixed-point, for |x| <= pi/2,
+// where the error of the 9th degree is below the resolution of Q16.16.
+GM_FIXED_API inline int64_t _gm_fixed_sin28(int64_t x)
+{
+	const int64_t PI = 843314857; // pi * 2^28
+	const int64_t TWO_PI = 1686629713;
+
+	x %= TWO_PI;
+
+	if (x > PI)
+		x -= TWO_PI;
+	else if (x < -PI)
+		x += TWO_PI;
+
+	// sin(x) = sin(pi - x)
+	if (x > (PI / 2))
+		x = PI - x;
+	else if (x < -(PI / 2))
+		x = -PI - x;
+
+	const int64_t z = (x * x) >> 28;
+
+	int64_t p = 740;                    // 1 / 9!
+	p = ((p * z) >> 28) - 53261;        // 1 / 7!
+	p = ((p * z) >> 28) + 2236962;      // 1 / 5!
+	p = ((p * z) >> 28) - 44739243;     // 1 / 3!
+	p = (p * z) >> 28;
+
+	return x + ((x * p) >> 28);
+}
+
+inline fixed fixed::_sin(const fixed &x)
+{
+	return fixed::fromRaw(static_cast<int32_t>((_gm_fixed_sin28(static_cast<int64_t>(x.raw()) << 12) + 2048) >> 12));
+}
+
+inline fixed fixed::_cos(const fixed &x)
+{
+	const int64_t HALF_PI = 421657428; // pi / 2 * 2^28
+	return fixed::fromRaw(static_cast<int32_t>((_gm_fixed_sin28((static_cast<int64_t>(x.raw()) << 12) + HALF_PI) + 2048) >> 12));
+}
+
+
+inline fixed fixed::_exp2(const fixed &x)
+{
+	// x = n + f, where f is in [0;1)
+	const int32_t n = x.raw() >> 16;
+	const int64_t f = static_cast<int64_t>(x.raw() & 0xFFFF) << 14;
+
+	if (n >= 15)
+		return fixed::fromRaw(INT32_MAX);
+
+	if (n < -17)
+		return fixed(0);
+
+	// 2^f = e^(f * ln(2)), with the Taylor series of e^x in 2.30
+	// fixed-point, where a_k = ln(2)^k / k! * 2^30. The terms past
+	// a_10 are below the resolution. As 2^n is at most 2^14, the
+	// 30 bits of the fraction are enough for every result.
+	int64_t p = 8;                                      // a_10
+	p = ((p * f + (1 << 29)) >> 30) + 109;              // a_9
+	p = ((p * f + (1 << 29)) >> 30) + 1419;             // a_8
+	p = ((p * f + (1 << 29)) >> 30) + 16377;            // a_7
+	p = ((p * f + (1 << 29)) >> 30) + 165394;           // a_6
+	p = ((p * f + (1 << 29)) >> 30) + 1431680;          // a_5
+	p = ((p * f + (1 << 29)) >> 30) + 10327387;         // a_4
+	p = ((p * f + (1 << 29)) >> 30) + 59597083;         // a_3
+	p = ((p * f + (1 << 29)) >> 30) + 257941248;        // a_2
+	p = ((p * f + (1 << 29)) >> 30) + 744261118;        // a_1
+	p = ((p * f + (1 << 29)) >> 30) + 1073741824;       // a_0
+
+	// 2^n * p / 2^30 in Q16.16, where n <= 14
+	const int32_t shift = 14 - n;
+
+	if (shift > 0)
+		p = (p + (static_cast<int64_t>(1) << (shift - 1))) >> shift;
+
+	return fixed::fromRaw(static_cast<int32_t>((p > INT32_MAX) ? INT32_MAX : p));
+}
+
+inline fixed fixed::_log2(const fixed &x)
+{
+	if (x.raw() <= 0)
+		return fixed::fromRaw(INT32_MIN);
+
+	// x = 2^e * m, where m is in [1;2) in 2.30 fixed-point
+	int32_t e = 30;
+
+	while ((x.raw() >> e) == 0)
+		--e;
+
+	uint64_t m = static_cast<uint64_t>(x.raw()) << (30 - e);
+	int32_t result = (e - 16) * _GM_FIXED_ONE;
+
+	// log2(m^2) = 2 * log2(m), so when m^2 >= 2 the
+	// next bit of the fraction is set
+	for (int32_t bit = _GM_FIXED_ONE >> 1; bit != 0; bit >>= 1)
+	{
+		m = (m * m) >> 30;
+
+		if (m >= (static_cast<uint64_t>(2) << 30))
+		{
+			m >>= 1;
+			result += bit;
+		}
+	}
+
+	return fixed::fromRaw(result);
+}
+
+inline fixed fixed::_pow(const fixed &x, const fixed &y)
+{
+	if (y.raw() == 0)
+		return fixed(1);
+
+	if (x.raw() <= 0)
+		return fixed(0);
+
+	// y * log2(x) in 64-bit, saturated such that it can't wrap
+	// around, as exp2() saturates beyond either end anyway
+	const int64_t product = (static_cast<int64_t>(y.raw()) * static_cast<int64_t>(_log2(x).raw()) + 0x8000) >> 16;
+
+	return _exp2(fromRaw(static_cast<int32_t>((product > INT32_MAX) ? INT32_MAX : ((product < INT32_MIN) ? INT32_MIN : product))));
+}
+
+
+#undef _GM_FIXED_ONE
+
+
+#ifndef GM_NO_NAMESPACE
+}
+#endif
+
+
+#endif
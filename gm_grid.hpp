@@ -0,0 +1,454 @@
+
+// Author: Christian Vallentin <mail@vallentinsource.com>
+// Website: http://vallentinsource.com
+// Repository: https://github.com/MrVallentin/GameMath
+//
+// Date Created: October 18, 2026
+// Last Modified: October 18, 2026
+
+// Copyright (c) 2012-2016 Christian Vallentin <mail@vallentinsource.com>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+
+// Refrain from using any exposed macros, functions
+// or structs prefixed with an underscore. As these
+// are only intended for internal purposes. Which
+// additionally means they can be removed, renamed
+// or changed between minor updates without notice.
+
+// This library contains a 2D grid of floats (e.g. a heightmap or a
+// channel of a flow field), which is bilinearly sampled like bilerp().
+// The grid is stored in tiles of 8x8 cells, such that the 4 corners of
+// a sample are almost always within the same 256 bytes.
+
+#ifndef GM_GRID_HPP
+#define GM_GRID_HPP
+
+
+#ifndef GM_STRINGIFY_VERSION
+#	define _GM_STRINGIFY(str) #str
+#	define _GM_STRINGIFY_TOKEN(str) _GM_STRINGIFY(str)
+#	define GM_STRINGIFY_VERSION(major, minor, patch) _GM_STRINGIFY(major) "." _GM_STRINGIFY(minor) "." _GM_STRINGIFY(patch)
+#endif
+
+
+#define GM_GRID_NAME "GameMath Grid"
+
+#define GM_GRID_VERSION_MAJOR 1
+#define GM_GRID_VERSION_MINOR 0
+#define GM_GRID_VERSION_PATCH 0
+
+#define GM_GRID_VERSION GM_STRINGIFY_VERSION(GM_GRID_VERSION_MAJOR, GM_GRID_VERSION_MINOR, GM_GRID_VERSION_PATCH)
+
+#define GM_GRID_NAME_VERSION GM_GRID_NAME " " GM_GRID_VERSION
+
+
+#include <math.h>
+#include <stddef.h>
+
+#include <vector>
+
+#include "gm_math.hpp"
+#include "gm_simd.hpp"
+
+
+#define GM_GRID_API static
+
+
+#ifndef GM_NO_NAMESPACE
+namespace gm {
+#endif
+
+
+// How coordinates outside of the grid are mapped to cells.
+// - Clamp uses the nearest edge
+// - Wrap repeats the grid
+// - Mirror repeats the grid, flipping every other repetition
+enum class GridAddressing
+{
+	Clamp,
+	Wrap,
+	Mirror,
+};
+
+
+// A width x height grid of floats. Coordinates are in cells, i.e.
+// sampling at (x, y) gives get(x, y) for integral x and y, and
+// bilerp() of the 4 surrounding cells in between.
+//
+// The grid can be at most 2^24 cells wide and high (where floats
+// can represent every cell), and at most 2^31 cells in total.
+class Grid
+{
+public:
+	explicit Grid(size_t width = 0, size_t height = 0, GridAddressing addressing = GridAddressing::Clamp);
+
+	// Resizing sets every cell to 0.
+	void resize(size_t width, size_t height);
+
+	size_t width() const;
+	size_t height() const;
+
+	GridAddressing addressing() const;
+	void setAddressing(GridAddressing addressing);
+
+	float get(size_t x, size_t y) const;
+	void set(size_t x, size_t y, float value);
+
+	// Copies all cells from/to width * height row-major values.
+	void load(const float *data);
+	void store(float *data) const;
+
+	float sample(float x, float y) const;
+	void sample(const float *xs, const float *ys, float *result, size_t count) const;
+
+private:
+	size_t _offset(size_t x, size_t y) const;
+
+	simd::vint _column(const simd::vint &x) const;
+	simd::vint _row(const simd::vint &y) const;
+
+	template<GridAddressing A> simd::vfloat _sample(const simd::vfloat &x, const simd::vfloat &y) const;
+	template<GridAddressing A> void _sample(const float *xs, const float *ys, float *result, size_t count) const;
+
+	std::vector<float> values;
+
+	size_t columns;
+	size_t rows;
+	size_t tileColumns;
+
+	GridAddressing mode;
+};
+
+
+// After this point everything you'll see is all
+// the definitions to the prior declarations.
+
+
+// Tiles are 2^3 x 2^3 cells
+#define _GM_GRID_TILE_SHIFT 3
+#define _GM_GRID_TILE_SIZE (1 << _GM_GRID_TILE_SHIFT)
+#define _GM_GRID_TILE_MASK (_GM_GRID_TILE_SIZE - 1)
+
+
+// Maps the coordinate x of a dimension of size n to the
+// cells i0 and i1 (after addressing), and the weight t
+// of i1. i1 is the cell after i0, unless clamped. After
+// clamping or repeating x is never negative, such that
+// truncating it to an int floors it.
+
+GM_GRID_API inline float _gm_grid_repeat(float x, float period)
+{
+	x -= floorf(x / period) * period;
+
+	// Rounding can give a result of -0 or period
+	if (x < 0.0f) x += period;
+	if (x >= period) x -= period;
+
+	// While inf and NaN give NaN, which must not become an index
+	return ((x >= 0.0f) && (x < period)) ? x : 0.0f;
+}
+
+GM_GRID_API inline void _gm_grid_address(float x, int n, GridAddressing addressing, int *i0, int *i1, float *t)
+{
+	const float size = static_cast<float>(n);
+
+	switch (addressing)
+	{
+	case GridAddressing::Clamp:
+	{
+		x = (x > 0.0f) ? ((x < (size - 1.0f)) ? x : (size - 1.0f)) : 0.0f;
+
+		*i0 = static_cast<int>(x);
+		*t = x - static_cast<float>(*i0);
+		*i1 = ((*i0 + 1) < n) ? (*i0 + 1) : (n - 1);
+		break;
+	}
+	case GridAddressing::Wrap:
+	{
+		x = _gm_grid_repeat(x, size);
+
+		*i0 = static_cast<int>(x);
+		*t = x - static_cast<float>(*i0);
+		*i1 = ((*i0 + 1) < n) ? (*i0 + 1) : 0;
+		break;
+	}
+	case GridAddressing::Mirror:
+	{
+		const int period = n * 2;
+		x = _gm_grid_repeat(x, size * 2.0f);
+
+		const int a = static_cast<int>(x);
+		const int b = ((a + 1) < period) ? (a + 1) : 0;
+
+		*t = x - static_cast<float>(a);
+
+		*i0 = (a < n) ? a : (period - 1 - a);
+		*i1 = (b < n) ? b : (period - 1 - b);
+		break;
+	}
+	}
+}
+
+GM_GRID_API inline simd::vfloat _gm_grid_repeat(const simd::vfloat &x, float period)
+{
+	const simd::vfloat p(period);
+	const simd::vfloat zero(0.0f);
+
+	simd::vfloat r = x - simd::floor(x / p) * p;
+	r = simd::select(r < zero, r + p, r);
+	r = simd::select(r >= p, r - p, r);
+
+	return simd::select((r >= zero) & (r < p), r, zero);
+}
+
+// The vector version takes the addressing as a template
+// argument, such that the kernels don't branch on it
+template<GridAddressing A>
+GM_GRID_API inline void _gm_grid_address(const simd::vfloat &x, int n, simd::vint *i0, simd::vint *i1, simd::vfloat *t)
+{
+	const float size = static_cast<float>(n);
+	const simd::vint one(1);
+
+	switch (A)
+	{
+	case GridAddressing::Clamp:
+	{
+		const simd::vfloat c = simd::clamp(x, simd::vfloat(0.0f), simd::vfloat(size - 1.0f));
+
+		*i0 = simd::toInt(c);
+		*t = c - simd::toFloat(*i0);
+		*i1 = simd::min(*i0 + one, simd::vint(n - 1));
+		break;
+	}
+	case GridAddressing::Wrap:
+	{
+		const simd::vfloat r = _gm_grid_repeat(x, size);
+
+		*i0 = simd::toInt(r);
+		*t = r - simd::toFloat(*i0);
+		*i1 = *i0 + one;
+		*i1 = simd::select(*i1 == simd::vint(n), simd::vint(0), *i1);
+		break;
+	}
+	case GridAddressing::Mirror:
+	{
+		const simd::vint period(n * 2);
+		const simd::vint last(n - 1);
+
+		const simd::vfloat r = _gm_grid_repeat(x, size * 2.0f);
+		const simd::vint a = simd::toInt(r);
+		const simd::vint b = simd::select((a + one) == period, simd::vint(0), a + one);
+
+		*t = r - simd::toFloat(a);
+
+		*i0 = simd::select(a > last, period - one - a, a);
+		*i1 = simd::select(b > last, period - one - b, b);
+		break;
+	}
+	}
+}
+
+
+inline Grid::Grid(size_t width, size_t height, GridAddressing addressing)
+	: columns(0)
+	, rows(0)
+	, tileColumns(0)
+	, mode(addressing)
+{
+	resize(width, height);
+}
+
+
+inline void Grid::resize(size_t width, size_t height)
+{
+	const size_t tileRows = (height + _GM_GRID_TILE_MASK) >> _GM_GRID_TILE_SHIFT;
+
+	columns = width;
+	rows = height;
+	tileColumns = (width + _GM_GRID_TILE_MASK) >> _GM_GRID_TILE_SHIFT;
+
+	values.assign(tileColumns * tileRows * _GM_GRID_TILE_SIZE * _GM_GRID_TILE_SIZE, 0.0f);
+}
+
+
+inline size_t Grid::width() const
+{
+	return columns;
+}
+
+inline size_t Grid::height() const
+{
+	return rows;
+}
+
+
+inline GridAddressing Grid::addressing() const
+{
+	return mode;
+}
+
+inline void Grid::setAddressing(GridAddressing addressing)
+{
+	mode = addressing;
+}
+
+
+inline float Grid::get(size_t x, size_t y) const
+{
+	return values[_offset(x, y)];
+}
+
+inline void Grid::set(size_t x, size_t y, float value)
+{
+	values[_offset(x, y)] = value;
+}
+
+
+inline void Grid::load(const float *data)
+{
+	for (size_t y = 0; y < rows; ++y)
+		for (size_t x = 0; x < columns; ++x)
+			values[_offset(x, y)] = data[y * columns + x];
+}
+
+inline void Grid::store(float *data) const
+{
+	for (size_t y = 0; y < rows; ++y)
+		for (size_t x = 0; x < columns; ++x)
+			data[y * columns + x] = values[_offset(x, y)];
+}
+
+
+// The tiles are stored row by row, and the cells within a tile row
+// by row. The offset of a cell is the sum of a part that depends only
+// on x and a part that depends only on y, such that the kernels only
+// compute 2 of each for the 4 corners.
+inline size_t Grid::_offset(size_t x, size_t y) const
+{
+	const size_t column = ((x >> _GM_GRID_TILE_SHIFT) << (_GM_GRID_TILE_SHIFT * 2)) + (x & _GM_GRID_TILE_MASK);
+	const size_t row = (((y >> _GM_GRID_TILE_SHIFT) * tileColumns) << (_GM_GRID_TILE_SHIFT * 2)) + ((y & _GM_GRID_TILE_MASK) << _GM_GRID_TILE_SHIFT);
+
+	return column + row;
+}
+
+inline simd::vint Grid::_column(const simd::vint &x) const
+{
+	return simd::sll<_GM_GRID_TILE_SHIFT * 2>(simd::srl<_GM_GRID_TILE_SHIFT>(x)) + (x & simd::vint(_GM_GRID_TILE_MASK));
+}
+
+inline simd::vint Grid::_row(const simd::vint &y) const
+{
+	const simd::vint tileRow = simd::srl<_GM_GRID_TILE_SHIFT>(y) * simd::vint(static_cast<int>(tileColumns));
+	return simd::sll<_GM_GRID_TILE_SHIFT * 2>(tileRow) + simd::sll<_GM_GRID_TILE_SHIFT>(y & simd::vint(_GM_GRID_TILE_MASK));
+}
+
+
+inline float Grid::sample(float x, float y) const
+{
+	if (values.empty())
+		return 0.0f;
+
+	int x0 = 0, x1 = 0, y0 = 0, y1 = 0;
+	float u = 0.0f, v = 0.0f;
+
+	_gm_grid_address(x, static_cast<int>(columns), mode, &x0, &x1, &u);
+	_gm_grid_address(y, static_cast<int>(rows), mode, &y0, &y1, &v);
+
+	return bilerp<float>(get(x0, y0), get(x1, y0), get(x0, y1), get(x1, y1), u, v);
+}
+
+
+// The same as the kernel of the batch bilerp(), with
+// the corners gathered from the tiles
+template<GridAddressing A>
+inline simd::vfloat Grid::_sample(const simd::vfloat &x, const simd::vfloat &y) const
+{
+	simd::vint x0(0), x1(0), y0(0), y1(0);
+	simd::vfloat u(0.0f), v(0.0f);
+
+	_gm_grid_address<A>(x, static_cast<int>(columns), &x0, &x1, &u);
+	_gm_grid_address<A>(y, static_cast<int>(rows), &y0, &y1, &v);
+
+	const float *base = values.data();
+
+	const simd::vfloat iu = simd::vfloat(1.0f) - u;
+	const simd::vfloat iv = simd::vfloat(1.0f) - v;
+
+	const simd::vint c0 = _column(x0), c1 = _column(x1);
+	const simd::vint r0 = _row(y0), r1 = _row(y1);
+
+	simd::vfloat r = simd::gather(base, c0 + r0) * (iu * iv);
+	r = simd::fmadd(simd::gather(base, c1 + r0), u * iv, r);
+	r = simd::fmadd(simd::gather(base, c0 + r1), v * iu, r);
+	return simd::fmadd(simd::gather(base, c1 + r1), u * v, r);
+}
+
+
+inline void Grid::sample(const float *xs, const float *ys, float *result, size_t count) const
+{
+	if (values.empty())
+	{
+		for (size_t i = 0; i < count; ++i)
+			result[i] = 0.0f;
+
+		return;
+	}
+
+	switch (mode)
+	{
+	case GridAddressing::Clamp:
+		_sample<GridAddressing::Clamp>(xs, ys, result, count);
+		break;
+	case GridAddressing::Wrap:
+		_sample<GridAddressing::Wrap>(xs, ys, result, count);
+		break;
+	case GridAddressing::Mirror:
+		_sample<GridAddressing::Mirror>(xs, ys, result, count);
+		break;
+	}
+}
+
+
+template<GridAddressing A>
+inline void Grid::_sample(const float *xs, const float *ys, float *result, size_t count) const
+{
+	typedef simd::vfloat V;
+
+	const Grid *grid = this;
+
+	_gm_math_batch(result, count, [=](size_t i, size_t n) -> V
+	{
+		return grid->template _sample<A>(_gm_math_load<V>(xs + i, n), _gm_math_load<V>(ys + i, n));
+	});
+}
+
+
+#undef _GM_GRID_TILE_SHIFT
+#undef _GM_GRID_TILE_SIZE
+#undef _GM_GRID_TILE_MASK
+
+
+#ifndef GM_NO_NAMESPACE
+}
+#endif
+
+
+#endif
@@ -0,0 +1,766 @@
+
+// Author: Christian Vallentin <mail@vallentinsource.com>
+// Website: http://vallentinsource.com
+// Repository: https://github.com/MrVallentin/GameMath
+//
+// Date Created: October 18, 2026
+// Last Modified: October 18, 2026
+
+// Copyright (c) 2012-2016 Christian Vallentin <mail@vallentinsource.com>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+
+// Refrain from using any exposed macros, functions
+// or structs prefixed with an underscore. As these
+// are only intended for internal purposes. Which
+// additionally means they can be removed, renamed
+// or changed between minor updates without notice.
+
+// This library streams images through the gm_color batch
+// functions in fixed size chunks, such that images of any size
+// can be converted with a bounded amount of memory.
+//
+// Supported formats are raw RGBA8, and binary PPM (P6) and PGM
+// (P5) with a maxval of at most 255.
+
+#ifndef GM_IMAGESTREAM_HPP
+#define GM_IMAGESTREAM_HPP
+
+
+#ifndef GM_STRINGIFY_VERSION
+#	define _GM_STRINGIFY(str) #str
+#	define _GM_STRINGIFY_TOKEN(str) _GM_STRINGIFY(str)
+#	define GM_STRINGIFY_VERSION(major, minor, patch) _GM_STRINGIFY(major) "." _GM_STRINGIFY(minor) "." _GM_STRINGIFY(patch)
+#endif
+
+
+#define GM_IMAGESTREAM_NAME "GameMath Image Stream"
+
+#define GM_IMAGESTREAM_VERSION_MAJOR 1
+#define GM_IMAGESTREAM_VERSION_MINOR 0
+#define GM_IMAGESTREAM_VERSION_PATCH 0
+
+#define GM_IMAGESTREAM_VERSION GM_STRINGIFY_VERSION(GM_IMAGESTREAM_VERSION_MAJOR, GM_IMAGESTREAM_VERSION_MINOR, GM_IMAGESTREAM_VERSION_PATCH)
+
+#define GM_IMAGESTREAM_NAME_VERSION GM_IMAGESTREAM_NAME " " GM_IMAGESTREAM_VERSION
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gm_color.hpp"
+
+
+#define GM_IMAGESTREAM_API static
+
+
+#ifndef GM_NO_NAMESPACE
+namespace gm {
+#endif
+
+
+enum class ImageFormat
+{
+	// 4 bytes per pixel (R, G, B, A) without a header,
+	// thereby the size must be given when reading.
+	RawRGBA8,
+	// Binary (P6) and (P5) Netpbm images
+	PPM,
+	PGM,
+};
+
+
+// Reads an image chunk by chunk, decoding every pixel to RGBA8.
+// PPM pixels get an alpha of 255, PGM pixels are replicated to
+// R, G and B.
+class ImageReader
+{
+public:
+	ImageReader();
+	~ImageReader();
+
+	ImageReader(const ImageReader&) = delete;
+	ImageReader& operator=(const ImageReader&) = delete;
+
+	// The width and height are only used (and required) by RawRGBA8,
+	// PPM and PGM read them from the header. The FILE* version reads
+	// from the current position, and doesn't close the file.
+	bool open(const char *path, ImageFormat format, size_t width = 0, size_t height = 0);
+	bool open(FILE *file, ImageFormat format, size_t width = 0, size_t height = 0);
+	void close();
+
+	size_t width() const;
+	size_t height() const;
+
+	// The number of pixels not yet read.
+	size_t remaining() const;
+
+	// Reads up to count pixels into rgba (4 * count bytes), and
+	// returns the number of pixels read. Returns 0 at the end of
+	// the image, or if the file is truncated (see failed()).
+	size_t read(unsigned char *rgba, size_t count);
+
+	bool failed() const;
+
+private:
+	bool _readHeader();
+
+	FILE *file;
+	bool ownsFile;
+	bool error;
+
+	ImageFormat format;
+	size_t w, h;
+	size_t left;
+	int maxval;
+
+	std::vector<unsigned char> buffer;
+};
+
+
+// Writes an image chunk by chunk, encoding RGBA8 pixels. PPM drops
+// the alpha, PGM stores the Rec. 709 luma given by grayscale().
+class ImageWriter
+{
+public:
+	ImageWriter();
+	~ImageWriter();
+
+	ImageWriter(const ImageWriter&) = delete;
+	ImageWriter& operator=(const ImageWriter&) = delete;
+
+	bool open(const char *path, ImageFormat format, size_t width, size_t height);
+	bool open(FILE *file, ImageFormat format, size_t width, size_t height);
+	bool close();
+
+	bool write(const unsigned char *rgba, size_t count);
+
+	bool failed() const;
+
+private:
+	FILE *file;
+	bool ownsFile;
+	bool error;
+
+	ImageFormat format;
+
+	std::vector<unsigned char> buffer;
+};
+
+
+// Called with every chunk of RGBA8 pixels, in order, before it's
+// written. To use a ColorPipeline, note that RGBA8 in memory is
+// ChannelOrder::ABGR on little-endian machines.
+typedef std::function<void(unsigned char *rgba, size_t count)> ImageTransform;
+
+
+struct ImageStreamStats
+{
+	size_t pixels;
+	size_t chunks;
+
+	// The bytes allocated for the chunks, which is the
+	// peak memory used by convertImage() on top of stdio.
+	size_t bufferBytes;
+
+	double seconds;
+};
+
+
+// Converts an image from one format to another, optionally passing
+// every chunk through transform. Reading, transforming (on the
+// calling thread) and writing run concurrently, with 3 chunks in
+// flight, sized such that all buffers fit in memoryBudget bytes.
+// Thereby the memory used is independent of the size of the image.
+//
+// Returns false if the input can't be read, is truncated, or the
+// output can't be written, in which case it stops at the first
+// chunk that fails to write.
+//
+// If transform throws, nothing more is read or written, and the
+// exception is rethrown once the other threads have finished.
+GM_IMAGESTREAM_API bool convertImage(
+	const char *srcPath, ImageFormat srcFormat,
+	const char *dstPath, ImageFormat dstFormat,
+	const ImageTransform &transform = nullptr,
+	size_t rawWidth = 0, size_t rawHeight = 0,
+	size_t memoryBudget = 16 * 1024 * 1024,
+	ImageStreamStats *stats = nullptr);
+
+GM_IMAGESTREAM_API bool convertImage(
+	ImageReader &reader, ImageWriter &writer,
+	const ImageTransform &transform = nullptr,
+	size_t memoryBudget = 16 * 1024 * 1024,
+	ImageStreamStats *stats = nullptr);
+
+
+// After this point everything you'll see is all
+// the definitions to the prior declarations.
+
+
+GM_IMAGESTREAM_API inline size_t _gm_bytes_per_pixel(ImageFormat format)
+{
+	switch (format)
+	{
+	case ImageFormat::RawRGBA8: return 4;
+	case ImageFormat::PPM: return 3;
+	case ImageFormat::PGM: return 1;
+	}
+
+	return 4;
+}
+
+// The number of pixels ImageWriter encodes at a time
+static const size_t _GM_IMAGESTREAM_BLOCK_SIZE = 64 * 1024;
+
+
+inline ImageReader::ImageReader()
+	: file(nullptr)
+	, ownsFile(false)
+	, error(false)
+	, format(ImageFormat::RawRGBA8)
+	, w(0)
+	, h(0)
+	, left(0)
+	, maxval(255)
+{}
+
+inline ImageReader::~ImageReader()
+{
+	close();
+}
+
+
+inline bool ImageReader::open(const char *path, ImageFormat format, size_t width, size_t height)
+{
+	FILE *file = fopen(path, "rb");
+
+	if (!file)
+		return false;
+
+	if (!open(file, format, width, height))
+	{
+		fclose(file);
+		return false;
+	}
+
+	ownsFile = true;
+
+	return true;
+}
+
+inline bool ImageReader::open(FILE *file, ImageFormat format, size_t width, size_t height)
+{
+	close();
+
+	this->file = file;
+	this->ownsFile = false;
+	this->error = false;
+	this->format = format;
+	this->w = width;
+	this->h = height;
+	this->maxval = 255;
+
+	if ((format != ImageFormat::RawRGBA8) && !_readHeader())
+	{
+		this->file = nullptr;
+		return false;
+	}
+
+	// Rejects images whose pixel count (or byte count) doesn't fit in a size_t
+	if ((w == 0) || (h == 0) || (h > (SIZE_MAX / 4 / w)))
+	{
+		this->file = nullptr;
+		return false;
+	}
+
+	left = w * h;
+
+	return true;
+}
+
+inline void ImageReader::close()
+{
+	if (file && ownsFile)
+		fclose(file);
+
+	file = nullptr;
+	ownsFile = false;
+	left = 0;
+}
+
+
+inline size_t ImageReader::width() const
+{
+	return w;
+}
+
+inline size_t ImageReader::height() const
+{
+	return h;
+}
+
+inline size_t ImageReader::remaining() const
+{
+	return left;
+}
+
+inline bool ImageReader::failed() const
+{
+	return error;
+}
+
+
+inline bool ImageReader::_readHeader()
+{
+	// P6/P5, followed by the width, height and maxval separated by
+	// whitespace (and comments), and a single whitespace character
+	if ((fgetc(file) != 'P') || (fgetc(file) != ((format == ImageFormat::PPM) ? '6' : '5')))
+		return false;
+
+	size_t values[3];
+
+	for (int i = 0; i < 3; ++i)
+	{
+		int c = fgetc(file);
+
+		for (;;)
+		{
+			if (c == '#')
+				while ((c != '\n') && (c != EOF))
+					c = fgetc(file);
+			else if ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'))
+				c = fgetc(file);
+			else
+				break;
+		}
+
+		if ((c < '0') || (c > '9'))
+			return false;
+
+		values[i] = 0;
+
+		for (; (c >= '0') && (c <= '9'); c = fgetc(file))
+		{
+			if (values[i] > ((SIZE_MAX - 9) / 10))
+				return false;
+
+			values[i] = values[i] * 10 + static_cast<size_t>(c - '0');
+		}
+
+		if ((c != ' ') && (c != '\t') && (c != '\r') && (c != '\n'))
+			return false;
+	}
+
+	if ((values[2] == 0) || (values[2] > 255))
+		return false;
+
+	w = values[0];
+	h = values[1];
+	maxval = static_cast<int>(values[2]);
+
+	return true;
+}
+
+
+inline size_t ImageReader::read(unsigned char *rgba, size_t count)
+{
+	if (!file || error)
+		return 0;
+
+	if (count > left)
+		count = left;
+
+	if (count == 0)
+		return 0;
+
+	const size_t bpp = _gm_bytes_per_pixel(format);
+
+	if (format == ImageFormat::RawRGBA8)
+	{
+		count = fread(rgba, bpp, count, file);
+	}
+	else
+	{
+		// Decode in place, from the back, as the
+		// decoded pixels are larger than the encoded
+		count = fread(rgba, bpp, count, file);
+
+		for (size_t i = count; i-- > 0;)
+		{
+			const unsigned char *src = rgba + i * bpp;
+			unsigned char *dst = rgba + i * 4;
+
+			const unsigned char r = src[0];
+			const unsigned char g = (bpp == 3) ? src[1] : src[0];
+			const unsigned char b = (bpp == 3) ? src[2] : src[0];
+
+			dst[0] = r;
+			dst[1] = g;
+			dst[2] = b;
+			dst[3] = 255;
+		}
+
+		if (maxval != 255)
+			for (size_t i = 0; i < count * 4; ++i)
+				if ((i & 3) != 3)
+					rgba[i] = static_cast<unsigned char>(((rgba[i] > maxval) ? 255 : ((rgba[i] * 255 + maxval / 2) / maxval)));
+	}
+
+	left -= count;
+
+	if ((count == 0) && (left > 0))
+		error = true;
+
+	return count;
+}
+
+
+inline ImageWriter::ImageWriter()
+	: file(nullptr)
+	, ownsFile(false)
+	, error(false)
+	, format(ImageFormat::RawRGBA8)
+{}
+
+inline ImageWriter::~ImageWriter()
+{
+	close();
+}
+
+
+inline bool ImageWriter::open(const char *path, ImageFormat format, size_t width, size_t height)
+{
+	FILE *file = fopen(path, "wb");
+
+	if (!file)
+		return false;
+
+	if (!open(file, format, width, height))
+	{
+		fclose(file);
+		return false;
+	}
+
+	ownsFile = true;
+
+	return true;
+}
+
+inline bool ImageWriter::open(FILE *file, ImageFormat format, size_t width, size_t height)
+{
+	close();
+
+	this->file = file;
+	this->ownsFile = false;
+	this->error = false;
+	this->format = format;
+
+	if (format != ImageFormat::RawRGBA8)
+	{
+		const int written = fprintf(file, "P%c\n%zu %zu\n255\n", (format == ImageFormat::PPM) ? '6' : '5', width, height);
+
+		if (written < 0)
+		{
+			this->file = nullptr;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+inline bool ImageWriter::close()
+{
+	if (file)
+	{
+		if (fflush(file) != 0)
+			error = true;
+
+		if (ownsFile && (fclose(file) != 0))
+			error = true;
+	}
+
+	file = nullptr;
+	ownsFile = false;
+
+	return !error;
+}
+
+inline bool ImageWriter::failed() const
+{
+	return error;
+}
+
+
+inline bool ImageWriter::write(const unsigned char *rgba, size_t count)
+{
+	if (!file || error)
+		return false;
+
+	const size_t bpp = _gm_bytes_per_pixel(format);
+
+	if (format == ImageFormat::RawRGBA8)
+	{
+		error = (fwrite(rgba, bpp, count, file) != count);
+		return !error;
+	}
+
+	// Encode in blocks, such that the buffer has a fixed size
+	const size_t blockSize = _GM_IMAGESTREAM_BLOCK_SIZE;
+
+	buffer.resize(blockSize * bpp);
+
+	for (size_t first = 0; (first < count) && !error; first += blockSize)
+	{
+		const size_t n = ((count - first) < blockSize) ? (count - first) : blockSize;
+		const unsigned char *src = rgba + first * 4;
+
+		if (format == ImageFormat::PGM)
+		{
+			grayscale(src, buffer.data(), n, 4, LumaWeights::Rec709);
+		}
+		else
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				buffer[i * 3 + 0] = src[i * 4 + 0];
+				buffer[i * 3 + 1] = src[i * 4 + 1];
+				buffer[i * 3 + 2] = src[i * 4 + 2];
+			}
+		}
+
+		error = (fwrite(buffer.data(), bpp, n, file) != n);
+	}
+
+	return !error;
+}
+
+
+// A minimal blocking queue of chunk indices, where
+// _GM_IMAGESTREAM_END marks the end of the stream
+static const size_t _GM_IMAGESTREAM_END = static_cast<size_t>(-1);
+
+struct _gm_chunk_queue
+{
+	std::mutex mutex;
+	std::condition_variable ready;
+	std::deque<size_t> items;
+
+	void push(size_t item)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			items.push_back(item);
+		}
+
+		ready.notify_one();
+	}
+
+	size_t pop()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		ready.wait(lock, [this]() { return !items.empty(); });
+
+		const size_t item = items.front();
+		items.pop_front();
+
+		return item;
+	}
+};
+
+
+GM_IMAGESTREAM_API inline bool convertImage(
+	ImageReader &reader, ImageWriter &writer,
+	const ImageTransform &transform,
+	size_t memoryBudget,
+	ImageStreamStats *stats)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	const Clock::time_point start = Clock::now();
+
+	const size_t CHUNK_COUNT = 3;
+
+	// The chunks hold 4 bytes per pixel, on top of the
+	// writer's encoding buffer of (at most) 3 bytes per pixel
+	const size_t encodeBytes = _GM_IMAGESTREAM_BLOCK_SIZE * 3;
+
+	size_t chunkSize = (memoryBudget > encodeBytes) ? ((memoryBudget - encodeBytes) / (CHUNK_COUNT * 4)) : 0;
+
+	if (chunkSize < 1024)
+		chunkSize = 1024;
+
+	if (chunkSize > reader.remaining())
+		chunkSize = (reader.remaining() > 0) ? reader.remaining() : 1;
+
+	std::vector<unsigned char> chunks[CHUNK_COUNT];
+	size_t counts[CHUNK_COUNT] = {};
+
+	for (size_t i = 0; i < CHUNK_COUNT; ++i)
+		chunks[i].resize(chunkSize * 4);
+
+	_gm_chunk_queue freeChunks, readChunks, convertedChunks;
+
+	for (size_t i = 0; i < CHUNK_COUNT; ++i)
+		freeChunks.push(i);
+
+	size_t chunkCount = 0;
+
+	// Cleared by the writing thread on the first error, after which
+	// nothing more is read or transformed
+	std::atomic<bool> written(true);
+
+	// Set when transform throws, after which nothing more is read,
+	// and the chunks go straight back to the reading thread
+	std::atomic<bool> cancelled(false);
+	std::exception_ptr exception;
+
+	std::thread reading([&]()
+	{
+		for (;;)
+		{
+			const size_t chunk = freeChunks.pop();
+
+			if (chunk == _GM_IMAGESTREAM_END)
+				break;
+
+			counts[chunk] = (written && !cancelled) ? reader.read(chunks[chunk].data(), chunkSize) : 0;
+
+			if (counts[chunk] == 0)
+			{
+				readChunks.push(_GM_IMAGESTREAM_END);
+				break;
+			}
+
+			readChunks.push(chunk);
+		}
+	});
+
+	std::thread writing([&]()
+	{
+		for (;;)
+		{
+			const size_t chunk = convertedChunks.pop();
+
+			if (chunk == _GM_IMAGESTREAM_END)
+				break;
+
+			// Keep draining after an error, such that the other threads finish
+			if (written && !writer.write(chunks[chunk].data(), counts[chunk]))
+				written = false;
+
+			freeChunks.push(chunk);
+		}
+	});
+
+	for (;;)
+	{
+		const size_t chunk = readChunks.pop();
+
+		if (chunk == _GM_IMAGESTREAM_END)
+			break;
+
+		if (transform && written && !cancelled)
+		{
+			// The threads must be joined before leaving, thereby
+			// the exception is only rethrown after the loop
+			try
+			{
+				transform(chunks[chunk].data(), counts[chunk]);
+			}
+			catch (...)
+			{
+				exception = std::current_exception();
+				cancelled = true;
+			}
+		}
+
+		if (cancelled)
+		{
+			freeChunks.push(chunk);
+			continue;
+		}
+
+		++chunkCount;
+		convertedChunks.push(chunk);
+	}
+
+	convertedChunks.push(_GM_IMAGESTREAM_END);
+
+	reading.join();
+	writing.join();
+
+	if (exception)
+		std::rethrow_exception(exception);
+
+	if (stats)
+	{
+		stats->pixels = reader.width() * reader.height() - reader.remaining();
+		stats->chunks = chunkCount;
+		stats->bufferBytes = CHUNK_COUNT * chunkSize * 4 + encodeBytes;
+		stats->seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	return written && !reader.failed() && (reader.remaining() == 0);
+}
+
+
+GM_IMAGESTREAM_API inline bool convertImage(
+	const char *srcPath, ImageFormat srcFormat,
+	const char *dstPath, ImageFormat dstFormat,
+	const ImageTransform &transform,
+	size_t rawWidth, size_t rawHeight,
+	size_t memoryBudget,
+	ImageStreamStats *stats)
+{
+	ImageReader reader;
+
+	if (!reader.open(srcPath, srcFormat, rawWidth, rawHeight))
+		return false;
+
+	ImageWriter writer;
+
+	if (!writer.open(dstPath, dstFormat, reader.width(), reader.height()))
+		return false;
+
+	const bool converted = convertImage(reader, writer, transform, memoryBudget, stats);
+
+	return writer.close() && converted;
+}
+
+
+#ifndef GM_NO_NAMESPACE
+}
+#endif
+
+
+#endif
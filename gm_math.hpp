@@ -4,7 +4,7 @@
 // Repository: https://github.com/MrVallentin/GameMath
 //
 // Date Created: September 24, 2012
-// Last Modified: July 23, 2016
+// Last Modified: October 18, 2026
 
 // Copyright (c) 2012-2016 Christian Vallentin <mail@vallentinsource.com>
 //
@@ -47,7 +47,7 @@
 #define GM_MATH_NAME "GameMath Math"
 
 #define GM_MATH_VERSION_MAJOR 1
-#define GM_MATH_VERSION_MINOR 0
+#define GM_MATH_VERSION_MINOR 1
 #define GM_MATH_VERSION_PATCH 0
 
 #define GM_MATH_VERSION GM_STRINGIFY_VERSION(GM_MATH_VERSION_MAJOR, GM_MATH_VERSION_MINOR, GM_MATH_VERSION_PATCH)
@@ -56,6 +56,13 @@
 
 
 #include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "gm_parallel.hpp"
+#include "gm_simd.hpp"
 
 
 #define GM_PI 3.1415926535897932
@@ -96,6 +103,10 @@ template<typename T> GM_MATH_API T degrees(const T &radians);
 template<typename T> GM_MATH_API T abs(const T &x);
 
 
+// The float and double versions use the rounding functions of
+// math.h (a single instruction with SSE4.1), rather than converting
+// to int, such that they're correct for the whole range. round()
+// rounds halfway cases away from zero.
 template<typename T> GM_MATH_API T ceil(const T &x);
 template<typename T> GM_MATH_API T floor(const T &x);
 template<typename T> GM_MATH_API T round(const T &x);
@@ -112,6 +123,24 @@ template<typename T> GM_MATH_API T nearestFloor(const T &n, const T &x);
 template<typename T> GM_MATH_API T fract(const T &x);
 
 
+// Batch versions of the above for float and double arrays, using
+// the rounding instructions of gm_simd.hpp. result can be the same
+// array as x.
+template<typename T> GM_MATH_API void ceil(const T *x, T *result, size_t count);
+template<typename T> GM_MATH_API void floor(const T *x, T *result, size_t count);
+template<typename T> GM_MATH_API void round(const T *x, T *result, size_t count);
+
+template<typename T> GM_MATH_API void fract(const T *x, T *result, size_t count);
+
+// Snaps every n to a multiple of x, i.e. a grid with a cell size
+// of x. Given cells, the index of the cell (the multiple of x) is
+// written as well, saturated to the range of int (and 0 for NaN).
+// Either result (as a T*) or cells can be null.
+template<typename T> GM_MATH_API void nearest(const T *n, const T &x, T *result, size_t count, int *cells = nullptr);
+template<typename T> GM_MATH_API void nearestCeil(const T *n, const T &x, T *result, size_t count, int *cells = nullptr);
+template<typename T> GM_MATH_API void nearestFloor(const T *n, const T &x, T *result, size_t count, int *cells = nullptr);
+
+
 // Returns the maximum/minimum value. If a and b
 // equal then a is returned.
 template<typename T> GM_MATH_API T max(const T &a, const T &b);
@@ -151,9 +180,101 @@ template<typename T> GM_MATH_API T smoothstep(const T &edge0, const T &edge1, co
 template<typename T> GM_MATH_API T bilerp(const T &p00, const T &p10, const T &p01, const T &p11, const T &u, const T &v);
 
 
+// Batch versions of the above for float and double arrays, which
+// evaluate a whole vector of elements at a time (see gm_simd.hpp).
+// Parameters given as scalars apply to every element, and result
+// can be the same array as any of the inputs.
+//
+// The stores are aligned by evaluating the first few elements on
+// their own, so arrays aligned to GM_SIMD_ALIGNMENT (or at least
+// sharing their misalignment) are the fastest. map(), normalize()
+// and smoothstep() multiply by the reciprocal of the range, so the
+// results can differ from the scalar versions in the last bit.
+template<typename T> GM_MATH_API void lerp(const T *from, const T *to, const T *t, T *result, size_t count);
+template<typename T> GM_MATH_API void lerp(const T &from, const T &to, const T *t, T *result, size_t count);
+
+template<typename T> GM_MATH_API void map(const T *value, const T &min1, const T &max1, const T &min2, const T &max2, T *result, size_t count);
+
+template<typename T> GM_MATH_API void normalize(const T &from, const T &to, const T *value, T *result, size_t count);
+
+template<typename T> GM_MATH_API void clamp(const T *x, const T &min, const T &max, T *result, size_t count);
+
+template<typename T> GM_MATH_API void smoothstep(const T &edge0, const T &edge1, const T *x, T *result, size_t count);
+
+template<typename T> GM_MATH_API void bilerp(const T *p00, const T *p10, const T *p01, const T *p11, const T *u, const T *v, T *result, size_t count);
+
+
 // Critically Damped Spring
 template<typename T> GM_MATH_API T smoothDamp(const T &current, const T &target, T &velocity, const T &timeStep, const T &springiness = T(5));
 
+// Same spring as smoothDamp(), but stepped using the closed-form
+// solution instead of a semi-implicit Euler step. Thereby it's exact
+// for any timeStep, and never overshoots or becomes unstable when the
+// timeStep is large compared to springiness.
+template<typename T> GM_MATH_API T smoothDampExact(const T &current, const T &target, T &velocity, const T &timeStep, const T &springiness = T(5));
+
+
+// Steps many float springs at once, as with smoothDamp(). The springs
+// are stored as a struct of arrays (current, target, velocity,
+// springiness and its square root), such that sqrt(springiness) is
+// only computed when the springiness changes.
+//
+// Springs are addressed by index. remove() moves the last spring
+// into the index of the removed one, like most swap-and-pop
+// containers.
+class SpringSystem
+{
+public:
+	// Systems with more than parallelThreshold springs are
+	// split across the threads of the pool given to step().
+	explicit SpringSystem(size_t parallelThreshold = 4096);
+
+	size_t add(float current, float target, float springiness = 5.0f, float velocity = 0.0f);
+	void remove(size_t index);
+
+	void reserve(size_t capacity);
+	void clear();
+
+	size_t size() const;
+
+	float current(size_t index) const;
+	float target(size_t index) const;
+	float velocity(size_t index) const;
+	float springiness(size_t index) const;
+
+	void setCurrent(size_t index, float current);
+	void setTarget(size_t index, float target);
+	void setVelocity(size_t index, float velocity);
+	void setSpringiness(size_t index, float springiness);
+
+	// The arrays of all springs, e.g. for retargeting all of them.
+	const float* currents() const;
+	const float* velocities() const;
+	float* targets();
+
+	size_t parallelThreshold() const;
+	void setParallelThreshold(size_t parallelThreshold);
+
+	// step() gives the same results as calling smoothDamp() for every
+	// spring. stepExact() matches smoothDampExact() to within float
+	// rounding, as its exp() is evaluated with simd::exp2().
+	void step(float timeStep, ThreadPool &pool = defaultThreadPool());
+	void stepExact(float timeStep, ThreadPool &pool = defaultThreadPool());
+
+private:
+	template<typename Kernel> void _step(ThreadPool &pool, const Kernel &kernel);
+
+	std::vector<float> currentValues;
+	std::vector<float> targetValues;
+	std::vector<float> velocityValues;
+	std::vector<float> springinessValues;
+
+	// sqrt(springiness), i.e. the angular frequency
+	std::vector<float> omegas;
+
+	size_t threshold;
+};
+
 
 // All angles are in radins.
 // - rho = distance from origin O to point P (i.e. the length of OP)
@@ -167,6 +288,15 @@ template<typename T> GM_MATH_API void cartesianToSpherical(const T &x, const T &
 // - theta = angle between X-axis and OP projected onto XZ plane
 template<typename T> GM_MATH_API void sphericalToCartesian(const T &rho, const T &phi, const T &theta, T &x, T &y, T &z);
 
+// Batch versions of the above for float and double arrays (a struct
+// of arrays, one per coordinate). The trigonometric functions are the
+// vectorized ones of gm_simd.hpp, with the given accuracy, and both
+// sin() and cos() of an angle are computed together. phi is computed
+// as atan2(y, sqrt(x^2 + z^2)), which equals asin(y / rho), but is 0
+// rather than NaN for the origin.
+template<typename T> GM_MATH_API void cartesianToSpherical(const T *x, const T *y, const T *z, T *rho, T *phi, T *theta, size_t count, simd::Accuracy accuracy = simd::Accuracy::Precise);
+template<typename T> GM_MATH_API void sphericalToCartesian(const T *rho, const T *phi, const T *theta, T *x, T *y, T *z, size_t count, simd::Accuracy accuracy = simd::Accuracy::Precise);
+
 
 // Determines whether the two values (a and b) are
 // close enough together that they can be considered equal.
@@ -193,12 +323,12 @@ template<typename T> GM_MATH_API T root(const T &x, const T &n);
 // the definitions to the prior declarations.
 
 
-template<> GM_MATH_API inline double rad(const double &degrees)
+template<> inline double rad(const double &degrees)
 {
 	return (degrees * 3.1415926535897932 / 180.0);
 }
 
-template<> GM_MATH_API inline float rad(const float &degrees)
+template<> inline float rad(const float &degrees)
 {
 	return (degrees * 3.1415926535897932f / 180.0f);
 }
@@ -209,12 +339,12 @@ template<typename T> GM_MATH_API inline T rad(const T &degrees)
 }
 
 
-template<> GM_MATH_API inline double radians(const double &degrees)
+template<> inline double radians(const double &degrees)
 {
 	return (degrees * 3.1415926535897932 / 180.0);
 }
 
-template<> GM_MATH_API inline float radians(const float &degrees)
+template<> inline float radians(const float &degrees)
 {
 	return (degrees * 3.1415926535897932f / 180.0f);
 }
@@ -225,12 +355,12 @@ template<typename T> GM_MATH_API inline T radians(const T &degrees)
 }
 
 
-template<> GM_MATH_API inline double deg(const double &radians)
+template<> inline double deg(const double &radians)
 {
 	return (radians * 180.0 / 3.1415926535897932);
 }
 
-template<> GM_MATH_API inline float deg(const float &radians)
+template<> inline float deg(const float &radians)
 {
 	return (radians * 180.0f / 3.1415926535897932f);
 }
@@ -241,12 +371,12 @@ template<typename T> GM_MATH_API inline T deg(const T &radians)
 }
 
 
-template<> GM_MATH_API inline double degrees(const double &radians)
+template<> inline double degrees(const double &radians)
 {
 	return (radians * 180.0 / 3.1415926535897932);
 }
 
-template<> GM_MATH_API inline float degrees(const float &radians)
+template<> inline float degrees(const float &radians)
 {
 	return (radians * 180.0f / 3.1415926535897932f);
 }
@@ -278,6 +408,14 @@ template<typename T> GM_MATH_API inline T round(const T &x)
 	return (((x - static_cast<int>(x)) >= T(0.5)) ? ceil<T>(x) : floor<T>(x));
 }
 
+template<> inline float ceil(const float &x) { return ::ceilf(x); }
+template<> inline float floor(const float &x) { return ::floorf(x); }
+template<> inline float round(const float &x) { return ::roundf(x); }
+
+template<> inline double ceil(const double &x) { return ::ceil(x); }
+template<> inline double floor(const double &x) { return ::floor(x); }
+template<> inline double round(const double &x) { return ::round(x); }
+
 
 template<typename T> GM_MATH_API inline T nearest(const T &n, const T &x)
 {
@@ -395,7 +533,279 @@ template<typename T> GM_MATH_API inline T bilerp(const T &p00, const T &p10, con
 }
 
 
-template<typename T> GM_MATH_API T smoothDamp(const T &current, const T &target, T &velocity, const T &timeStep, const T &springiness)
+// Calls kernel(i, count) for every vector of result, where count
+// is the number of elements (V::width, except for the head and the
+// tail). The head is evaluated on its own, until result is aligned.
+// The kernel is taken by value, as otherwise the compiler reloads
+// the captured pointers after every store to result.
+template<typename T, typename Kernel> GM_MATH_API void _gm_math_batch(T *result, size_t count, Kernel kernel)
+{
+	typedef typename simd::vector<T>::type V;
+
+	const size_t width = V::width;
+	const size_t misalignment = static_cast<size_t>(reinterpret_cast<uintptr_t>(result) % GM_SIMD_ALIGNMENT);
+
+	size_t i = 0;
+
+	if ((width > 1) && (misalignment != 0) && ((misalignment % sizeof(T)) == 0))
+	{
+		i = (GM_SIMD_ALIGNMENT - misalignment) / sizeof(T);
+
+		if (i > count)
+			i = count;
+
+		simd::storePartial(kernel(static_cast<size_t>(0), i), result, i);
+	}
+
+	if ((reinterpret_cast<uintptr_t>(result + i) % GM_SIMD_ALIGNMENT) == 0)
+	{
+		for (; (i + width) <= count; i += width)
+			kernel(i, width).store(result + i);
+	}
+	else
+	{
+		for (; (i + width) <= count; i += width)
+			kernel(i, width).storeu(result + i);
+	}
+
+	if (i < count)
+		simd::storePartial(kernel(i, count - i), result + i, count - i);
+}
+
+// Loads a whole vector when count is V::width, which is a
+// constant in the loop of _gm_math_batch() once inlined.
+template<typename V> GM_MATH_API inline V _gm_math_load(const typename V::scalar *p, size_t count)
+{
+	return (count == V::width) ? V::loadu(p) : simd::loadPartial<V>(p, count);
+}
+
+
+template<typename T> GM_MATH_API void lerp(const T *from, const T *to, const T *t, T *result, size_t count)
+{
+	typedef typename simd::vector<T>::type V;
+
+	_gm_math_batch(result, count, [=](size_t i, size_t n) -> V
+	{
+		const V x = _gm_math_load<V>(t + i, n);
+		return simd::fmadd(x, _gm_math_load<V>(to + i, n), (V(T(1)) - x) * _gm_math_load<V>(from + i, n));
+	});
+}
+
+template<typename T> GM_MATH_API void lerp(const T &from, const T &to, const T *t, T *result, size_t count)
+{
+	typedef typename simd::vector<T>::type V;
+
+	const V a(from), b(to);
+
+	_gm_math_batch(result, count, [=](size_t i, size_t n) -> V
+	{
+		const V x = _gm_math_load<V>(t + i, n);
+		return simd::fmadd(x, b, (V(T(1)) - x) * a);
+	});
+}
+
+
+template<typename T> GM_MATH_API void map(const T *value, const T &min1, const T &max1, const T &min2, const T &max2, T *result, size_t count)
+{
+	typedef typename simd::vector<T>::type V;
+
+	const V offset(min1), scale((max2 - min2) / (max1 - min1)), base(min2);
+
+	_gm_math_batch(result, count, [=](size_t i, size_t n) -> V
+	{
+		return simd::fmadd(_gm_math_load<V>(value + i, n) - offset, scale, base);
+	});
+}
+
+
+template<typename T> GM_MATH_API void normalize(const T &from, const T &to, const T *value, T *result, size_t count)
+{
+	typedef typename simd::vector<T>::type V;
+
+	const V offset(from), scale(T(1) / (to - from));
+
+	_gm_math_batch(result, count, [=](size_t i, size_t n) -> V
+	{
+		return (_gm_math_load<V>(value + i, n) - offset) * scale;
+	});
+}
+
+
+template<typename T> GM_MATH_API void clamp(const T *x, const T &min, const T &max, T *result, size_t count)
+{
+	typedef typename simd::vector<T>::type V;
+
+	const V lower(min), upper(max);
+
+	_gm_math_batch(result, count, [=](size_t i, size_t n) -> V
+	{
+		return simd::clamp(_gm_math_load<V>(x + i, n), lower, upper);
+	});
+}
+
+
+template<typename T> GM_MATH_API void smoothstep(const T &edge0, const T &edge1, const T *x, T *result, size_t count)
+{
+	typedef typename simd::vector<T>::type V;
+
+	const V offset(edge0), scale(T(1) / (edge1 - edge0));
+
+	_gm_math_batch(result, count, [=](size_t i, size_t n) -> V
+	{
+		const V t = simd::clamp((_gm_math_load<V>(x + i, n) - offset) * scale, V(T(0)), V(T(1)));
+		return t * t * (V(T(3)) - V(T(2)) * t);
+	});
+}
+
+
+template<typename T> GM_MATH_API void bilerp(const T *p00, const T *p10, const T *p01, const T *p11, const T *u, const T *v, T *result, size_t count)
+{
+	typedef typename simd::vector<T>::type V;
+
+	_gm_math_batch(result, count, [=](size_t i, size_t n) -> V
+	{
+		const V x = _gm_math_load<V>(u + i, n);
+		const V y = _gm_math_load<V>(v + i, n);
+		const V ix = V(T(1)) - x;
+		const V iy = V(T(1)) - y;
+
+		V r = _gm_math_load<V>(p00 + i, n) * (ix * iy);
+		r = simd::fmadd(_gm_math_load<V>(p10 + i, n), x * iy, r);
+		r = simd::fmadd(_gm_math_load<V>(p01 + i, n), y * ix, r);
+		return simd::fmadd(_gm_math_load<V>(p11 + i, n), x * y, r);
+	});
+}
+
+
+// simd::round() rounds halfway cases to even, while
+// round() rounds them away from zero
+template<typename V> GM_MATH_API inline V _gm_math_round(const V &x)
+{
+	typedef typename V::scalar T;
+
+	const V t = simd::trunc(x);
+	const V away = simd::select(x < V(T(0)), t - V(T(1)), t + V(T(1)));
+
+	return simd::select(simd::abs(x - t) >= V(T(0.5)), away, t);
+}
+
+GM_MATH_API inline void _gm_math_store_cells(const simd::vfloat &q, int *cells, size_t count)
+{
+	// NaN is replaced before converting, as converting it is undefined
+	const simd::vfloat n = simd::select(q == q, q, simd::vfloat(0.0f));
+
+	// 2147483520 is the largest float below 2^31, which can't
+	// represent the upper limit of int itself
+	const simd::vint clamped = simd::toInt(simd::clamp(n, simd::vfloat(-2147483648.0f), simd::vfloat(2147483520.0f)));
+	const simd::vint c = simd::select(n >= simd::vfloat(2147483648.0f), simd::vint(2147483647), clamped);
+
+	if (count == simd::vint::width)
+		c.storeu(cells);
+	else
+		simd::storePartial(c, cells, count);
+}
+
+GM_MATH_API inline void _gm_math_store_cells(const simd::vdouble &q, int *cells, size_t count)
+{
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) double lanes[simd::vdouble::width];
+	q.store(lanes);
+
+	// Saturated by hand, as converting NaN or values
+	// outside the range of int is undefined
+	for (size_t i = 0; i < count; ++i)
+	{
+		const double x = lanes[i];
+
+		if (x >= 2147483647.0)
+			cells[i] = 2147483647;
+		else if (x <= -2147483648.0)
+			cells[i] = (-2147483647 - 1);
+		else
+			cells[i] = (x == x) ? static_cast<int>(x) : 0;
+	}
+}
+
+template<typename T, typename Round> GM_MATH_API void _gm_math_snap(const T *n, const T &x, T *result, size_t count, int *cells, const Round &round)
+{
+	typedef typename simd::vector<T>::type V;
+
+	const size_t width = V::width;
+	const V step(x);
+
+	for (size_t i = 0; i < count; i += width)
+	{
+		const size_t m = ((count - i) < width) ? (count - i) : width;
+
+		// Divided rather than multiplied by the reciprocal,
+		// to snap the same as the scalar versions
+		const V q = round(_gm_math_load<V>(n + i, m) / step);
+
+		if (result)
+		{
+			if (m == width)
+				(q * step).storeu(result + i);
+			else
+				simd::storePartial(q * step, result + i, m);
+		}
+
+		if (cells)
+			_gm_math_store_cells(q, cells + i, m);
+	}
+}
+
+struct _gm_math_ceil_kernel { template<typename V> V operator()(const V &x) const { return simd::ceil(x); } };
+struct _gm_math_floor_kernel { template<typename V> V operator()(const V &x) const { return simd::floor(x); } };
+struct _gm_math_round_kernel { template<typename V> V operator()(const V &x) const { return _gm_math_round(x); } };
+
+
+template<typename T> GM_MATH_API void ceil(const T *x, T *result, size_t count)
+{
+	typedef typename simd::vector<T>::type V;
+	_gm_math_batch(result, count, [=](size_t i, size_t n) -> V { return simd::ceil(_gm_math_load<V>(x + i, n)); });
+}
+
+template<typename T> GM_MATH_API void floor(const T *x, T *result, size_t count)
+{
+	typedef typename simd::vector<T>::type V;
+	_gm_math_batch(result, count, [=](size_t i, size_t n) -> V { return simd::floor(_gm_math_load<V>(x + i, n)); });
+}
+
+template<typename T> GM_MATH_API void round(const T *x, T *result, size_t count)
+{
+	typedef typename simd::vector<T>::type V;
+	_gm_math_batch(result, count, [=](size_t i, size_t n) -> V { return _gm_math_round(_gm_math_load<V>(x + i, n)); });
+}
+
+
+template<typename T> GM_MATH_API void fract(const T *x, T *result, size_t count)
+{
+	typedef typename simd::vector<T>::type V;
+
+	_gm_math_batch(result, count, [=](size_t i, size_t n) -> V
+	{
+		const V v = _gm_math_load<V>(x + i, n);
+		return v - simd::floor(v);
+	});
+}
+
+
+template<typename T> GM_MATH_API void nearest(const T *n, const T &x, T *result, size_t count, int *cells)
+{
+	_gm_math_snap(n, x, result, count, cells, _gm_math_round_kernel());
+}
+
+template<typename T> GM_MATH_API void nearestCeil(const T *n, const T &x, T *result, size_t count, int *cells)
+{
+	_gm_math_snap(n, x, result, count, cells, _gm_math_ceil_kernel());
+}
+
+template<typename T> GM_MATH_API void nearestFloor(const T *n, const T &x, T *result, size_t count, int *cells)
+{
+	_gm_math_snap(n, x, result, count, cells, _gm_math_floor_kernel());
+}
+
+
+template<typename T> GM_MATH_API inline T smoothDamp(const T &current, const T &target, T &velocity, const T &timeStep, const T &springiness)
 {
 	const T delta = target - current;
 	const T springForce = delta * springiness;
@@ -409,6 +819,225 @@ template<typename T> GM_MATH_API T smoothDamp(const T &current, const T &target,
 	return current + displacement;
 }
 
+template<typename T> GM_MATH_API T smoothDampExact(const T &current, const T &target, T &velocity, const T &timeStep, const T &springiness)
+{
+	// With x = current - target and w = sqrt(springiness), the
+	// solution of x'' = -w^2 x - 2w x' is x(t) = (x0 + c t) e^(-w t),
+	// where c = v0 + w x0
+	const T omega = sqrt(springiness);
+	const T delta = current - target;
+	const T c = velocity + omega * delta;
+	const T decay = exp(-omega * timeStep);
+
+	velocity = (velocity - omega * c * timeStep) * decay;
+
+	return target + (delta + c * timeStep) * decay;
+}
+
+
+// The springs are stepped in ranges of whole cache lines
+#define _GM_SPRING_BLOCK 16
+
+
+inline SpringSystem::SpringSystem(size_t parallelThreshold)
+	: threshold(parallelThreshold)
+{
+}
+
+
+inline size_t SpringSystem::add(float current, float target, float springiness, float velocity)
+{
+	currentValues.push_back(current);
+	targetValues.push_back(target);
+	velocityValues.push_back(velocity);
+	springinessValues.push_back(springiness);
+	omegas.push_back(sqrtf(springiness));
+
+	return currentValues.size() - 1;
+}
+
+inline void SpringSystem::remove(size_t index)
+{
+	const size_t last = currentValues.size() - 1;
+
+	currentValues[index] = currentValues[last];
+	targetValues[index] = targetValues[last];
+	velocityValues[index] = velocityValues[last];
+	springinessValues[index] = springinessValues[last];
+	omegas[index] = omegas[last];
+
+	currentValues.pop_back();
+	targetValues.pop_back();
+	velocityValues.pop_back();
+	springinessValues.pop_back();
+	omegas.pop_back();
+}
+
+
+inline void SpringSystem::reserve(size_t capacity)
+{
+	currentValues.reserve(capacity);
+	targetValues.reserve(capacity);
+	velocityValues.reserve(capacity);
+	springinessValues.reserve(capacity);
+	omegas.reserve(capacity);
+}
+
+inline void SpringSystem::clear()
+{
+	currentValues.clear();
+	targetValues.clear();
+	velocityValues.clear();
+	springinessValues.clear();
+	omegas.clear();
+}
+
+
+inline size_t SpringSystem::size() const
+{
+	return currentValues.size();
+}
+
+
+inline float SpringSystem::current(size_t index) const { return currentValues[index]; }
+inline float SpringSystem::target(size_t index) const { return targetValues[index]; }
+inline float SpringSystem::velocity(size_t index) const { return velocityValues[index]; }
+inline float SpringSystem::springiness(size_t index) const { return springinessValues[index]; }
+
+inline void SpringSystem::setCurrent(size_t index, float current) { currentValues[index] = current; }
+inline void SpringSystem::setTarget(size_t index, float target) { targetValues[index] = target; }
+inline void SpringSystem::setVelocity(size_t index, float velocity) { velocityValues[index] = velocity; }
+
+inline void SpringSystem::setSpringiness(size_t index, float springiness)
+{
+	springinessValues[index] = springiness;
+	omegas[index] = sqrtf(springiness);
+}
+
+
+inline const float* SpringSystem::currents() const { return currentValues.data(); }
+inline const float* SpringSystem::velocities() const { return velocityValues.data(); }
+inline float* SpringSystem::targets() { return targetValues.data(); }
+
+
+inline size_t SpringSystem::parallelThreshold() const
+{
+	return threshold;
+}
+
+inline void SpringSystem::setParallelThreshold(size_t parallelThreshold)
+{
+	threshold = parallelThreshold;
+}
+
+
+// Calls kernel(current, target, velocity, springiness, omega) for
+// every vector of springs, which updates current and velocity.
+template<typename Kernel> inline void SpringSystem::_step(ThreadPool &pool, const Kernel &kernel)
+{
+	const size_t count = currentValues.size();
+	const size_t blocks = (count + _GM_SPRING_BLOCK - 1) / _GM_SPRING_BLOCK;
+	const size_t grain = (threshold > _GM_SPRING_BLOCK) ? (threshold / _GM_SPRING_BLOCK) : 1;
+
+	float *currentData = currentValues.data();
+	float *velocityData = velocityValues.data();
+	const float *targetData = targetValues.data();
+	const float *springinessData = springinessValues.data();
+	const float *omegaData = omegas.data();
+
+	parallelFor(pool, blocks, grain, [=, &kernel](size_t firstBlock, size_t lastBlock)
+	{
+		typedef simd::vfloat V;
+		const size_t width = V::width;
+
+		const size_t first = firstBlock * _GM_SPRING_BLOCK;
+		const size_t last = ((lastBlock * _GM_SPRING_BLOCK) < count) ? (lastBlock * _GM_SPRING_BLOCK) : count;
+
+		size_t i = first;
+
+		for (; (i + width) <= last; i += width)
+		{
+			V current = V::loadu(currentData + i);
+			V velocity = V::loadu(velocityData + i);
+
+			kernel(current, V::loadu(targetData + i), velocity, V::loadu(springinessData + i), V::loadu(omegaData + i));
+
+			current.storeu(currentData + i);
+			velocity.storeu(velocityData + i);
+		}
+
+		if (i < last)
+		{
+			const size_t n = last - i;
+
+			V current = simd::loadPartial<V>(currentData + i, n);
+			V velocity = simd::loadPartial<V>(velocityData + i, n);
+
+			kernel(current, simd::loadPartial<V>(targetData + i, n), velocity, simd::loadPartial<V>(springinessData + i, n), simd::loadPartial<V>(omegaData + i, n));
+
+			simd::storePartial(current, currentData + i, n);
+			simd::storePartial(velocity, velocityData + i, n);
+		}
+	});
+}
+
+
+struct _gm_spring_kernel
+{
+	simd::vfloat timeStep;
+
+	void operator()(simd::vfloat &current, const simd::vfloat &target, simd::vfloat &velocity, const simd::vfloat &springiness, const simd::vfloat &omega) const
+	{
+		typedef simd::vfloat V;
+
+		// Same operations as smoothDamp(), with 2 * sqrt(springiness)
+		// taken from omega (multiplying by 2 is exact either way)
+		const V force = (target - current) * springiness + -velocity * V(2.0f) * omega;
+
+		velocity = velocity + force * timeStep;
+		current = current + velocity * timeStep;
+	}
+};
+
+struct _gm_spring_exact_kernel
+{
+	simd::vfloat timeStep;
+
+	void operator()(simd::vfloat &current, const simd::vfloat &target, simd::vfloat &velocity, const simd::vfloat&, const simd::vfloat &omega) const
+	{
+		typedef simd::vfloat V;
+
+		const V delta = current - target;
+		const V c = velocity + omega * delta;
+
+		// e^x = 2^(x * log2(e))
+		const V decay = simd::exp2(-omega * timeStep * V(1.4426950408889634f));
+
+		velocity = (velocity - omega * c * timeStep) * decay;
+		current = target + (delta + c * timeStep) * decay;
+	}
+};
+
+
+inline void SpringSystem::step(float timeStep, ThreadPool &pool)
+{
+	_gm_spring_kernel kernel;
+	kernel.timeStep = simd::vfloat(timeStep);
+
+	_step(pool, kernel);
+}
+
+inline void SpringSystem::stepExact(float timeStep, ThreadPool &pool)
+{
+	_gm_spring_exact_kernel kernel;
+	kernel.timeStep = simd::vfloat(timeStep);
+
+	_step(pool, kernel);
+}
+
+
+#undef _GM_SPRING_BLOCK
+
 
 template<typename T> GM_MATH_API void cartesianToSpherical(const T &x, const T &y, const T &z, T &rho, T &phi, T &theta)
 {
@@ -419,9 +1048,106 @@ template<typename T> GM_MATH_API void cartesianToSpherical(const T &x, const T &
 
 template<typename T> GM_MATH_API void sphericalToCartesian(const T &rho, const T &phi, const T &theta, T &x, T &y, T &z)
 {
-	x = rho * cos(phi) * cos(theta);
+	const T r = rho * cos(phi);
+
+	x = r * cos(theta);
 	y = rho * sin(phi);
-	z = rho * cos(phi) * sin(theta);
+	z = r * sin(theta);
+}
+
+
+// Calls kernel(in0, in1, in2, &out0, &out1, &out2) for every vector
+// of three input and three output arrays.
+template<typename T, typename Kernel> GM_MATH_API void _gm_math_batch3(const T *in0, const T *in1, const T *in2, T *out0, T *out1, T *out2, size_t count, Kernel kernel)
+{
+	typedef typename simd::vector<T>::type V;
+
+	const size_t width = V::width;
+
+	size_t i = 0;
+
+	for (; (i + width) <= count; i += width)
+	{
+		V a, b, c;
+		kernel(V::loadu(in0 + i), V::loadu(in1 + i), V::loadu(in2 + i), &a, &b, &c);
+
+		a.storeu(out0 + i);
+		b.storeu(out1 + i);
+		c.storeu(out2 + i);
+	}
+
+	if (i < count)
+	{
+		const size_t n = count - i;
+
+		V a, b, c;
+		kernel(simd::loadPartial<V>(in0 + i, n), simd::loadPartial<V>(in1 + i, n), simd::loadPartial<V>(in2 + i, n), &a, &b, &c);
+
+		simd::storePartial(a, out0 + i, n);
+		simd::storePartial(b, out1 + i, n);
+		simd::storePartial(c, out2 + i, n);
+	}
+}
+
+template<simd::Accuracy accuracy> struct _gm_cartesian_to_spherical_kernel
+{
+	template<typename V> void operator()(const V &x, const V &y, const V &z, V *rho, V *phi, V *theta) const
+	{
+		const V xz = x * x + z * z;
+
+		*rho = simd::sqrt(xz + y * y);
+		*phi = simd::atan2<accuracy>(y, simd::sqrt(xz));
+		*theta = simd::atan2<accuracy>(z, x);
+	}
+};
+
+template<simd::Accuracy accuracy> struct _gm_spherical_to_cartesian_kernel
+{
+	template<typename V> void operator()(const V &rho, const V &phi, const V &theta, V *x, V *y, V *z) const
+	{
+		V sinPhi, cosPhi, sinTheta, cosTheta;
+
+		simd::sincos<accuracy>(phi, &sinPhi, &cosPhi);
+		simd::sincos<accuracy>(theta, &sinTheta, &cosTheta);
+
+		const V r = rho * cosPhi;
+
+		*x = r * cosTheta;
+		*y = rho * sinPhi;
+		*z = r * sinTheta;
+	}
+};
+
+template<typename T> GM_MATH_API void cartesianToSpherical(const T *x, const T *y, const T *z, T *rho, T *phi, T *theta, size_t count, simd::Accuracy accuracy)
+{
+	switch (accuracy)
+	{
+	case simd::Accuracy::Precise:
+		_gm_math_batch3(x, y, z, rho, phi, theta, count, _gm_cartesian_to_spherical_kernel<simd::Accuracy::Precise>());
+		break;
+	case simd::Accuracy::Medium:
+		_gm_math_batch3(x, y, z, rho, phi, theta, count, _gm_cartesian_to_spherical_kernel<simd::Accuracy::Medium>());
+		break;
+	case simd::Accuracy::Fast:
+		_gm_math_batch3(x, y, z, rho, phi, theta, count, _gm_cartesian_to_spherical_kernel<simd::Accuracy::Fast>());
+		break;
+	}
+}
+
+template<typename T> GM_MATH_API void sphericalToCartesian(const T *rho, const T *phi, const T *theta, T *x, T *y, T *z, size_t count, simd::Accuracy accuracy)
+{
+	switch (accuracy)
+	{
+	case simd::Accuracy::Precise:
+		_gm_math_batch3(rho, phi, theta, x, y, z, count, _gm_spherical_to_cartesian_kernel<simd::Accuracy::Precise>());
+		break;
+	case simd::Accuracy::Medium:
+		_gm_math_batch3(rho, phi, theta, x, y, z, count, _gm_spherical_to_cartesian_kernel<simd::Accuracy::Medium>());
+		break;
+	case simd::Accuracy::Fast:
+		_gm_math_batch3(rho, phi, theta, x, y, z, count, _gm_spherical_to_cartesian_kernel<simd::Accuracy::Fast>());
+		break;
+	}
 }
 
 
@@ -0,0 +1,349 @@
+
+// Author: Christian Vallentin <mail@vallentinsource.com>
+// Website: http://vallentinsource.com
+// Repository: https://github.com/MrVallentin/GameMath
+//
+// Date Created: October 18, 2026
+// Last Modified: October 18, 2026
+
+// Copyright (c) 2012-2016 Christian Vallentin <mail@vallentinsource.com>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+
+// Refrain from using any exposed macros, functions
+// or structs prefixed with an underscore. As these
+// are only intended for internal purposes. Which
+// additionally means they can be removed, renamed
+// or changed between minor updates without notice.
+
+// This library contains a minimal thread pool, used by
+// the multi-threaded functions of the other libraries.
+
+#ifndef GM_PARALLEL_HPP
+#define GM_PARALLEL_HPP
+
+
+#ifndef GM_STRINGIFY_VERSION
+#	define _GM_STRINGIFY(str) #str
+#	define _GM_STRINGIFY_TOKEN(str) _GM_STRINGIFY(str)
+#	define GM_STRINGIFY_VERSION(major, minor, patch) _GM_STRINGIFY(major) "." _GM_STRINGIFY(minor) "." _GM_STRINGIFY(patch)
+#endif
+
+
+#define GM_PARALLEL_NAME "GameMath Parallel"
+
+#define GM_PARALLEL_VERSION_MAJOR 1
+#define GM_PARALLEL_VERSION_MINOR 0
+#define GM_PARALLEL_VERSION_PATCH 0
+
+#define GM_PARALLEL_VERSION GM_STRINGIFY_VERSION(GM_PARALLEL_VERSION_MAJOR, GM_PARALLEL_VERSION_MINOR, GM_PARALLEL_VERSION_PATCH)
+
+#define GM_PARALLEL_NAME_VERSION GM_PARALLEL_NAME " " GM_PARALLEL_VERSION
+
+
+#include <stddef.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+#define GM_PARALLEL_API static
+
+
+#ifndef GM_NO_NAMESPACE
+namespace gm {
+#endif
+
+
+// A fixed set of worker threads, which together with the calling
+// thread runs the tasks given to run(). Only one run() executes at
+// a time, and tasks must not call run() on the same pool.
+class ThreadPool
+{
+public:
+	// A threadCount of 0 uses std::thread::hardware_concurrency().
+	// The pool creates threadCount - 1 workers, as the calling
+	// thread of run() participates as well.
+	explicit ThreadPool(unsigned int threadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// The number of threads, including the calling thread.
+	unsigned int size() const;
+
+	// Calls task(i) for every i in [0;count), and returns
+	// when all of them have finished.
+	//
+	// If a task throws, the tasks that haven't started yet are
+	// skipped, and the first exception is rethrown by run().
+	template<typename Task> void run(size_t count, const Task &task);
+
+private:
+	struct _Job
+	{
+		void (*invoke)(const void*, size_t);
+		const void *task;
+		size_t count;
+
+		std::atomic<size_t> next;
+		size_t remaining;
+
+		std::atomic<bool> failed;
+		std::exception_ptr exception;
+	};
+
+	void _worker();
+	void _work(_Job &current);
+
+	std::vector<std::thread> threads;
+
+	std::mutex runMutex;
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+
+	_Job *job;
+	size_t generation;
+	unsigned int active;
+	bool stopping;
+};
+
+
+// The pool used when none is given. It's created on first use
+// and shared between translation units (hence not static).
+inline ThreadPool& defaultThreadPool();
+
+
+// Splits [0;count) into ranges of at least grain elements, and calls
+// fn(first, last) for each range across the pool. Runs on the calling
+// thread when count is at most grain. Exceptions thrown by fn are
+// rethrown, like with ThreadPool::run().
+template<typename Fn> GM_PARALLEL_API void parallelFor(ThreadPool &pool, size_t count, size_t grain, const Fn &fn);
+
+
+// After this point everything you'll see is all
+// the definitions to the prior declarations.
+
+
+inline ThreadPool::ThreadPool(unsigned int threadCount)
+	: job(nullptr)
+	, generation(0)
+	, active(0)
+	, stopping(false)
+{
+	if (threadCount == 0)
+		threadCount = std::thread::hardware_concurrency();
+
+	for (unsigned int i = 1; i < threadCount; ++i)
+		threads.emplace_back(&ThreadPool::_worker, this);
+}
+
+inline ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+
+	wake.notify_all();
+
+	for (std::thread &thread : threads)
+		thread.join();
+}
+
+
+inline unsigned int ThreadPool::size() const
+{
+	return static_cast<unsigned int>(threads.size()) + 1;
+}
+
+
+template<typename Task> inline void ThreadPool::run(size_t count, const Task &task)
+{
+	if (count == 0)
+		return;
+
+	if (threads.empty() || (count == 1))
+	{
+		for (size_t i = 0; i < count; ++i)
+			task(i);
+
+		return;
+	}
+
+	std::lock_guard<std::mutex> runLock(runMutex);
+
+	// The job lives on this stack frame, so it's only released
+	// after every worker that picked it up has let go of it
+	_Job current;
+	current.invoke = [](const void *p, size_t i) { (*static_cast<const Task*>(p))(i); };
+	current.task = &task;
+	current.count = count;
+	current.next.store(0);
+	current.remaining = count;
+	current.failed.store(false);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		job = &current;
+		++generation;
+	}
+
+	wake.notify_all();
+
+	_work(current);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this, &current]() { return ((current.remaining == 0) && (active == 0)); });
+
+	job = nullptr;
+
+	lock.unlock();
+
+	if (current.exception)
+		std::rethrow_exception(current.exception);
+}
+
+
+inline void ThreadPool::_work(_Job &current)
+{
+	size_t finished = 0;
+
+	// After a task threw, the remaining ones are still counted
+	// as finished, such that run() knows when to return
+	for (size_t i = current.next.fetch_add(1); i < current.count; i = current.next.fetch_add(1))
+	{
+		if (!current.failed.load())
+		{
+			try
+			{
+				current.invoke(current.task, i);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+
+				if (!current.exception)
+					current.exception = std::current_exception();
+
+				current.failed.store(true);
+			}
+		}
+
+		++finished;
+	}
+
+	if (finished > 0)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		current.remaining -= finished;
+
+		if (current.remaining == 0)
+			done.notify_all();
+	}
+}
+
+inline void ThreadPool::_worker()
+{
+	size_t seen = 0;
+
+	for (;;)
+	{
+		_Job *current;
+
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this, seen]() { return (stopping || ((job != nullptr) && (generation != seen))); });
+
+			if (stopping)
+				return;
+
+			seen = generation;
+			current = job;
+
+			++active;
+		}
+
+		_work(*current);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (--active == 0)
+				done.notify_all();
+		}
+	}
+}
+
+
+inline ThreadPool& defaultThreadPool()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+
+template<typename Fn> GM_PARALLEL_API void parallelFor(ThreadPool &pool, size_t count, size_t grain, const Fn &fn)
+{
+	if (grain == 0)
+		grain = 1;
+
+	if (count <= grain)
+	{
+		if (count > 0)
+			fn(static_cast<size_t>(0), count);
+
+		return;
+	}
+
+	// A few ranges per thread, to balance uneven work
+	size_t ranges = static_cast<size_t>(pool.size()) * 4;
+
+	if (ranges > (count / grain))
+		ranges = count / grain;
+
+	const size_t size = (count + ranges - 1) / ranges;
+
+	pool.run(ranges, [&](size_t i)
+	{
+		const size_t first = i * size;
+		const size_t last = ((first + size) < count) ? (first + size) : count;
+
+		if (first < last)
+			fn(first, last);
+	});
+}
+
+
+#ifndef GM_NO_NAMESPACE
+}
+#endif
+
+
+#endif
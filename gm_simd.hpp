@@ -0,0 +1,1385 @@
+
+// Author: Christian Vallentin <mail@vallentinsource.com>
+// Website: http://vallentinsource.com
+// Repository: https://github.com/MrVallentin/GameMath
+//
+// Date Created: October 18, 2026
+// Last Modified: October 18, 2026
+
+// Copyright (c) 2012-2016 Christian Vallentin <mail@vallentinsource.com>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+
+// Refrain from using any exposed macros, functions
+// or structs prefixed with an underscore. As these
+// are only intended for internal purposes. Which
+// additionally means they can be removed, renamed
+// or changed between minor updates without notice.
+
+// This library is a thin wrapper around the SIMD instruction
+// sets, used by the batch functions of the other libraries.
+// The widest instruction set enabled at compile time is used:
+//
+//   AVX-512 (-mavx512f) - 16 floats / 8 doubles per vector
+//   AVX2    (-mavx2)    -  8 floats / 4 doubles per vector
+//   SSE2    (default)   -  4 floats / 2 doubles per vector
+//   Scalar              -  1 float  / 1 double  per vector
+//
+// Define GM_SIMD_NONE before including any of the libraries
+// to force the scalar fallback, or GM_SIMD_NO_AVX512 and
+// GM_SIMD_NO_AVX2 to cap the instruction set.
+
+#ifndef GM_SIMD_HPP
+#define GM_SIMD_HPP
+
+
+#ifndef GM_STRINGIFY_VERSION
+#	define _GM_STRINGIFY(str) #str
+#	define _GM_STRINGIFY_TOKEN(str) _GM_STRINGIFY(str)
+#	define GM_STRINGIFY_VERSION(major, minor, patch) _GM_STRINGIFY(major) "." _GM_STRINGIFY(minor) "." _GM_STRINGIFY(patch)
+#endif
+
+
+#define GM_SIMD_NAME "GameMath SIMD"
+
+#define GM_SIMD_VERSION_MAJOR 1
+#define GM_SIMD_VERSION_MINOR 0
+#define GM_SIMD_VERSION_PATCH 0
+
+#define GM_SIMD_VERSION GM_STRINGIFY_VERSION(GM_SIMD_VERSION_MAJOR, GM_SIMD_VERSION_MINOR, GM_SIMD_VERSION_PATCH)
+
+#define GM_SIMD_NAME_VERSION GM_SIMD_NAME " " GM_SIMD_VERSION
+
+
+#if defined(GM_SIMD_NONE)
+#	define GM_SIMD_SCALAR
+#elif defined(__AVX512F__) && !defined(GM_SIMD_NO_AVX512)
+#	define GM_SIMD_AVX512
+#elif defined(__AVX2__) && !defined(GM_SIMD_NO_AVX2)
+#	define GM_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#	define GM_SIMD_SSE2
+#else
+#	define GM_SIMD_SCALAR
+#endif
+
+
+#if defined(GM_SIMD_AVX512)
+#	define GM_SIMD_FLOAT_WIDTH 16
+#	define GM_SIMD_DOUBLE_WIDTH 8
+#	define GM_SIMD_ALIGNMENT 64
+#elif defined(GM_SIMD_AVX2)
+#	define GM_SIMD_FLOAT_WIDTH 8
+#	define GM_SIMD_DOUBLE_WIDTH 4
+#	define GM_SIMD_ALIGNMENT 32
+#elif defined(GM_SIMD_SSE2)
+#	define GM_SIMD_FLOAT_WIDTH 4
+#	define GM_SIMD_DOUBLE_WIDTH 2
+#	define GM_SIMD_ALIGNMENT 16
+#else
+#	define GM_SIMD_FLOAT_WIDTH 1
+#	define GM_SIMD_DOUBLE_WIDTH 1
+#	define GM_SIMD_ALIGNMENT 16
+#endif
+
+
+#if !defined(GM_SIMD_SCALAR)
+#	include <immintrin.h>
+#endif
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+
+#if !defined(GM_SIMD_SCALAR) && defined(__FMA__)
+#	define _GM_SIMD_FMA
+#endif
+
+#if defined(GM_SIMD_SSE2) && defined(__SSE4_1__)
+#	define _GM_SIMD_SSE41
+#endif
+
+
+#if defined(_MSC_VER)
+#	define GM_SIMD_ALIGN(x) __declspec(align(x))
+#else
+#	define GM_SIMD_ALIGN(x) __attribute__((aligned(x)))
+#endif
+
+
+#define GM_SIMD_API static
+
+
+#ifndef GM_NO_NAMESPACE
+namespace gm {
+#endif
+
+namespace simd {
+
+
+// vfloat  - GM_SIMD_FLOAT_WIDTH floats
+// vint    - GM_SIMD_FLOAT_WIDTH 32-bit integers
+// vmask   - GM_SIMD_FLOAT_WIDTH lane mask, the result of comparing vfloat or vint
+//
+// vdouble - GM_SIMD_DOUBLE_WIDTH doubles
+// vmaskd  - GM_SIMD_DOUBLE_WIDTH lane mask, the result of comparing vdouble
+//
+// All vector types can be constructed from a scalar, which
+// broadcasts the scalar to all lanes. load() and store() require
+// pointers aligned to GM_SIMD_ALIGNMENT, loadu() and storeu() don't.
+// loadPartial() and storePartial() only touch the first count
+// elements, the remaining lanes are loaded as zero.
+//
+// gather(base, index) loads base[index] for every lane.
+// splat4<I>() is only available when GM_SIMD_FLOAT_WIDTH is at
+// least 4. It replicates lane I of every group of 4 lanes, e.g.
+// broadcasting the alpha of every pixel in a vector of RGBA pixels.
+
+
+#if defined(GM_SIMD_AVX512)
+
+struct vmask
+{
+	__mmask16 m;
+
+	vmask() = default;
+	vmask(__mmask16 m) : m(m) {}
+};
+
+struct vmaskd
+{
+	__mmask8 m;
+
+	vmaskd() = default;
+	vmaskd(__mmask8 m) : m(m) {}
+};
+
+struct vfloat
+{
+	typedef float scalar;
+	enum { width = 16 };
+
+	__m512 v;
+
+	vfloat() = default;
+	vfloat(__m512 v) : v(v) {}
+	vfloat(float x) : v(_mm512_set1_ps(x)) {}
+
+	static vfloat load(const float *p) { return _mm512_load_ps(p); }
+	static vfloat loadu(const float *p) { return _mm512_loadu_ps(p); }
+
+	void store(float *p) const { _mm512_store_ps(p, v); }
+	void storeu(float *p) const { _mm512_storeu_ps(p, v); }
+};
+
+struct vdouble
+{
+	typedef double scalar;
+	enum { width = 8 };
+
+	__m512d v;
+
+	vdouble() = default;
+	vdouble(__m512d v) : v(v) {}
+	vdouble(double x) : v(_mm512_set1_pd(x)) {}
+
+	static vdouble load(const double *p) { return _mm512_load_pd(p); }
+	static vdouble loadu(const double *p) { return _mm512_loadu_pd(p); }
+
+	void store(double *p) const { _mm512_store_pd(p, v); }
+	void storeu(double *p) const { _mm512_storeu_pd(p, v); }
+};
+
+struct vint
+{
+	typedef int scalar;
+	enum { width = 16 };
+
+	__m512i v;
+
+	vint() = default;
+	vint(__m512i v) : v(v) {}
+	vint(int x) : v(_mm512_set1_epi32(x)) {}
+
+	static vint load(const int *p) { return _mm512_load_si512(p); }
+	static vint loadu(const int *p) { return _mm512_loadu_si512(p); }
+
+	void store(int *p) const { _mm512_store_si512(p, v); }
+	void storeu(int *p) const { _mm512_storeu_si512(p, v); }
+};
+
+
+GM_SIMD_API inline vmask operator&(const vmask &a, const vmask &b) { return static_cast<__mmask16>(a.m & b.m); }
+GM_SIMD_API inline vmask operator|(const vmask &a, const vmask &b) { return static_cast<__mmask16>(a.m | b.m); }
+GM_SIMD_API inline vmask operator^(const vmask &a, const vmask &b) { return static_cast<__mmask16>(a.m ^ b.m); }
+GM_SIMD_API inline vmask operator~(const vmask &a) { return static_cast<__mmask16>(~a.m); }
+
+GM_SIMD_API inline int bits(const vmask &a) { return static_cast<int>(a.m); }
+GM_SIMD_API inline bool any(const vmask &a) { return (a.m != 0); }
+GM_SIMD_API inline bool all(const vmask &a) { return (a.m == 0xFFFF); }
+
+GM_SIMD_API inline vmaskd operator&(const vmaskd &a, const vmaskd &b) { return static_cast<__mmask8>(a.m & b.m); }
+GM_SIMD_API inline vmaskd operator|(const vmaskd &a, const vmaskd &b) { return static_cast<__mmask8>(a.m | b.m); }
+GM_SIMD_API inline vmaskd operator^(const vmaskd &a, const vmaskd &b) { return static_cast<__mmask8>(a.m ^ b.m); }
+GM_SIMD_API inline vmaskd operator~(const vmaskd &a) { return static_cast<__mmask8>(~a.m); }
+
+GM_SIMD_API inline int bits(const vmaskd &a) { return static_cast<int>(a.m); }
+GM_SIMD_API inline bool any(const vmaskd &a) { return (a.m != 0); }
+GM_SIMD_API inline bool all(const vmaskd &a) { return (a.m == 0xFF); }
+
+
+GM_SIMD_API inline vfloat operator+(const vfloat &a, const vfloat &b) { return _mm512_add_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat operator-(const vfloat &a, const vfloat &b) { return _mm512_sub_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat operator*(const vfloat &a, const vfloat &b) { return _mm512_mul_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat operator/(const vfloat &a, const vfloat &b) { return _mm512_div_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat operator-(const vfloat &a) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a.v), _mm512_set1_epi32(0x80000000))); }
+
+GM_SIMD_API inline vmask operator<(const vfloat &a, const vfloat &b) { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ); }
+GM_SIMD_API inline vmask operator<=(const vfloat &a, const vfloat &b) { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ); }
+GM_SIMD_API inline vmask operator>(const vfloat &a, const vfloat &b) { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ); }
+GM_SIMD_API inline vmask operator>=(const vfloat &a, const vfloat &b) { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ); }
+GM_SIMD_API inline vmask operator==(const vfloat &a, const vfloat &b) { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_EQ_OQ); }
+GM_SIMD_API inline vmask operator!=(const vfloat &a, const vfloat &b) { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_NEQ_UQ); }
+
+GM_SIMD_API inline vfloat select(const vmask &m, const vfloat &a, const vfloat &b) { return _mm512_mask_blend_ps(m.m, b.v, a.v); }
+
+GM_SIMD_API inline vfloat min(const vfloat &a, const vfloat &b) { return _mm512_min_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat max(const vfloat &a, const vfloat &b) { return _mm512_max_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat abs(const vfloat &a) { return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a.v), _mm512_set1_epi32(0x7FFFFFFF))); }
+GM_SIMD_API inline vfloat sqrt(const vfloat &a) { return _mm512_sqrt_ps(a.v); }
+
+GM_SIMD_API inline vfloat floor(const vfloat &a) { return _mm512_roundscale_ps(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vfloat ceil(const vfloat &a) { return _mm512_roundscale_ps(a.v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vfloat trunc(const vfloat &a) { return _mm512_roundscale_ps(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vfloat round(const vfloat &a) { return _mm512_roundscale_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+GM_SIMD_API inline vfloat fmadd(const vfloat &a, const vfloat &b, const vfloat &c) { return _mm512_fmadd_ps(a.v, b.v, c.v); }
+
+
+GM_SIMD_API inline vdouble operator+(const vdouble &a, const vdouble &b) { return _mm512_add_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble operator-(const vdouble &a, const vdouble &b) { return _mm512_sub_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble operator*(const vdouble &a, const vdouble &b) { return _mm512_mul_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble operator/(const vdouble &a, const vdouble &b) { return _mm512_div_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble operator-(const vdouble &a) { return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a.v), _mm512_set1_epi64(0x8000000000000000LL))); }
+
+GM_SIMD_API inline vmaskd operator<(const vdouble &a, const vdouble &b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ); }
+GM_SIMD_API inline vmaskd operator<=(const vdouble &a, const vdouble &b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_LE_OQ); }
+GM_SIMD_API inline vmaskd operator>(const vdouble &a, const vdouble &b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ); }
+GM_SIMD_API inline vmaskd operator>=(const vdouble &a, const vdouble &b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_GE_OQ); }
+GM_SIMD_API inline vmaskd operator==(const vdouble &a, const vdouble &b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_EQ_OQ); }
+GM_SIMD_API inline vmaskd operator!=(const vdouble &a, const vdouble &b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_NEQ_UQ); }
+
+GM_SIMD_API inline vdouble select(const vmaskd &m, const vdouble &a, const vdouble &b) { return _mm512_mask_blend_pd(m.m, b.v, a.v); }
+
+GM_SIMD_API inline vdouble min(const vdouble &a, const vdouble &b) { return _mm512_min_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble max(const vdouble &a, const vdouble &b) { return _mm512_max_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble abs(const vdouble &a) { return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(a.v), _mm512_set1_epi64(0x7FFFFFFFFFFFFFFFLL))); }
+GM_SIMD_API inline vdouble sqrt(const vdouble &a) { return _mm512_sqrt_pd(a.v); }
+
+GM_SIMD_API inline vdouble floor(const vdouble &a) { return _mm512_roundscale_pd(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vdouble ceil(const vdouble &a) { return _mm512_roundscale_pd(a.v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vdouble trunc(const vdouble &a) { return _mm512_roundscale_pd(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vdouble round(const vdouble &a) { return _mm512_roundscale_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+GM_SIMD_API inline vdouble fmadd(const vdouble &a, const vdouble &b, const vdouble &c) { return _mm512_fmadd_pd(a.v, b.v, c.v); }
+
+
+GM_SIMD_API inline vint operator+(const vint &a, const vint &b) { return _mm512_add_epi32(a.v, b.v); }
+GM_SIMD_API inline vint operator-(const vint &a, const vint &b) { return _mm512_sub_epi32(a.v, b.v); }
+GM_SIMD_API inline vint operator*(const vint &a, const vint &b) { return _mm512_mullo_epi32(a.v, b.v); }
+GM_SIMD_API inline vint operator&(const vint &a, const vint &b) { return _mm512_and_si512(a.v, b.v); }
+GM_SIMD_API inline vint operator|(const vint &a, const vint &b) { return _mm512_or_si512(a.v, b.v); }
+GM_SIMD_API inline vint operator^(const vint &a, const vint &b) { return _mm512_xor_si512(a.v, b.v); }
+
+GM_SIMD_API inline vmask operator==(const vint &a, const vint &b) { return _mm512_cmpeq_epi32_mask(a.v, b.v); }
+GM_SIMD_API inline vmask operator>(const vint &a, const vint &b) { return _mm512_cmpgt_epi32_mask(a.v, b.v); }
+GM_SIMD_API inline vmask operator<(const vint &a, const vint &b) { return _mm512_cmplt_epi32_mask(a.v, b.v); }
+
+GM_SIMD_API inline vint select(const vmask &m, const vint &a, const vint &b) { return _mm512_mask_blend_epi32(m.m, b.v, a.v); }
+
+GM_SIMD_API inline vint min(const vint &a, const vint &b) { return _mm512_min_epi32(a.v, b.v); }
+GM_SIMD_API inline vint max(const vint &a, const vint &b) { return _mm512_max_epi32(a.v, b.v); }
+
+template<int N> GM_SIMD_API inline vint sll(const vint &a) { return _mm512_slli_epi32(a.v, N); }
+template<int N> GM_SIMD_API inline vint srl(const vint &a) { return _mm512_srli_epi32(a.v, N); }
+template<int N> GM_SIMD_API inline vint sra(const vint &a) { return _mm512_srai_epi32(a.v, N); }
+
+GM_SIMD_API inline vint sll(const vint &a, int n) { return _mm512_sll_epi32(a.v, _mm_cvtsi32_si128(n)); }
+GM_SIMD_API inline vint srl(const vint &a, int n) { return _mm512_srl_epi32(a.v, _mm_cvtsi32_si128(n)); }
+
+GM_SIMD_API inline vfloat toFloat(const vint &a) { return _mm512_cvtepi32_ps(a.v); }
+GM_SIMD_API inline vint toInt(const vfloat &a) { return _mm512_cvttps_epi32(a.v); }
+
+GM_SIMD_API inline vfloat asFloat(const vint &a) { return _mm512_castsi512_ps(a.v); }
+GM_SIMD_API inline vint asInt(const vfloat &a) { return _mm512_castps_si512(a.v); }
+
+template<int I> GM_SIMD_API inline vfloat splat4(const vfloat &a) { return _mm512_permute_ps(a.v, _MM_SHUFFLE(I, I, I, I)); }
+
+GM_SIMD_API inline vfloat gather(const float *base, const vint &index) { return _mm512_i32gather_ps(index.v, base, 4); }
+
+// _gm_pow2i(n) gives 2^n for integral n in [-1022;1023], by adding
+// the exponent bias and shifting n into the exponent bits.
+GM_SIMD_API inline vdouble _gm_pow2i(const vdouble &n) { return _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_castpd_si512(_mm512_add_pd(n.v, _mm512_set1_pd(4503599627371519.0))), 52)); }
+
+
+#elif defined(GM_SIMD_AVX2)
+
+struct vmask
+{
+	__m256 m;
+
+	vmask() = default;
+	vmask(__m256 m) : m(m) {}
+};
+
+struct vmaskd
+{
+	__m256d m;
+
+	vmaskd() = default;
+	vmaskd(__m256d m) : m(m) {}
+};
+
+struct vfloat
+{
+	typedef float scalar;
+	enum { width = 8 };
+
+	__m256 v;
+
+	vfloat() = default;
+	vfloat(__m256 v) : v(v) {}
+	vfloat(float x) : v(_mm256_set1_ps(x)) {}
+
+	static vfloat load(const float *p) { return _mm256_load_ps(p); }
+	static vfloat loadu(const float *p) { return _mm256_loadu_ps(p); }
+
+	void store(float *p) const { _mm256_store_ps(p, v); }
+	void storeu(float *p) const { _mm256_storeu_ps(p, v); }
+};
+
+struct vdouble
+{
+	typedef double scalar;
+	enum { width = 4 };
+
+	__m256d v;
+
+	vdouble() = default;
+	vdouble(__m256d v) : v(v) {}
+	vdouble(double x) : v(_mm256_set1_pd(x)) {}
+
+	static vdouble load(const double *p) { return _mm256_load_pd(p); }
+	static vdouble loadu(const double *p) { return _mm256_loadu_pd(p); }
+
+	void store(double *p) const { _mm256_store_pd(p, v); }
+	void storeu(double *p) const { _mm256_storeu_pd(p, v); }
+};
+
+struct vint
+{
+	typedef int scalar;
+	enum { width = 8 };
+
+	__m256i v;
+
+	vint() = default;
+	vint(__m256i v) : v(v) {}
+	vint(int x) : v(_mm256_set1_epi32(x)) {}
+
+	static vint load(const int *p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+	static vint loadu(const int *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+
+	void store(int *p) const { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+	void storeu(int *p) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+};
+
+
+GM_SIMD_API inline vmask operator&(const vmask &a, const vmask &b) { return _mm256_and_ps(a.m, b.m); }
+GM_SIMD_API inline vmask operator|(const vmask &a, const vmask &b) { return _mm256_or_ps(a.m, b.m); }
+GM_SIMD_API inline vmask operator^(const vmask &a, const vmask &b) { return _mm256_xor_ps(a.m, b.m); }
+GM_SIMD_API inline vmask operator~(const vmask &a) { return _mm256_xor_ps(a.m, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+
+GM_SIMD_API inline int bits(const vmask &a) { return _mm256_movemask_ps(a.m); }
+GM_SIMD_API inline bool any(const vmask &a) { return (_mm256_movemask_ps(a.m) != 0); }
+GM_SIMD_API inline bool all(const vmask &a) { return (_mm256_movemask_ps(a.m) == 0xFF); }
+
+GM_SIMD_API inline vmaskd operator&(const vmaskd &a, const vmaskd &b) { return _mm256_and_pd(a.m, b.m); }
+GM_SIMD_API inline vmaskd operator|(const vmaskd &a, const vmaskd &b) { return _mm256_or_pd(a.m, b.m); }
+GM_SIMD_API inline vmaskd operator^(const vmaskd &a, const vmaskd &b) { return _mm256_xor_pd(a.m, b.m); }
+GM_SIMD_API inline vmaskd operator~(const vmaskd &a) { return _mm256_xor_pd(a.m, _mm256_castsi256_pd(_mm256_set1_epi32(-1))); }
+
+GM_SIMD_API inline int bits(const vmaskd &a) { return _mm256_movemask_pd(a.m); }
+GM_SIMD_API inline bool any(const vmaskd &a) { return (_mm256_movemask_pd(a.m) != 0); }
+GM_SIMD_API inline bool all(const vmaskd &a) { return (_mm256_movemask_pd(a.m) == 0xF); }
+
+
+GM_SIMD_API inline vfloat operator+(const vfloat &a, const vfloat &b) { return _mm256_add_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat operator-(const vfloat &a, const vfloat &b) { return _mm256_sub_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat operator*(const vfloat &a, const vfloat &b) { return _mm256_mul_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat operator/(const vfloat &a, const vfloat &b) { return _mm256_div_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat operator-(const vfloat &a) { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)); }
+
+GM_SIMD_API inline vmask operator<(const vfloat &a, const vfloat &b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+GM_SIMD_API inline vmask operator<=(const vfloat &a, const vfloat &b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ); }
+GM_SIMD_API inline vmask operator>(const vfloat &a, const vfloat &b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ); }
+GM_SIMD_API inline vmask operator>=(const vfloat &a, const vfloat &b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ); }
+GM_SIMD_API inline vmask operator==(const vfloat &a, const vfloat &b) { return _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ); }
+GM_SIMD_API inline vmask operator!=(const vfloat &a, const vfloat &b) { return _mm256_cmp_ps(a.v, b.v, _CMP_NEQ_UQ); }
+
+GM_SIMD_API inline vfloat select(const vmask &m, const vfloat &a, const vfloat &b) { return _mm256_blendv_ps(b.v, a.v, m.m); }
+
+GM_SIMD_API inline vfloat min(const vfloat &a, const vfloat &b) { return _mm256_min_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat max(const vfloat &a, const vfloat &b) { return _mm256_max_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat abs(const vfloat &a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v); }
+GM_SIMD_API inline vfloat sqrt(const vfloat &a) { return _mm256_sqrt_ps(a.v); }
+
+GM_SIMD_API inline vfloat floor(const vfloat &a) { return _mm256_round_ps(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vfloat ceil(const vfloat &a) { return _mm256_round_ps(a.v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vfloat trunc(const vfloat &a) { return _mm256_round_ps(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vfloat round(const vfloat &a) { return _mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+#if defined(_GM_SIMD_FMA)
+GM_SIMD_API inline vfloat fmadd(const vfloat &a, const vfloat &b, const vfloat &c) { return _mm256_fmadd_ps(a.v, b.v, c.v); }
+#else
+GM_SIMD_API inline vfloat fmadd(const vfloat &a, const vfloat &b, const vfloat &c) { return _mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v); }
+#endif
+
+
+GM_SIMD_API inline vdouble operator+(const vdouble &a, const vdouble &b) { return _mm256_add_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble operator-(const vdouble &a, const vdouble &b) { return _mm256_sub_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble operator*(const vdouble &a, const vdouble &b) { return _mm256_mul_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble operator/(const vdouble &a, const vdouble &b) { return _mm256_div_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble operator-(const vdouble &a) { return _mm256_xor_pd(a.v, _mm256_set1_pd(-0.0)); }
+
+GM_SIMD_API inline vmaskd operator<(const vdouble &a, const vdouble &b) { return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+GM_SIMD_API inline vmaskd operator<=(const vdouble &a, const vdouble &b) { return _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ); }
+GM_SIMD_API inline vmaskd operator>(const vdouble &a, const vdouble &b) { return _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ); }
+GM_SIMD_API inline vmaskd operator>=(const vdouble &a, const vdouble &b) { return _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ); }
+GM_SIMD_API inline vmaskd operator==(const vdouble &a, const vdouble &b) { return _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ); }
+GM_SIMD_API inline vmaskd operator!=(const vdouble &a, const vdouble &b) { return _mm256_cmp_pd(a.v, b.v, _CMP_NEQ_UQ); }
+
+GM_SIMD_API inline vdouble select(const vmaskd &m, const vdouble &a, const vdouble &b) { return _mm256_blendv_pd(b.v, a.v, m.m); }
+
+GM_SIMD_API inline vdouble min(const vdouble &a, const vdouble &b) { return _mm256_min_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble max(const vdouble &a, const vdouble &b) { return _mm256_max_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble abs(const vdouble &a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v); }
+GM_SIMD_API inline vdouble sqrt(const vdouble &a) { return _mm256_sqrt_pd(a.v); }
+
+GM_SIMD_API inline vdouble floor(const vdouble &a) { return _mm256_round_pd(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vdouble ceil(const vdouble &a) { return _mm256_round_pd(a.v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vdouble trunc(const vdouble &a) { return _mm256_round_pd(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vdouble round(const vdouble &a) { return _mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+#if defined(_GM_SIMD_FMA)
+GM_SIMD_API inline vdouble fmadd(const vdouble &a, const vdouble &b, const vdouble &c) { return _mm256_fmadd_pd(a.v, b.v, c.v); }
+#else
+GM_SIMD_API inline vdouble fmadd(const vdouble &a, const vdouble &b, const vdouble &c) { return _mm256_add_pd(_mm256_mul_pd(a.v, b.v), c.v); }
+#endif
+
+
+GM_SIMD_API inline vint operator+(const vint &a, const vint &b) { return _mm256_add_epi32(a.v, b.v); }
+GM_SIMD_API inline vint operator-(const vint &a, const vint &b) { return _mm256_sub_epi32(a.v, b.v); }
+GM_SIMD_API inline vint operator*(const vint &a, const vint &b) { return _mm256_mullo_epi32(a.v, b.v); }
+GM_SIMD_API inline vint operator&(const vint &a, const vint &b) { return _mm256_and_si256(a.v, b.v); }
+GM_SIMD_API inline vint operator|(const vint &a, const vint &b) { return _mm256_or_si256(a.v, b.v); }
+GM_SIMD_API inline vint operator^(const vint &a, const vint &b) { return _mm256_xor_si256(a.v, b.v); }
+
+GM_SIMD_API inline vmask operator==(const vint &a, const vint &b) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a.v, b.v)); }
+GM_SIMD_API inline vmask operator>(const vint &a, const vint &b) { return _mm256_castsi256_ps(_mm256_cmpgt_epi32(a.v, b.v)); }
+GM_SIMD_API inline vmask operator<(const vint &a, const vint &b) { return _mm256_castsi256_ps(_mm256_cmpgt_epi32(b.v, a.v)); }
+
+GM_SIMD_API inline vint select(const vmask &m, const vint &a, const vint &b) { return _mm256_blendv_epi8(b.v, a.v, _mm256_castps_si256(m.m)); }
+
+GM_SIMD_API inline vint min(const vint &a, const vint &b) { return _mm256_min_epi32(a.v, b.v); }
+GM_SIMD_API inline vint max(const vint &a, const vint &b) { return _mm256_max_epi32(a.v, b.v); }
+
+template<int N> GM_SIMD_API inline vint sll(const vint &a) { return _mm256_slli_epi32(a.v, N); }
+template<int N> GM_SIMD_API inline vint srl(const vint &a) { return _mm256_srli_epi32(a.v, N); }
+template<int N> GM_SIMD_API inline vint sra(const vint &a) { return _mm256_srai_epi32(a.v, N); }
+
+GM_SIMD_API inline vint sll(const vint &a, int n) { return _mm256_sll_epi32(a.v, _mm_cvtsi32_si128(n)); }
+GM_SIMD_API inline vint srl(const vint &a, int n) { return _mm256_srl_epi32(a.v, _mm_cvtsi32_si128(n)); }
+
+GM_SIMD_API inline vfloat toFloat(const vint &a) { return _mm256_cvtepi32_ps(a.v); }
+GM_SIMD_API inline vint toInt(const vfloat &a) { return _mm256_cvttps_epi32(a.v); }
+
+GM_SIMD_API inline vfloat asFloat(const vint &a) { return _mm256_castsi256_ps(a.v); }
+GM_SIMD_API inline vint asInt(const vfloat &a) { return _mm256_castps_si256(a.v); }
+
+template<int I> GM_SIMD_API inline vfloat splat4(const vfloat &a) { return _mm256_permute_ps(a.v, _MM_SHUFFLE(I, I, I, I)); }
+
+GM_SIMD_API inline vfloat gather(const float *base, const vint &index) { return _mm256_i32gather_ps(base, index.v, 4); }
+
+GM_SIMD_API inline vdouble _gm_pow2i(const vdouble &n) { return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(_mm256_add_pd(n.v, _mm256_set1_pd(4503599627371519.0))), 52)); }
+
+
+#elif defined(GM_SIMD_SSE2)
+
+struct vmask
+{
+	__m128 m;
+
+	vmask() = default;
+	vmask(__m128 m) : m(m) {}
+};
+
+struct vmaskd
+{
+	__m128d m;
+
+	vmaskd() = default;
+	vmaskd(__m128d m) : m(m) {}
+};
+
+struct vfloat
+{
+	typedef float scalar;
+	enum { width = 4 };
+
+	__m128 v;
+
+	vfloat() = default;
+	vfloat(__m128 v) : v(v) {}
+	vfloat(float x) : v(_mm_set1_ps(x)) {}
+
+	static vfloat load(const float *p) { return _mm_load_ps(p); }
+	static vfloat loadu(const float *p) { return _mm_loadu_ps(p); }
+
+	void store(float *p) const { _mm_store_ps(p, v); }
+	void storeu(float *p) const { _mm_storeu_ps(p, v); }
+};
+
+struct vdouble
+{
+	typedef double scalar;
+	enum { width = 2 };
+
+	__m128d v;
+
+	vdouble() = default;
+	vdouble(__m128d v) : v(v) {}
+	vdouble(double x) : v(_mm_set1_pd(x)) {}
+
+	static vdouble load(const double *p) { return _mm_load_pd(p); }
+	static vdouble loadu(const double *p) { return _mm_loadu_pd(p); }
+
+	void store(double *p) const { _mm_store_pd(p, v); }
+	void storeu(double *p) const { _mm_storeu_pd(p, v); }
+};
+
+struct vint
+{
+	typedef int scalar;
+	enum { width = 4 };
+
+	__m128i v;
+
+	vint() = default;
+	vint(__m128i v) : v(v) {}
+	vint(int x) : v(_mm_set1_epi32(x)) {}
+
+	static vint load(const int *p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+	static vint loadu(const int *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+
+	void store(int *p) const { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+	void storeu(int *p) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+};
+
+
+GM_SIMD_API inline vmask operator&(const vmask &a, const vmask &b) { return _mm_and_ps(a.m, b.m); }
+GM_SIMD_API inline vmask operator|(const vmask &a, const vmask &b) { return _mm_or_ps(a.m, b.m); }
+GM_SIMD_API inline vmask operator^(const vmask &a, const vmask &b) { return _mm_xor_ps(a.m, b.m); }
+GM_SIMD_API inline vmask operator~(const vmask &a) { return _mm_xor_ps(a.m, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+
+GM_SIMD_API inline int bits(const vmask &a) { return _mm_movemask_ps(a.m); }
+GM_SIMD_API inline bool any(const vmask &a) { return (_mm_movemask_ps(a.m) != 0); }
+GM_SIMD_API inline bool all(const vmask &a) { return (_mm_movemask_ps(a.m) == 0xF); }
+
+GM_SIMD_API inline vmaskd operator&(const vmaskd &a, const vmaskd &b) { return _mm_and_pd(a.m, b.m); }
+GM_SIMD_API inline vmaskd operator|(const vmaskd &a, const vmaskd &b) { return _mm_or_pd(a.m, b.m); }
+GM_SIMD_API inline vmaskd operator^(const vmaskd &a, const vmaskd &b) { return _mm_xor_pd(a.m, b.m); }
+GM_SIMD_API inline vmaskd operator~(const vmaskd &a) { return _mm_xor_pd(a.m, _mm_castsi128_pd(_mm_set1_epi32(-1))); }
+
+GM_SIMD_API inline int bits(const vmaskd &a) { return _mm_movemask_pd(a.m); }
+GM_SIMD_API inline bool any(const vmaskd &a) { return (_mm_movemask_pd(a.m) != 0); }
+GM_SIMD_API inline bool all(const vmaskd &a) { return (_mm_movemask_pd(a.m) == 0x3); }
+
+
+GM_SIMD_API inline vfloat operator+(const vfloat &a, const vfloat &b) { return _mm_add_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat operator-(const vfloat &a, const vfloat &b) { return _mm_sub_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat operator*(const vfloat &a, const vfloat &b) { return _mm_mul_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat operator/(const vfloat &a, const vfloat &b) { return _mm_div_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat operator-(const vfloat &a) { return _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)); }
+
+GM_SIMD_API inline vmask operator<(const vfloat &a, const vfloat &b) { return _mm_cmplt_ps(a.v, b.v); }
+GM_SIMD_API inline vmask operator<=(const vfloat &a, const vfloat &b) { return _mm_cmple_ps(a.v, b.v); }
+GM_SIMD_API inline vmask operator>(const vfloat &a, const vfloat &b) { return _mm_cmpgt_ps(a.v, b.v); }
+GM_SIMD_API inline vmask operator>=(const vfloat &a, const vfloat &b) { return _mm_cmpge_ps(a.v, b.v); }
+GM_SIMD_API inline vmask operator==(const vfloat &a, const vfloat &b) { return _mm_cmpeq_ps(a.v, b.v); }
+GM_SIMD_API inline vmask operator!=(const vfloat &a, const vfloat &b) { return _mm_cmpneq_ps(a.v, b.v); }
+
+#if defined(_GM_SIMD_SSE41)
+GM_SIMD_API inline vfloat select(const vmask &m, const vfloat &a, const vfloat &b) { return _mm_blendv_ps(b.v, a.v, m.m); }
+#else
+GM_SIMD_API inline vfloat select(const vmask &m, const vfloat &a, const vfloat &b) { return _mm_or_ps(_mm_and_ps(m.m, a.v), _mm_andnot_ps(m.m, b.v)); }
+#endif
+
+GM_SIMD_API inline vfloat min(const vfloat &a, const vfloat &b) { return _mm_min_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat max(const vfloat &a, const vfloat &b) { return _mm_max_ps(a.v, b.v); }
+GM_SIMD_API inline vfloat abs(const vfloat &a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+GM_SIMD_API inline vfloat sqrt(const vfloat &a) { return _mm_sqrt_ps(a.v); }
+
+#if defined(_GM_SIMD_SSE41)
+GM_SIMD_API inline vfloat floor(const vfloat &a) { return _mm_round_ps(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vfloat ceil(const vfloat &a) { return _mm_round_ps(a.v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vfloat trunc(const vfloat &a) { return _mm_round_ps(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vfloat round(const vfloat &a) { return _mm_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+#else
+// Adding and subtracting 2^23 rounds to the nearest integer. Anything
+// at or above 2^23 is already an integer (or NaN/Inf) and is passed through.
+GM_SIMD_API inline vfloat round(const vfloat &a)
+{
+	const __m128 sign = _mm_and_ps(a.v, _mm_set1_ps(-0.0f));
+	const __m128 x = _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v);
+	const __m128 r = _mm_or_ps(_mm_sub_ps(_mm_add_ps(x, _mm_set1_ps(8388608.0f)), _mm_set1_ps(8388608.0f)), sign);
+	return select(_mm_cmplt_ps(x, _mm_set1_ps(8388608.0f)), r, a.v);
+}
+
+GM_SIMD_API inline vfloat floor(const vfloat &a)
+{
+	const __m128 r = round(a).v;
+	return _mm_sub_ps(r, _mm_and_ps(_mm_cmpgt_ps(r, a.v), _mm_set1_ps(1.0f)));
+}
+
+GM_SIMD_API inline vfloat ceil(const vfloat &a)
+{
+	const __m128 r = round(a).v;
+	return _mm_add_ps(r, _mm_and_ps(_mm_cmplt_ps(r, a.v), _mm_set1_ps(1.0f)));
+}
+
+GM_SIMD_API inline vfloat trunc(const vfloat &a)
+{
+	return select(_mm_cmplt_ps(a.v, _mm_setzero_ps()), ceil(a), floor(a));
+}
+#endif
+
+GM_SIMD_API inline vfloat fmadd(const vfloat &a, const vfloat &b, const vfloat &c) { return _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v); }
+
+
+GM_SIMD_API inline vdouble operator+(const vdouble &a, const vdouble &b) { return _mm_add_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble operator-(const vdouble &a, const vdouble &b) { return _mm_sub_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble operator*(const vdouble &a, const vdouble &b) { return _mm_mul_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble operator/(const vdouble &a, const vdouble &b) { return _mm_div_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble operator-(const vdouble &a) { return _mm_xor_pd(a.v, _mm_set1_pd(-0.0)); }
+
+GM_SIMD_API inline vmaskd operator<(const vdouble &a, const vdouble &b) { return _mm_cmplt_pd(a.v, b.v); }
+GM_SIMD_API inline vmaskd operator<=(const vdouble &a, const vdouble &b) { return _mm_cmple_pd(a.v, b.v); }
+GM_SIMD_API inline vmaskd operator>(const vdouble &a, const vdouble &b) { return _mm_cmpgt_pd(a.v, b.v); }
+GM_SIMD_API inline vmaskd operator>=(const vdouble &a, const vdouble &b) { return _mm_cmpge_pd(a.v, b.v); }
+GM_SIMD_API inline vmaskd operator==(const vdouble &a, const vdouble &b) { return _mm_cmpeq_pd(a.v, b.v); }
+GM_SIMD_API inline vmaskd operator!=(const vdouble &a, const vdouble &b) { return _mm_cmpneq_pd(a.v, b.v); }
+
+#if defined(_GM_SIMD_SSE41)
+GM_SIMD_API inline vdouble select(const vmaskd &m, const vdouble &a, const vdouble &b) { return _mm_blendv_pd(b.v, a.v, m.m); }
+#else
+GM_SIMD_API inline vdouble select(const vmaskd &m, const vdouble &a, const vdouble &b) { return _mm_or_pd(_mm_and_pd(m.m, a.v), _mm_andnot_pd(m.m, b.v)); }
+#endif
+
+GM_SIMD_API inline vdouble min(const vdouble &a, const vdouble &b) { return _mm_min_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble max(const vdouble &a, const vdouble &b) { return _mm_max_pd(a.v, b.v); }
+GM_SIMD_API inline vdouble abs(const vdouble &a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a.v); }
+GM_SIMD_API inline vdouble sqrt(const vdouble &a) { return _mm_sqrt_pd(a.v); }
+
+#if defined(_GM_SIMD_SSE41)
+GM_SIMD_API inline vdouble floor(const vdouble &a) { return _mm_round_pd(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vdouble ceil(const vdouble &a) { return _mm_round_pd(a.v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vdouble trunc(const vdouble &a) { return _mm_round_pd(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+GM_SIMD_API inline vdouble round(const vdouble &a) { return _mm_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+#else
+// Same as the float version, but with 2^52.
+GM_SIMD_API inline vdouble round(const vdouble &a)
+{
+	const __m128d sign = _mm_and_pd(a.v, _mm_set1_pd(-0.0));
+	const __m128d x = _mm_andnot_pd(_mm_set1_pd(-0.0), a.v);
+	const __m128d r = _mm_or_pd(_mm_sub_pd(_mm_add_pd(x, _mm_set1_pd(4503599627370496.0)), _mm_set1_pd(4503599627370496.0)), sign);
+	return select(_mm_cmplt_pd(x, _mm_set1_pd(4503599627370496.0)), r, a.v);
+}
+
+GM_SIMD_API inline vdouble floor(const vdouble &a)
+{
+	const __m128d r = round(a).v;
+	return _mm_sub_pd(r, _mm_and_pd(_mm_cmpgt_pd(r, a.v), _mm_set1_pd(1.0)));
+}
+
+GM_SIMD_API inline vdouble ceil(const vdouble &a)
+{
+	const __m128d r = round(a).v;
+	return _mm_add_pd(r, _mm_and_pd(_mm_cmplt_pd(r, a.v), _mm_set1_pd(1.0)));
+}
+
+GM_SIMD_API inline vdouble trunc(const vdouble &a)
+{
+	return select(_mm_cmplt_pd(a.v, _mm_setzero_pd()), ceil(a), floor(a));
+}
+#endif
+
+GM_SIMD_API inline vdouble fmadd(const vdouble &a, const vdouble &b, const vdouble &c) { return _mm_add_pd(_mm_mul_pd(a.v, b.v), c.v); }
+
+
+GM_SIMD_API inline vint operator+(const vint &a, const vint &b) { return _mm_add_epi32(a.v, b.v); }
+GM_SIMD_API inline vint operator-(const vint &a, const vint &b) { return _mm_sub_epi32(a.v, b.v); }
+GM_SIMD_API inline vint operator&(const vint &a, const vint &b) { return _mm_and_si128(a.v, b.v); }
+GM_SIMD_API inline vint operator|(const vint &a, const vint &b) { return _mm_or_si128(a.v, b.v); }
+GM_SIMD_API inline vint operator^(const vint &a, const vint &b) { return _mm_xor_si128(a.v, b.v); }
+
+#if defined(_GM_SIMD_SSE41)
+GM_SIMD_API inline vint operator*(const vint &a, const vint &b) { return _mm_mullo_epi32(a.v, b.v); }
+#else
+GM_SIMD_API inline vint operator*(const vint &a, const vint &b)
+{
+	const __m128i even = _mm_mul_epu32(a.v, b.v);
+	const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a.v, 4), _mm_srli_si128(b.v, 4));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+#endif
+
+GM_SIMD_API inline vmask operator==(const vint &a, const vint &b) { return _mm_castsi128_ps(_mm_cmpeq_epi32(a.v, b.v)); }
+GM_SIMD_API inline vmask operator>(const vint &a, const vint &b) { return _mm_castsi128_ps(_mm_cmpgt_epi32(a.v, b.v)); }
+GM_SIMD_API inline vmask operator<(const vint &a, const vint &b) { return _mm_castsi128_ps(_mm_cmplt_epi32(a.v, b.v)); }
+
+GM_SIMD_API inline vint select(const vmask &m, const vint &a, const vint &b)
+{
+	const __m128i mask = _mm_castps_si128(m.m);
+	return _mm_or_si128(_mm_and_si128(mask, a.v), _mm_andnot_si128(mask, b.v));
+}
+
+GM_SIMD_API inline vint min(const vint &a, const vint &b) { return select(a < b, a, b); }
+GM_SIMD_API inline vint max(const vint &a, const vint &b) { return select(a > b, a, b); }
+
+template<int N> GM_SIMD_API inline vint sll(const vint &a) { return _mm_slli_epi32(a.v, N); }
+template<int N> GM_SIMD_API inline vint srl(const vint &a) { return _mm_srli_epi32(a.v, N); }
+template<int N> GM_SIMD_API inline vint sra(const vint &a) { return _mm_srai_epi32(a.v, N); }
+
+GM_SIMD_API inline vint sll(const vint &a, int n) { return _mm_sll_epi32(a.v, _mm_cvtsi32_si128(n)); }
+GM_SIMD_API inline vint srl(const vint &a, int n) { return _mm_srl_epi32(a.v, _mm_cvtsi32_si128(n)); }
+
+GM_SIMD_API inline vfloat toFloat(const vint &a) { return _mm_cvtepi32_ps(a.v); }
+GM_SIMD_API inline vint toInt(const vfloat &a) { return _mm_cvttps_epi32(a.v); }
+
+GM_SIMD_API inline vfloat asFloat(const vint &a) { return _mm_castsi128_ps(a.v); }
+GM_SIMD_API inline vint asInt(const vfloat &a) { return _mm_castps_si128(a.v); }
+
+template<int I> GM_SIMD_API inline vfloat splat4(const vfloat &a) { return _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(I, I, I, I)); }
+
+// SSE2 has no gather instruction, so it's emulated with scalar loads.
+GM_SIMD_API inline vfloat gather(const float *base, const vint &index)
+{
+	GM_SIMD_ALIGN(16) int i[4];
+	_mm_store_si128(reinterpret_cast<__m128i*>(i), index.v);
+
+	return _mm_setr_ps(base[i[0]], base[i[1]], base[i[2]], base[i[3]]);
+}
+
+GM_SIMD_API inline vdouble _gm_pow2i(const vdouble &n) { return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(_mm_add_pd(n.v, _mm_set1_pd(4503599627371519.0))), 52)); }
+
+
+#else
+
+struct vmask
+{
+	bool m;
+
+	vmask() = default;
+	vmask(bool m) : m(m) {}
+};
+
+typedef vmask vmaskd;
+
+struct vfloat
+{
+	typedef float scalar;
+	enum { width = 1 };
+
+	float v;
+
+	vfloat() = default;
+	vfloat(float x) : v(x) {}
+
+	static vfloat load(const float *p) { return *p; }
+	static vfloat loadu(const float *p) { return *p; }
+
+	void store(float *p) const { *p = v; }
+	void storeu(float *p) const { *p = v; }
+};
+
+struct vdouble
+{
+	typedef double scalar;
+	enum { width = 1 };
+
+	double v;
+
+	vdouble() = default;
+	vdouble(double x) : v(x) {}
+
+	static vdouble load(const double *p) { return *p; }
+	static vdouble loadu(const double *p) { return *p; }
+
+	void store(double *p) const { *p = v; }
+	void storeu(double *p) const { *p = v; }
+};
+
+struct vint
+{
+	typedef int scalar;
+	enum { width = 1 };
+
+	int v;
+
+	vint() = default;
+	vint(int x) : v(x) {}
+
+	static vint load(const int *p) { return *p; }
+	static vint loadu(const int *p) { return *p; }
+
+	void store(int *p) const { *p = v; }
+	void storeu(int *p) const { *p = v; }
+};
+
+
+GM_SIMD_API inline vmask operator&(const vmask &a, const vmask &b) { return (a.m && b.m); }
+GM_SIMD_API inline vmask operator|(const vmask &a, const vmask &b) { return (a.m || b.m); }
+GM_SIMD_API inline vmask operator^(const vmask &a, const vmask &b) { return (a.m != b.m); }
+GM_SIMD_API inline vmask operator~(const vmask &a) { return !a.m; }
+
+GM_SIMD_API inline int bits(const vmask &a) { return (a.m ? 1 : 0); }
+GM_SIMD_API inline bool any(const vmask &a) { return a.m; }
+GM_SIMD_API inline bool all(const vmask &a) { return a.m; }
+
+
+GM_SIMD_API inline vfloat operator+(const vfloat &a, const vfloat &b) { return a.v + b.v; }
+GM_SIMD_API inline vfloat operator-(const vfloat &a, const vfloat &b) { return a.v - b.v; }
+GM_SIMD_API inline vfloat operator*(const vfloat &a, const vfloat &b) { return a.v * b.v; }
+GM_SIMD_API inline vfloat operator/(const vfloat &a, const vfloat &b) { return a.v / b.v; }
+GM_SIMD_API inline vfloat operator-(const vfloat &a) { return -a.v; }
+
+GM_SIMD_API inline vmask operator<(const vfloat &a, const vfloat &b) { return (a.v < b.v); }
+GM_SIMD_API inline vmask operator<=(const vfloat &a, const vfloat &b) { return (a.v <= b.v); }
+GM_SIMD_API inline vmask operator>(const vfloat &a, const vfloat &b) { return (a.v > b.v); }
+GM_SIMD_API inline vmask operator>=(const vfloat &a, const vfloat &b) { return (a.v >= b.v); }
+GM_SIMD_API inline vmask operator==(const vfloat &a, const vfloat &b) { return (a.v == b.v); }
+GM_SIMD_API inline vmask operator!=(const vfloat &a, const vfloat &b) { return (a.v != b.v); }
+
+GM_SIMD_API inline vfloat select(const vmask &m, const vfloat &a, const vfloat &b) { return (m.m ? a : b); }
+
+GM_SIMD_API inline vfloat min(const vfloat &a, const vfloat &b) { return ((a.v < b.v) ? a : b); }
+GM_SIMD_API inline vfloat max(const vfloat &a, const vfloat &b) { return ((a.v > b.v) ? a : b); }
+GM_SIMD_API inline vfloat abs(const vfloat &a) { return ::fabsf(a.v); }
+GM_SIMD_API inline vfloat sqrt(const vfloat &a) { return ::sqrtf(a.v); }
+
+GM_SIMD_API inline vfloat floor(const vfloat &a) { return ::floorf(a.v); }
+GM_SIMD_API inline vfloat ceil(const vfloat &a) { return ::ceilf(a.v); }
+GM_SIMD_API inline vfloat trunc(const vfloat &a) { return ::truncf(a.v); }
+GM_SIMD_API inline vfloat round(const vfloat &a) { return ::nearbyintf(a.v); }
+
+GM_SIMD_API inline vfloat fmadd(const vfloat &a, const vfloat &b, const vfloat &c) { return a.v * b.v + c.v; }
+
+
+GM_SIMD_API inline vdouble operator+(const vdouble &a, const vdouble &b) { return a.v + b.v; }
+GM_SIMD_API inline vdouble operator-(const vdouble &a, const vdouble &b) { return a.v - b.v; }
+GM_SIMD_API inline vdouble operator*(const vdouble &a, const vdouble &b) { return a.v * b.v; }
+GM_SIMD_API inline vdouble operator/(const vdouble &a, const vdouble &b) { return a.v / b.v; }
+GM_SIMD_API inline vdouble operator-(const vdouble &a) { return -a.v; }
+
+GM_SIMD_API inline vmaskd operator<(const vdouble &a, const vdouble &b) { return (a.v < b.v); }
+GM_SIMD_API inline vmaskd operator<=(const vdouble &a, const vdouble &b) { return (a.v <= b.v); }
+GM_SIMD_API inline vmaskd operator>(const vdouble &a, const vdouble &b) { return (a.v > b.v); }
+GM_SIMD_API inline vmaskd operator>=(const vdouble &a, const vdouble &b) { return (a.v >= b.v); }
+GM_SIMD_API inline vmaskd operator==(const vdouble &a, const vdouble &b) { return (a.v == b.v); }
+GM_SIMD_API inline vmaskd operator!=(const vdouble &a, const vdouble &b) { return (a.v != b.v); }
+
+GM_SIMD_API inline vdouble select(const vmaskd &m, const vdouble &a, const vdouble &b) { return (m.m ? a : b); }
+
+GM_SIMD_API inline vdouble min(const vdouble &a, const vdouble &b) { return ((a.v < b.v) ? a : b); }
+GM_SIMD_API inline vdouble max(const vdouble &a, const vdouble &b) { return ((a.v > b.v) ? a : b); }
+GM_SIMD_API inline vdouble abs(const vdouble &a) { return ::fabs(a.v); }
+GM_SIMD_API inline vdouble sqrt(const vdouble &a) { return ::sqrt(a.v); }
+
+GM_SIMD_API inline vdouble floor(const vdouble &a) { return ::floor(a.v); }
+GM_SIMD_API inline vdouble ceil(const vdouble &a) { return ::ceil(a.v); }
+GM_SIMD_API inline vdouble trunc(const vdouble &a) { return ::trunc(a.v); }
+GM_SIMD_API inline vdouble round(const vdouble &a) { return ::nearbyint(a.v); }
+
+GM_SIMD_API inline vdouble fmadd(const vdouble &a, const vdouble &b, const vdouble &c) { return a.v * b.v + c.v; }
+
+
+GM_SIMD_API inline vint operator+(const vint &a, const vint &b) { return a.v + b.v; }
+GM_SIMD_API inline vint operator-(const vint &a, const vint &b) { return a.v - b.v; }
+GM_SIMD_API inline vint operator*(const vint &a, const vint &b) { return a.v * b.v; }
+GM_SIMD_API inline vint operator&(const vint &a, const vint &b) { return a.v & b.v; }
+GM_SIMD_API inline vint operator|(const vint &a, const vint &b) { return a.v | b.v; }
+GM_SIMD_API inline vint operator^(const vint &a, const vint &b) { return a.v ^ b.v; }
+
+GM_SIMD_API inline vmask operator==(const vint &a, const vint &b) { return (a.v == b.v); }
+GM_SIMD_API inline vmask operator>(const vint &a, const vint &b) { return (a.v > b.v); }
+GM_SIMD_API inline vmask operator<(const vint &a, const vint &b) { return (a.v < b.v); }
+
+GM_SIMD_API inline vint select(const vmask &m, const vint &a, const vint &b) { return (m.m ? a : b); }
+
+GM_SIMD_API inline vint min(const vint &a, const vint &b) { return ((a.v < b.v) ? a : b); }
+GM_SIMD_API inline vint max(const vint &a, const vint &b) { return ((a.v > b.v) ? a : b); }
+
+template<int N> GM_SIMD_API inline vint sll(const vint &a) { return static_cast<int>(static_cast<unsigned int>(a.v) << N); }
+template<int N> GM_SIMD_API inline vint srl(const vint &a) { return static_cast<int>(static_cast<unsigned int>(a.v) >> N); }
+template<int N> GM_SIMD_API inline vint sra(const vint &a) { return (a.v >> N); }
+
+GM_SIMD_API inline vint sll(const vint &a, int n) { return static_cast<int>(static_cast<unsigned int>(a.v) << n); }
+GM_SIMD_API inline vint srl(const vint &a, int n) { return static_cast<int>(static_cast<unsigned int>(a.v) >> n); }
+
+GM_SIMD_API inline vfloat toFloat(const vint &a) { return static_cast<float>(a.v); }
+GM_SIMD_API inline vint toInt(const vfloat &a) { return static_cast<int>(a.v); }
+
+GM_SIMD_API inline vfloat asFloat(const vint &a) { float f; memcpy(&f, &a.v, sizeof(f)); return f; }
+GM_SIMD_API inline vint asInt(const vfloat &a) { int i; memcpy(&i, &a.v, sizeof(i)); return i; }
+
+GM_SIMD_API inline vfloat gather(const float *base, const vint &index) { return base[index.v]; }
+
+GM_SIMD_API inline vdouble _gm_pow2i(const vdouble &n)
+{
+	const double biased = n.v + 4503599627371519.0;
+
+	unsigned long long bits;
+	memcpy(&bits, &biased, sizeof(bits));
+	bits <<= 52;
+
+	double result;
+	memcpy(&result, &bits, sizeof(result));
+
+	return result;
+}
+
+
+#endif
+
+
+// Maps a scalar type to its vector type, i.e.
+// vector<float>::type is vfloat.
+template<typename T> struct vector;
+template<> struct vector<float> { typedef vfloat type; typedef vmask mask; };
+template<> struct vector<double> { typedef vdouble type; typedef vmaskd mask; };
+
+
+// Loads/stores the first count (< width) elements. This
+// is used for the tails of the batch functions, so that
+// every element goes through the same vector code.
+
+template<typename V> GM_SIMD_API inline V loadPartial(const typename V::scalar *p, size_t count)
+{
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) typename V::scalar buffer[V::width] = {};
+	memcpy(buffer, p, count * sizeof(typename V::scalar));
+	return V::load(buffer);
+}
+
+template<typename V> GM_SIMD_API inline void storePartial(const V &v, typename V::scalar *p, size_t count)
+{
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) typename V::scalar buffer[V::width];
+	v.store(buffer);
+	memcpy(p, buffer, count * sizeof(typename V::scalar));
+}
+
+
+GM_SIMD_API inline vfloat clamp(const vfloat &x, const vfloat &min, const vfloat &max)
+{
+	return simd::min(simd::max(x, min), max);
+}
+
+GM_SIMD_API inline vdouble clamp(const vdouble &x, const vdouble &min, const vdouble &max)
+{
+	return simd::min(simd::max(x, min), max);
+}
+
+
+// exp2(), log2() and pow() for floats, using the polynomials from the
+// Cephes Math Library, with a max relative error of about 2E-7 (for
+// pow() the error of log2() is scaled by y). exp2() clamps x to
+// [-126;127], and log2() and pow() only handle x > 0.
+//
+// exp2() for doubles has a max relative error of about 2E-16, and
+// clamps x to [-1022;1023].
+//
+// Reference: http://www.netlib.org/cephes/
+
+GM_SIMD_API inline vfloat exp2(const vfloat &x)
+{
+	const vfloat clamped = clamp(x, vfloat(-126.0f), vfloat(127.0f));
+
+	const vfloat n = round(clamped);
+	const vfloat f = clamped - n;
+
+	vfloat p = vfloat(1.535336188319500E-4f);
+	p = fmadd(p, f, vfloat(1.339887440266574E-3f));
+	p = fmadd(p, f, vfloat(9.618437357674640E-3f));
+	p = fmadd(p, f, vfloat(5.550332471162809E-2f));
+	p = fmadd(p, f, vfloat(2.402264791363012E-1f));
+	p = fmadd(p, f, vfloat(6.931472028550421E-1f));
+	p = fmadd(p, f, vfloat(1.0f));
+
+	return p * asFloat(sll<23>(toInt(n) + vint(127)));
+}
+
+GM_SIMD_API inline vfloat log2(const vfloat &x)
+{
+	const vint bits = asInt(x);
+
+	vfloat e = toFloat(srl<23>(bits) - vint(127));
+	vfloat m = asFloat((bits & vint(0x007FFFFF)) | vint(0x3F800000));
+
+	// Keep the mantissa within [sqrt(1/2);sqrt(2)]
+	const vmask big = (m > vfloat(1.41421356237f));
+	e = select(big, e + vfloat(1.0f), e);
+	m = select(big, m * vfloat(0.5f), m);
+
+	const vfloat f = m - vfloat(1.0f);
+	const vfloat z = f * f;
+
+	vfloat p = vfloat(7.0376836292E-2f);
+	p = fmadd(p, f, vfloat(-1.1514610310E-1f));
+	p = fmadd(p, f, vfloat(1.1676998740E-1f));
+	p = fmadd(p, f, vfloat(-1.2420140846E-1f));
+	p = fmadd(p, f, vfloat(1.4249322787E-1f));
+	p = fmadd(p, f, vfloat(-1.6668057665E-1f));
+	p = fmadd(p, f, vfloat(2.0000714765E-1f));
+	p = fmadd(p, f, vfloat(-2.4999993993E-1f));
+	p = fmadd(p, f, vfloat(3.3333331174E-1f));
+
+	const vfloat ln = f + (f * z * p - vfloat(0.5f) * z);
+
+	return fmadd(ln, vfloat(1.44269504088896341f), e);
+}
+
+GM_SIMD_API inline vfloat pow(const vfloat &x, const vfloat &y)
+{
+	return exp2(log2(x) * y);
+}
+
+GM_SIMD_API inline vdouble exp2(const vdouble &x)
+{
+	const vdouble clamped = clamp(x, vdouble(-1022.0), vdouble(1023.0));
+
+	const vdouble n = round(clamped);
+	const vdouble f = clamped - n;
+	const vdouble z = f * f;
+
+	vdouble p = vdouble(2.30933477057345225087E-2);
+	p = fmadd(p, z, vdouble(2.02020656693165307700E1));
+	p = fmadd(p, z, vdouble(1.51390680115615096133E3));
+	p = p * f;
+
+	vdouble q = z + vdouble(2.33184211722314911771E2);
+	q = fmadd(q, z, vdouble(4.36821166879210612817E3));
+
+	const vdouble r = vdouble(1.0) + vdouble(2.0) * p / (q - p);
+
+	return r * _gm_pow2i(n);
+}
+
+
+// The accuracy of the templated versions of sincos(), atan(), atan2()
+// and asin(), which trade accuracy for speed. The functions without
+// the template argument are Precise.
+//
+//   Precise - about 1 ulp (a few ulp for asin() close to 1)
+//   Medium  - max absolute error of about 1E-5
+//   Fast    - max absolute error of about 6E-4 (2E-4 for sincos())
+enum class Accuracy
+{
+	Precise,
+	Medium,
+	Fast,
+};
+
+
+// sin() and cos() for floats and doubles, using the polynomials and
+// the reduction by pi/4 of the Cephes Math Library. The error is about
+// 1 ulp for |x| < 8192 (floats) and |x| < 1E8 (doubles), beyond that
+// the accuracy degrades with the reduction.
+//
+// The octant is computed in floating-point, such that the same code
+// handles both precisions without converting to integers. sincos()
+// computes both at the cost of one.
+
+GM_SIMD_API inline vfloat _gm_sin_poly(const vfloat &x, const vfloat &z)
+{
+	vfloat p = vfloat(-1.9515295891E-4f);
+	p = fmadd(p, z, vfloat(8.3321608736E-3f));
+	p = fmadd(p, z, vfloat(-1.6666654611E-1f));
+
+	return fmadd(p * z, x, x);
+}
+
+GM_SIMD_API inline vfloat _gm_cos_poly(const vfloat &z)
+{
+	vfloat p = vfloat(2.443315711809948E-5f);
+	p = fmadd(p, z, vfloat(-1.388731625493765E-3f));
+	p = fmadd(p, z, vfloat(4.166664568298827E-2f));
+
+	return p * z * z - vfloat(0.5f) * z + vfloat(1.0f);
+}
+
+GM_SIMD_API inline vdouble _gm_sin_poly(const vdouble &x, const vdouble &z)
+{
+	vdouble p = vdouble(1.58962301576546568060E-10);
+	p = fmadd(p, z, vdouble(-2.50507477628578072866E-8));
+	p = fmadd(p, z, vdouble(2.75573136213857245213E-6));
+	p = fmadd(p, z, vdouble(-1.98412698295895385996E-4));
+	p = fmadd(p, z, vdouble(8.33333333332211858878E-3));
+	p = fmadd(p, z, vdouble(-1.66666666666666307295E-1));
+
+	return fmadd(p * z, x, x);
+}
+
+GM_SIMD_API inline vdouble _gm_cos_poly(const vdouble &z)
+{
+	vdouble p = vdouble(-1.13585365213876817300E-11);
+	p = fmadd(p, z, vdouble(2.08757008419747316778E-9));
+	p = fmadd(p, z, vdouble(-2.75573141792967388112E-7));
+	p = fmadd(p, z, vdouble(2.48015872888517045348E-5));
+	p = fmadd(p, z, vdouble(-1.38888888888730564116E-3));
+	p = fmadd(p, z, vdouble(4.16666666666665929218E-2));
+
+	return p * z * z - vdouble(0.5) * z + vdouble(1.0);
+}
+
+// The Medium and Fast polynomials are minimax fits on [0;pi/4]
+// (degree 5 and 4 respectively 3 and 4, with the Fast cos() fixed
+// to 1 at 0), and the reduction splits pi/4 in 2 parts (Cody-Waite),
+// which keeps either of them accurate for |x| up to about 1E4.
+template<Accuracy accuracy, typename V> GM_SIMD_API inline V _gm_sin_poly(const V &x, const V &z)
+{
+	typedef typename V::scalar T;
+
+	if (accuracy == Accuracy::Fast)
+		return fmadd(V(T(-1.6034391506E-1)) * z, x, V(T(9.9903141340E-1)) * x);
+
+	if (accuracy == Accuracy::Medium)
+		return fmadd(fmadd(V(T(8.1215577458E-3)), z, V(T(-1.6660162010E-1))) * z, x, V(T(9.9999499767E-1)) * x);
+
+	return _gm_sin_poly(x, z);
+}
+
+template<Accuracy accuracy, typename V> GM_SIMD_API inline V _gm_cos_poly(const V &z)
+{
+	typedef typename V::scalar T;
+
+	if (accuracy == Accuracy::Fast)
+		return fmadd(fmadd(V(T(4.0488903767E-2)), z, V(T(-4.9977629511E-1))), z, V(T(1)));
+
+	if (accuracy == Accuracy::Medium)
+		return fmadd(fmadd(V(T(4.0398832489E-2)), z, V(T(-4.9970837196E-1))), z, V(T(9.9999007100E-1)));
+
+	return _gm_cos_poly(z);
+}
+
+template<Accuracy accuracy, typename V> GM_SIMD_API inline void _gm_sincos(const V &x, V *s, V *c)
+{
+	typedef typename V::scalar T;
+
+	// The extra precise pi/4, split into 3 parts
+	const T DP1 = (sizeof(T) == sizeof(float)) ? T(0.78515625) : T(7.85398125648498535156E-1);
+	const T DP2 = (sizeof(T) == sizeof(float)) ? T(2.4187564849853515625E-4) : T(3.77489470793079817668E-8);
+	const T DP3 = (sizeof(T) == sizeof(float)) ? T(3.77489497744594108E-8) : T(2.69515142907905952645E-15);
+
+	// The last 2 parts combined, for the Medium and Fast reduction
+	const T DP23 = (sizeof(T) == sizeof(float)) ? T(2.4191339744830963E-4) : T(3.77489497744594108E-8);
+
+	const V ax = abs(x);
+
+	// The nearest even multiple of pi/4, i.e. the quadrant times 2
+	const V y = V(T(2)) * floor((ax * V(T(1.27323954473516268615)) + V(T(1))) * V(T(0.5)));
+	const V quadrant = y * V(T(0.5)) - V(T(4)) * floor(y * V(T(0.125)));
+
+	const V r = (accuracy == Accuracy::Precise) ? (((ax - y * V(DP1)) - y * V(DP2)) - y * V(DP3)) : ((ax - y * V(DP1)) - y * V(DP23));
+	const V z = r * r;
+
+	const V ps = _gm_sin_poly<accuracy>(r, z);
+	const V pc = _gm_cos_poly<accuracy>(z);
+
+	// Quadrant 1 and 3 swap sin and cos, 2 and 3 negate
+	// sin, and 1 and 2 negate cos
+	const auto odd = ((quadrant - V(T(2)) * floor(quadrant * V(T(0.5)))) > V(T(0.5)));
+	const auto negateSin = (quadrant > V(T(1.5))) ^ (x < V(T(0)));
+	const auto negateCos = (quadrant > V(T(0.5))) & (quadrant < V(T(2.5)));
+
+	if (s)
+	{
+		const V sine = select(odd, pc, ps);
+		*s = select(negateSin, -sine, sine);
+	}
+
+	if (c)
+	{
+		const V cosine = select(odd, ps, pc);
+		*c = select(negateCos, -cosine, cosine);
+	}
+}
+
+GM_SIMD_API inline vfloat sin(const vfloat &x) { vfloat s; _gm_sincos<Accuracy::Precise>(x, &s, static_cast<vfloat*>(nullptr)); return s; }
+GM_SIMD_API inline vfloat cos(const vfloat &x) { vfloat c; _gm_sincos<Accuracy::Precise>(x, static_cast<vfloat*>(nullptr), &c); return c; }
+
+GM_SIMD_API inline vdouble sin(const vdouble &x) { vdouble s; _gm_sincos<Accuracy::Precise>(x, &s, static_cast<vdouble*>(nullptr)); return s; }
+GM_SIMD_API inline vdouble cos(const vdouble &x) { vdouble c; _gm_sincos<Accuracy::Precise>(x, static_cast<vdouble*>(nullptr), &c); return c; }
+
+GM_SIMD_API inline void sincos(const vfloat &x, vfloat *s, vfloat *c) { _gm_sincos<Accuracy::Precise>(x, s, c); }
+GM_SIMD_API inline void sincos(const vdouble &x, vdouble *s, vdouble *c) { _gm_sincos<Accuracy::Precise>(x, s, c); }
+
+template<Accuracy accuracy, typename V> GM_SIMD_API inline void sincos(const V &x, V *s, V *c) { _gm_sincos<accuracy>(x, s, c); }
+
+
+// atan(), atan2() and asin() for floats and doubles. Precise uses
+// the polynomial (floats) and rational function (doubles) of the
+// Cephes Math Library, Medium and Fast minimax polynomials of degree
+// 9 and 5. All of them evaluate atan() on [0;1], by dividing the
+// smaller of |x| and |y| by the larger, and then unfold the octant.
+// asin(x) is atan2(x, sqrt((1 - x) * (1 + x))).
+//
+// atan2(0, 0) is 0, infinities are not handled.
+
+GM_SIMD_API inline vfloat _gm_atan01(const vfloat &x)
+{
+	// atan(x) = pi/4 + atan((x - 1) / (x + 1)), for x > tan(pi/8)
+	const vmask reduce = (x > vfloat(0.4142135623730950f));
+
+	const vfloat a = select(reduce, (x - vfloat(1.0f)) / (x + vfloat(1.0f)), x);
+	const vfloat z = a * a;
+
+	vfloat p = vfloat(8.05374449538E-2f);
+	p = fmadd(p, z, vfloat(-1.38776856032E-1f));
+	p = fmadd(p, z, vfloat(1.99777106478E-1f));
+	p = fmadd(p, z, vfloat(-3.33329491539E-1f));
+
+	return fmadd(p * z, a, a) + select(reduce, vfloat(0.78539816339744830962f), vfloat(0.0f));
+}
+
+GM_SIMD_API inline vdouble _gm_atan01(const vdouble &x)
+{
+	// atan(x) = pi/4 + atan((x - 1) / (x + 1)), for x > 0.66
+	const vmaskd reduce = (x > vdouble(0.66));
+
+	const vdouble a = select(reduce, (x - vdouble(1.0)) / (x + vdouble(1.0)), x);
+	const vdouble z = a * a;
+
+	vdouble p = vdouble(-8.750608600031904122785E-1);
+	p = fmadd(p, z, vdouble(-1.615753718733365076637E1));
+	p = fmadd(p, z, vdouble(-7.500855792314704667340E1));
+	p = fmadd(p, z, vdouble(-1.228866684490136173410E2));
+	p = fmadd(p, z, vdouble(-6.485021904942025371773E1));
+
+	vdouble q = z + vdouble(2.485846490142306297962E1);
+	q = fmadd(q, z, vdouble(1.650270098316988542046E2));
+	q = fmadd(q, z, vdouble(4.328810604912902668951E2));
+	q = fmadd(q, z, vdouble(4.853903996359136964868E2));
+	q = fmadd(q, z, vdouble(1.945506571482613964425E2));
+
+	// pi/4 split into 2 parts, the second being added last
+	const vdouble y = fmadd(z * p / q, a, a) + select(reduce, vdouble(3.061616997868382943065E-17), vdouble(0.0));
+
+	return y + select(reduce, vdouble(7.85398163397448309616E-1), vdouble(0.0));
+}
+
+template<Accuracy accuracy, typename V> GM_SIMD_API inline V _gm_atan01(const V &x)
+{
+	typedef typename V::scalar T;
+
+	const V z = x * x;
+
+	if (accuracy == Accuracy::Fast)
+	{
+		V p = V(T(7.9338453956E-2));
+		p = fmadd(p, z, V(T(-2.8868968840E-1)));
+		p = fmadd(p, z, V(T(9.9535787784E-1)));
+
+		return p * x;
+	}
+
+	if (accuracy == Accuracy::Medium)
+	{
+		V p = V(T(2.0844953374E-2));
+		p = fmadd(p, z, V(T(-8.5156050233E-2)));
+		p = fmadd(p, z, V(T(1.8015912247E-1)));
+		p = fmadd(p, z, V(T(-3.3030475663E-1)));
+		p = fmadd(p, z, V(T(9.9986632956E-1)));
+
+		return p * x;
+	}
+
+	return _gm_atan01(x);
+}
+
+template<Accuracy accuracy, typename V> GM_SIMD_API inline V atan2(const V &y, const V &x)
+{
+	typedef typename V::scalar T;
+
+	const V ax = abs(x);
+	const V ay = abs(y);
+
+	const V large = max(ax, ay);
+	const V small = min(ax, ay);
+
+	V r = _gm_atan01<accuracy>(select(large > V(T(0)), small / large, V(T(0))));
+
+	r = select(ay > ax, V(T(1.57079632679489661923)) - r, r);
+	r = select(x < V(T(0)), V(T(3.14159265358979323846)) - r, r);
+
+	return select(y < V(T(0)), -r, r);
+}
+
+template<Accuracy accuracy, typename V> GM_SIMD_API inline V atan(const V &x)
+{
+	typedef typename V::scalar T;
+
+	return atan2<accuracy>(x, V(T(1)));
+}
+
+template<Accuracy accuracy, typename V> GM_SIMD_API inline V asin(const V &x)
+{
+	typedef typename V::scalar T;
+
+	return atan2<accuracy>(x, sqrt((V(T(1)) - x) * (V(T(1)) + x)));
+}
+
+GM_SIMD_API inline vfloat atan(const vfloat &x) { return atan<Accuracy::Precise>(x); }
+GM_SIMD_API inline vfloat atan2(const vfloat &y, const vfloat &x) { return atan2<Accuracy::Precise>(y, x); }
+GM_SIMD_API inline vfloat asin(const vfloat &x) { return asin<Accuracy::Precise>(x); }
+
+GM_SIMD_API inline vdouble atan(const vdouble &x) { return atan<Accuracy::Precise>(x); }
+GM_SIMD_API inline vdouble atan2(const vdouble &y, const vdouble &x) { return atan2<Accuracy::Precise>(y, x); }
+GM_SIMD_API inline vdouble asin(const vdouble &x) { return asin<Accuracy::Precise>(x); }
+
+
+}
+
+#ifndef GM_NO_NAMESPACE
+}
+#endif
+
+
+#endif
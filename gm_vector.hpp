@@ -0,0 +1,737 @@
+
+// Author: Christian Vallentin <mail@vallentinsource.com>
+// Website: http://vallentinsource.com
+// Repository: https://github.com/MrVallentin/GameMath
+//
+// Date Created: October 18, 2026
+// Last Modified: October 18, 2026
+
+// Copyright (c) 2012-2016 Christian Vallentin <mail@vallentinsource.com>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+
+// Refrain from using any exposed macros, functions
+// or structs prefixed with an underscore. As these
+// are only intended for internal purposes. Which
+// additionally means they can be removed, renamed
+// or changed between minor updates without notice.
+
+// This library contains the vec2, vec3 and vec4 float vector types,
+// which are each stored in a single SSE register, as well as vec3xN,
+// which stores GM_SIMD_FLOAT_WIDTH vec3s as a struct of arrays.
+//
+// They can be used as T with the templates of gm_math.hpp, e.g. lerp(),
+// map(), normalize(), smoothstep(), bilerp(), fract(), nearest() and
+// smoothDamp(), as abs(), floor(), ceil(), round(), min(), max() and
+// clamp() are specialized for them, and sqrt() is found by
+// argument-dependent lookup.
+
+#ifndef GM_VECTOR_HPP
+#define GM_VECTOR_HPP
+
+
+#ifndef GM_STRINGIFY_VERSION
+#	define _GM_STRINGIFY(str) #str
+#	define _GM_STRINGIFY_TOKEN(str) _GM_STRINGIFY(str)
+#	define GM_STRINGIFY_VERSION(major, minor, patch) _GM_STRINGIFY(major) "." _GM_STRINGIFY(minor) "." _GM_STRINGIFY(patch)
+#endif
+
+
+#define GM_VECTOR_NAME "GameMath Vector"
+
+#define GM_VECTOR_VERSION_MAJOR 1
+#define GM_VECTOR_VERSION_MINOR 0
+#define GM_VECTOR_VERSION_PATCH 0
+
+#define GM_VECTOR_VERSION GM_STRINGIFY_VERSION(GM_VECTOR_VERSION_MAJOR, GM_VECTOR_VERSION_MINOR, GM_VECTOR_VERSION_PATCH)
+
+#define GM_VECTOR_NAME_VERSION GM_VECTOR_NAME " " GM_VECTOR_VERSION
+
+
+#include <math.h>
+#include <stddef.h>
+
+#include "gm_math.hpp"
+#include "gm_simd.hpp"
+
+
+#define GM_VECTOR_API static
+
+
+#ifndef GM_NO_NAMESPACE
+namespace gm {
+#endif
+
+
+// 4 floats, and the result of comparing them. These are
+// SSE registers, unless gm_simd.hpp uses the scalar fallback.
+#if !defined(GM_SIMD_SCALAR)
+typedef __m128 _gm_vec_reg;
+typedef __m128 _gm_vec_mask;
+#else
+struct _gm_vec_reg { float f[4]; };
+struct _gm_vec_mask { bool b[4]; };
+#endif
+
+
+// A vector of N (2, 3 or 4) floats, stored in all 4 lanes of a
+// register. The lanes beyond N are padding, and their values are
+// unspecified.
+//
+// Floats convert implicitly, by broadcasting them to all components,
+// such that mixed arithmetic works and e.g. T(0.5) compiles in the
+// templates of gm_math.hpp. Comparisons give a vecmask with a lane
+// per component, which is used with select(), any() and all().
+template<int N> struct vec
+{
+	static_assert((N >= 2) && (N <= 4), "vec only supports 2, 3 and 4 components");
+
+	_gm_vec_reg v;
+
+	vec() = default;
+	vec(const _gm_vec_reg &v) : v(v) {}
+	vec(float s);
+	vec(float x, float y);
+	vec(float x, float y, float z);
+	vec(float x, float y, float z, float w);
+
+	// Loads/stores N floats, p doesn't need to be aligned.
+	static vec load(const float *p);
+	void store(float *p) const;
+
+	float x() const;
+	float y() const;
+	float z() const;
+	float w() const;
+
+	float operator[](int i) const;
+
+	vec& operator+=(const vec &b);
+	vec& operator-=(const vec &b);
+	vec& operator*=(const vec &b);
+	vec& operator/=(const vec &b);
+};
+
+typedef vec<2> vec2;
+typedef vec<3> vec3;
+typedef vec<4> vec4;
+
+
+template<int N> struct vecmask
+{
+	_gm_vec_mask m;
+
+	vecmask() = default;
+	vecmask(const _gm_vec_mask &m) : m(m) {}
+};
+
+
+template<int N> GM_VECTOR_API vec<N> operator+(const vec<N> &a, const vec<N> &b);
+template<int N> GM_VECTOR_API vec<N> operator-(const vec<N> &a, const vec<N> &b);
+template<int N> GM_VECTOR_API vec<N> operator*(const vec<N> &a, const vec<N> &b);
+template<int N> GM_VECTOR_API vec<N> operator/(const vec<N> &a, const vec<N> &b);
+template<int N> GM_VECTOR_API vec<N> operator-(const vec<N> &a);
+
+template<int N> GM_VECTOR_API vec<N> operator+(const vec<N> &a, float b);
+template<int N> GM_VECTOR_API vec<N> operator-(const vec<N> &a, float b);
+template<int N> GM_VECTOR_API vec<N> operator*(const vec<N> &a, float b);
+template<int N> GM_VECTOR_API vec<N> operator/(const vec<N> &a, float b);
+
+template<int N> GM_VECTOR_API vec<N> operator+(float a, const vec<N> &b);
+template<int N> GM_VECTOR_API vec<N> operator-(float a, const vec<N> &b);
+template<int N> GM_VECTOR_API vec<N> operator*(float a, const vec<N> &b);
+template<int N> GM_VECTOR_API vec<N> operator/(float a, const vec<N> &b);
+
+template<int N> GM_VECTOR_API vecmask<N> operator<(const vec<N> &a, const vec<N> &b);
+template<int N> GM_VECTOR_API vecmask<N> operator<=(const vec<N> &a, const vec<N> &b);
+template<int N> GM_VECTOR_API vecmask<N> operator>(const vec<N> &a, const vec<N> &b);
+template<int N> GM_VECTOR_API vecmask<N> operator>=(const vec<N> &a, const vec<N> &b);
+template<int N> GM_VECTOR_API vecmask<N> operator==(const vec<N> &a, const vec<N> &b);
+template<int N> GM_VECTOR_API vecmask<N> operator!=(const vec<N> &a, const vec<N> &b);
+
+template<int N> GM_VECTOR_API vecmask<N> operator&(const vecmask<N> &a, const vecmask<N> &b);
+template<int N> GM_VECTOR_API vecmask<N> operator|(const vecmask<N> &a, const vecmask<N> &b);
+template<int N> GM_VECTOR_API vecmask<N> operator~(const vecmask<N> &a);
+
+// Only the first N lanes are considered.
+template<int N> GM_VECTOR_API bool any(const vecmask<N> &m);
+template<int N> GM_VECTOR_API bool all(const vecmask<N> &m);
+
+// Picks a where m is set, otherwise b.
+template<int N> GM_VECTOR_API vec<N> select(const vecmask<N> &m, const vec<N> &a, const vec<N> &b);
+
+
+template<int N> GM_VECTOR_API vec<N> sqrt(const vec<N> &x);
+
+// The components are summed in order, i.e. dot() gives the
+// same result as x * x + y * y + z * z with floats.
+template<int N> GM_VECTOR_API float dot(const vec<N> &a, const vec<N> &b);
+template<int N> GM_VECTOR_API float length(const vec<N> &x);
+
+GM_VECTOR_API vec3 cross(const vec3 &a, const vec3 &b);
+
+
+// GM_SIMD_FLOAT_WIDTH vec3s stored as a struct of arrays, i.e. x holds
+// the x components of all of them. Every operation handles all of them
+// at once, with the same number of instructions one vec3 would take.
+//
+// Unlike vec, converting a float or a vec3 (by broadcasting it to all
+// of them) is explicit, as mixed arithmetic with simd::vfloat would
+// otherwise be ambiguous.
+struct vec3xN
+{
+	enum { width = GM_SIMD_FLOAT_WIDTH };
+
+	simd::vfloat x, y, z;
+
+	vec3xN() = default;
+	vec3xN(const simd::vfloat &x, const simd::vfloat &y, const simd::vfloat &z) : x(x), y(y), z(z) {}
+	explicit vec3xN(float s) : x(s), y(s), z(s) {}
+	explicit vec3xN(const vec3 &v);
+
+	// Loads/stores width elements of separate x, y and z
+	// arrays, which don't need to be aligned.
+	static vec3xN load(const float *x, const float *y, const float *z);
+	void store(float *x, float *y, float *z) const;
+
+	// Converts from/to width vec3s.
+	static vec3xN gather(const vec3 *v);
+	void scatter(vec3 *v) const;
+
+	vec3xN& operator+=(const vec3xN &b);
+	vec3xN& operator-=(const vec3xN &b);
+	vec3xN& operator*=(const vec3xN &b);
+	vec3xN& operator/=(const vec3xN &b);
+};
+
+
+GM_VECTOR_API vec3xN operator+(const vec3xN &a, const vec3xN &b);
+GM_VECTOR_API vec3xN operator-(const vec3xN &a, const vec3xN &b);
+GM_VECTOR_API vec3xN operator*(const vec3xN &a, const vec3xN &b);
+GM_VECTOR_API vec3xN operator/(const vec3xN &a, const vec3xN &b);
+GM_VECTOR_API vec3xN operator-(const vec3xN &a);
+
+// Scales each vec3 by its lane of s.
+GM_VECTOR_API vec3xN operator*(const vec3xN &a, const simd::vfloat &s);
+GM_VECTOR_API vec3xN operator*(const simd::vfloat &s, const vec3xN &a);
+GM_VECTOR_API vec3xN operator/(const vec3xN &a, const simd::vfloat &s);
+
+GM_VECTOR_API vec3xN select(const simd::vmask &m, const vec3xN &a, const vec3xN &b);
+
+GM_VECTOR_API vec3xN sqrt(const vec3xN &x);
+
+GM_VECTOR_API simd::vfloat dot(const vec3xN &a, const vec3xN &b);
+GM_VECTOR_API simd::vfloat length(const vec3xN &x);
+
+GM_VECTOR_API vec3xN cross(const vec3xN &a, const vec3xN &b);
+
+
+// Specializations of the gm_math.hpp templates, which
+// otherwise compare the vectors as a whole.
+
+template<> inline vec2 abs(const vec2 &x);
+template<> inline vec3 abs(const vec3 &x);
+template<> inline vec4 abs(const vec4 &x);
+template<> inline vec3xN abs(const vec3xN &x);
+
+template<> inline vec2 ceil(const vec2 &x);
+template<> inline vec3 ceil(const vec3 &x);
+template<> inline vec4 ceil(const vec4 &x);
+template<> inline vec3xN ceil(const vec3xN &x);
+
+template<> inline vec2 floor(const vec2 &x);
+template<> inline vec3 floor(const vec3 &x);
+template<> inline vec4 floor(const vec4 &x);
+template<> inline vec3xN floor(const vec3xN &x);
+
+template<> inline vec2 round(const vec2 &x);
+template<> inline vec3 round(const vec3 &x);
+template<> inline vec4 round(const vec4 &x);
+template<> inline vec3xN round(const vec3xN &x);
+
+template<> inline vec2 max(const vec2 &a, const vec2 &b);
+template<> inline vec3 max(const vec3 &a, const vec3 &b);
+template<> inline vec4 max(const vec4 &a, const vec4 &b);
+template<> inline vec3xN max(const vec3xN &a, const vec3xN &b);
+
+template<> inline vec2 min(const vec2 &a, const vec2 &b);
+template<> inline vec3 min(const vec3 &a, const vec3 &b);
+template<> inline vec4 min(const vec4 &a, const vec4 &b);
+template<> inline vec3xN min(const vec3xN &a, const vec3xN &b);
+
+template<> inline vec2 clamp(const vec2 &x, const vec2 &min, const vec2 &max);
+template<> inline vec3 clamp(const vec3 &x, const vec3 &min, const vec3 &max);
+template<> inline vec4 clamp(const vec4 &x, const vec4 &min, const vec4 &max);
+template<> inline vec3xN clamp(const vec3xN &x, const vec3xN &min, const vec3xN &max);
+
+
+// After this point everything you'll see is all
+// the definitions to the prior declarations.
+
+
+#if !defined(GM_SIMD_SCALAR)
+
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_set1(float s) { return _mm_set1_ps(s); }
+GM_VECTOR_API inline void _gm_vec_store(float *p, const _gm_vec_reg &a) { _mm_store_ps(p, a); }
+
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_add(const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_add_ps(a, b); }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_sub(const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_sub_ps(a, b); }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_mul(const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_mul_ps(a, b); }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_div(const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_div_ps(a, b); }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_neg(const _gm_vec_reg &a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_lt(const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_cmplt_ps(a, b); }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_le(const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_cmple_ps(a, b); }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_gt(const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_cmpgt_ps(a, b); }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_ge(const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_cmpge_ps(a, b); }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_eq(const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_cmpeq_ps(a, b); }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_neq(const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_cmpneq_ps(a, b); }
+
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_and(const _gm_vec_mask &a, const _gm_vec_mask &b) { return _mm_and_ps(a, b); }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_or(const _gm_vec_mask &a, const _gm_vec_mask &b) { return _mm_or_ps(a, b); }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_not(const _gm_vec_mask &a) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+GM_VECTOR_API inline int _gm_vec_bits(const _gm_vec_mask &a) { return _mm_movemask_ps(a); }
+
+#if defined(__SSE4_1__)
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_select(const _gm_vec_mask &m, const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_blendv_ps(b, a, m); }
+#else
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_select(const _gm_vec_mask &m, const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+#endif
+
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_min(const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_min_ps(a, b); }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_max(const _gm_vec_reg &a, const _gm_vec_reg &b) { return _mm_max_ps(a, b); }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_abs(const _gm_vec_reg &a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_sqrt(const _gm_vec_reg &a) { return _mm_sqrt_ps(a); }
+
+#if defined(__SSE4_1__)
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_floor(const _gm_vec_reg &a) { return _mm_round_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_ceil(const _gm_vec_reg &a) { return _mm_round_ps(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_trunc(const _gm_vec_reg &a) { return _mm_round_ps(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+#else
+// Floats of 2^23 and above have no fractional part,
+// and don't fit the conversion to int either
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_trunc(const _gm_vec_reg &a)
+{
+	const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+	return _gm_vec_select(_mm_cmplt_ps(_gm_vec_abs(a), _mm_set1_ps(8388608.0f)), t, a);
+}
+
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_floor(const _gm_vec_reg &a)
+{
+	const __m128 t = _gm_vec_trunc(a);
+	return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.0f)));
+}
+
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_ceil(const _gm_vec_reg &a)
+{
+	const __m128 t = _gm_vec_trunc(a);
+	return _mm_add_ps(t, _mm_and_ps(_mm_cmplt_ps(t, a), _mm_set1_ps(1.0f)));
+}
+#endif
+
+// Rounds halfway cases away from zero, like round()
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_round(const _gm_vec_reg &a)
+{
+	const __m128 t = _gm_vec_trunc(a);
+	const __m128 one = _mm_or_ps(_mm_and_ps(a, _mm_set1_ps(-0.0f)), _mm_set1_ps(1.0f));
+
+	return _mm_add_ps(t, _mm_and_ps(_mm_cmpge_ps(_gm_vec_abs(_mm_sub_ps(a, t)), _mm_set1_ps(0.5f)), one));
+}
+
+// (y, z, x, w)
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_yzx(const _gm_vec_reg &a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)); }
+
+template<int N> GM_VECTOR_API inline float _gm_vec_sum(const _gm_vec_reg &a)
+{
+	__m128 s = _mm_add_ss(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)));
+
+	if (N > 2)
+		s = _mm_add_ss(s, _mm_movehl_ps(a, a));
+
+	if (N > 3)
+		s = _mm_add_ss(s, _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)));
+
+	return _mm_cvtss_f32(s);
+}
+
+#else
+
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_set(float x, float y, float z, float w) { _gm_vec_reg r = { { x, y, z, w } }; return r; }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_set1(float s) { return _gm_vec_set(s, s, s, s); }
+GM_VECTOR_API inline void _gm_vec_store(float *p, const _gm_vec_reg &a) { for (int i = 0; i < 4; ++i) p[i] = a.f[i]; }
+
+#define _GM_VEC_LANES(result, expr) do { for (int i = 0; i < 4; ++i) result[i] = (expr); } while (0)
+
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_add(const _gm_vec_reg &a, const _gm_vec_reg &b) { _gm_vec_reg r; _GM_VEC_LANES(r.f, a.f[i] + b.f[i]); return r; }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_sub(const _gm_vec_reg &a, const _gm_vec_reg &b) { _gm_vec_reg r; _GM_VEC_LANES(r.f, a.f[i] - b.f[i]); return r; }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_mul(const _gm_vec_reg &a, const _gm_vec_reg &b) { _gm_vec_reg r; _GM_VEC_LANES(r.f, a.f[i] * b.f[i]); return r; }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_div(const _gm_vec_reg &a, const _gm_vec_reg &b) { _gm_vec_reg r; _GM_VEC_LANES(r.f, a.f[i] / b.f[i]); return r; }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_neg(const _gm_vec_reg &a) { _gm_vec_reg r; _GM_VEC_LANES(r.f, -a.f[i]); return r; }
+
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_lt(const _gm_vec_reg &a, const _gm_vec_reg &b) { _gm_vec_mask r; _GM_VEC_LANES(r.b, a.f[i] < b.f[i]); return r; }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_le(const _gm_vec_reg &a, const _gm_vec_reg &b) { _gm_vec_mask r; _GM_VEC_LANES(r.b, a.f[i] <= b.f[i]); return r; }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_gt(const _gm_vec_reg &a, const _gm_vec_reg &b) { _gm_vec_mask r; _GM_VEC_LANES(r.b, a.f[i] > b.f[i]); return r; }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_ge(const _gm_vec_reg &a, const _gm_vec_reg &b) { _gm_vec_mask r; _GM_VEC_LANES(r.b, a.f[i] >= b.f[i]); return r; }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_eq(const _gm_vec_reg &a, const _gm_vec_reg &b) { _gm_vec_mask r; _GM_VEC_LANES(r.b, a.f[i] == b.f[i]); return r; }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_neq(const _gm_vec_reg &a, const _gm_vec_reg &b) { _gm_vec_mask r; _GM_VEC_LANES(r.b, a.f[i] != b.f[i]); return r; }
+
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_and(const _gm_vec_mask &a, const _gm_vec_mask &b) { _gm_vec_mask r; _GM_VEC_LANES(r.b, a.b[i] && b.b[i]); return r; }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_or(const _gm_vec_mask &a, const _gm_vec_mask &b) { _gm_vec_mask r; _GM_VEC_LANES(r.b, a.b[i] || b.b[i]); return r; }
+GM_VECTOR_API inline _gm_vec_mask _gm_vec_not(const _gm_vec_mask &a) { _gm_vec_mask r; _GM_VEC_LANES(r.b, !a.b[i]); return r; }
+GM_VECTOR_API inline int _gm_vec_bits(const _gm_vec_mask &a) { return (a.b[0] ? 1 : 0) | (a.b[1] ? 2 : 0) | (a.b[2] ? 4 : 0) | (a.b[3] ? 8 : 0); }
+
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_select(const _gm_vec_mask &m, const _gm_vec_reg &a, const _gm_vec_reg &b) { _gm_vec_reg r; _GM_VEC_LANES(r.f, m.b[i] ? a.f[i] : b.f[i]); return r; }
+
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_min(const _gm_vec_reg &a, const _gm_vec_reg &b) { _gm_vec_reg r; _GM_VEC_LANES(r.f, (a.f[i] < b.f[i]) ? a.f[i] : b.f[i]); return r; }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_max(const _gm_vec_reg &a, const _gm_vec_reg &b) { _gm_vec_reg r; _GM_VEC_LANES(r.f, (a.f[i] > b.f[i]) ? a.f[i] : b.f[i]); return r; }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_abs(const _gm_vec_reg &a) { _gm_vec_reg r; _GM_VEC_LANES(r.f, ::fabsf(a.f[i])); return r; }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_sqrt(const _gm_vec_reg &a) { _gm_vec_reg r; _GM_VEC_LANES(r.f, ::sqrtf(a.f[i])); return r; }
+
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_floor(const _gm_vec_reg &a) { _gm_vec_reg r; _GM_VEC_LANES(r.f, ::floorf(a.f[i])); return r; }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_ceil(const _gm_vec_reg &a) { _gm_vec_reg r; _GM_VEC_LANES(r.f, ::ceilf(a.f[i])); return r; }
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_round(const _gm_vec_reg &a) { _gm_vec_reg r; _GM_VEC_LANES(r.f, ::roundf(a.f[i])); return r; }
+
+GM_VECTOR_API inline _gm_vec_reg _gm_vec_yzx(const _gm_vec_reg &a) { return _gm_vec_set(a.f[1], a.f[2], a.f[0], a.f[3]); }
+
+#undef _GM_VEC_LANES
+
+template<int N> GM_VECTOR_API inline float _gm_vec_sum(const _gm_vec_reg &a)
+{
+	float s = a.f[0];
+
+	for (int i = 1; i < N; ++i)
+		s += a.f[i];
+
+	return s;
+}
+
+#endif
+
+
+template<int N> inline vec<N>::vec(float s)
+	: v(_gm_vec_set1(s))
+{
+}
+
+template<int N> inline vec<N>::vec(float x, float y)
+	: v(_gm_vec_set(x, y, 0.0f, 0.0f))
+{
+	static_assert(N == 2, "vec2 takes 2 components");
+}
+
+template<int N> inline vec<N>::vec(float x, float y, float z)
+	: v(_gm_vec_set(x, y, z, 0.0f))
+{
+	static_assert(N == 3, "vec3 takes 3 components");
+}
+
+template<int N> inline vec<N>::vec(float x, float y, float z, float w)
+	: v(_gm_vec_set(x, y, z, w))
+{
+	static_assert(N == 4, "vec4 takes 4 components");
+}
+
+
+template<int N> inline vec<N> vec<N>::load(const float *p)
+{
+	return _gm_vec_set(p[0], p[1], (N > 2) ? p[2] : 0.0f, (N > 3) ? p[3] : 0.0f);
+}
+
+template<int N> inline void vec<N>::store(float *p) const
+{
+	GM_SIMD_ALIGN(16) float lanes[4];
+	_gm_vec_store(lanes, v);
+
+	for (int i = 0; i < N; ++i)
+		p[i] = lanes[i];
+}
+
+
+template<int N> inline float vec<N>::x() const
+{
+	return (*this)[0];
+}
+
+template<int N> inline float vec<N>::y() const
+{
+	return (*this)[1];
+}
+
+template<int N> inline float vec<N>::z() const
+{
+	static_assert(N >= 3, "vec2 has no z component");
+	return (*this)[2];
+}
+
+template<int N> inline float vec<N>::w() const
+{
+	static_assert(N >= 4, "Only vec4 has a w component");
+	return (*this)[3];
+}
+
+
+template<int N> inline float vec<N>::operator[](int i) const
+{
+	GM_SIMD_ALIGN(16) float lanes[4];
+	_gm_vec_store(lanes, v);
+
+	return lanes[i];
+}
+
+
+template<int N> inline vec<N>& vec<N>::operator+=(const vec &b)
+{
+	return (*this = *this + b);
+}
+
+template<int N> inline vec<N>& vec<N>::operator-=(const vec &b)
+{
+	return (*this = *this - b);
+}
+
+template<int N> inline vec<N>& vec<N>::operator*=(const vec &b)
+{
+	return (*this = *this * b);
+}
+
+template<int N> inline vec<N>& vec<N>::operator/=(const vec &b)
+{
+	return (*this = *this / b);
+}
+
+
+template<int N> GM_VECTOR_API inline vec<N> operator+(const vec<N> &a, const vec<N> &b) { return _gm_vec_add(a.v, b.v); }
+template<int N> GM_VECTOR_API inline vec<N> operator-(const vec<N> &a, const vec<N> &b) { return _gm_vec_sub(a.v, b.v); }
+template<int N> GM_VECTOR_API inline vec<N> operator*(const vec<N> &a, const vec<N> &b) { return _gm_vec_mul(a.v, b.v); }
+template<int N> GM_VECTOR_API inline vec<N> operator/(const vec<N> &a, const vec<N> &b) { return _gm_vec_div(a.v, b.v); }
+template<int N> GM_VECTOR_API inline vec<N> operator-(const vec<N> &a) { return _gm_vec_neg(a.v); }
+
+template<int N> GM_VECTOR_API inline vec<N> operator+(const vec<N> &a, float b) { return a + vec<N>(b); }
+template<int N> GM_VECTOR_API inline vec<N> operator-(const vec<N> &a, float b) { return a - vec<N>(b); }
+template<int N> GM_VECTOR_API inline vec<N> operator*(const vec<N> &a, float b) { return a * vec<N>(b); }
+template<int N> GM_VECTOR_API inline vec<N> operator/(const vec<N> &a, float b) { return a / vec<N>(b); }
+
+template<int N> GM_VECTOR_API inline vec<N> operator+(float a, const vec<N> &b) { return vec<N>(a) + b; }
+template<int N> GM_VECTOR_API inline vec<N> operator-(float a, const vec<N> &b) { return vec<N>(a) - b; }
+template<int N> GM_VECTOR_API inline vec<N> operator*(float a, const vec<N> &b) { return vec<N>(a) * b; }
+template<int N> GM_VECTOR_API inline vec<N> operator/(float a, const vec<N> &b) { return vec<N>(a) / b; }
+
+template<int N> GM_VECTOR_API inline vecmask<N> operator<(const vec<N> &a, const vec<N> &b) { return _gm_vec_lt(a.v, b.v); }
+template<int N> GM_VECTOR_API inline vecmask<N> operator<=(const vec<N> &a, const vec<N> &b) { return _gm_vec_le(a.v, b.v); }
+template<int N> GM_VECTOR_API inline vecmask<N> operator>(const vec<N> &a, const vec<N> &b) { return _gm_vec_gt(a.v, b.v); }
+template<int N> GM_VECTOR_API inline vecmask<N> operator>=(const vec<N> &a, const vec<N> &b) { return _gm_vec_ge(a.v, b.v); }
+template<int N> GM_VECTOR_API inline vecmask<N> operator==(const vec<N> &a, const vec<N> &b) { return _gm_vec_eq(a.v, b.v); }
+template<int N> GM_VECTOR_API inline vecmask<N> operator!=(const vec<N> &a, const vec<N> &b) { return _gm_vec_neq(a.v, b.v); }
+
+template<int N> GM_VECTOR_API inline vecmask<N> operator&(const vecmask<N> &a, const vecmask<N> &b) { return _gm_vec_and(a.m, b.m); }
+template<int N> GM_VECTOR_API inline vecmask<N> operator|(const vecmask<N> &a, const vecmask<N> &b) { return _gm_vec_or(a.m, b.m); }
+template<int N> GM_VECTOR_API inline vecmask<N> operator~(const vecmask<N> &a) { return _gm_vec_not(a.m); }
+
+template<int N> GM_VECTOR_API inline bool any(const vecmask<N> &m) { return ((_gm_vec_bits(m.m) & ((1 << N) - 1)) != 0); }
+template<int N> GM_VECTOR_API inline bool all(const vecmask<N> &m) { return ((_gm_vec_bits(m.m) & ((1 << N) - 1)) == ((1 << N) - 1)); }
+
+template<int N> GM_VECTOR_API inline vec<N> select(const vecmask<N> &m, const vec<N> &a, const vec<N> &b) { return _gm_vec_select(m.m, a.v, b.v); }
+
+
+template<int N> GM_VECTOR_API inline vec<N> sqrt(const vec<N> &x)
+{
+	return _gm_vec_sqrt(x.v);
+}
+
+
+template<int N> GM_VECTOR_API inline float dot(const vec<N> &a, const vec<N> &b)
+{
+	return _gm_vec_sum<N>(_gm_vec_mul(a.v, b.v));
+}
+
+template<int N> GM_VECTOR_API inline float length(const vec<N> &x)
+{
+	return ::sqrtf(dot(x, x));
+}
+
+
+// a * b.yzx - a.yzx * b gives the cross product as (z, x, y)
+GM_VECTOR_API inline vec3 cross(const vec3 &a, const vec3 &b)
+{
+	return _gm_vec_yzx(_gm_vec_sub(_gm_vec_mul(a.v, _gm_vec_yzx(b.v)), _gm_vec_mul(_gm_vec_yzx(a.v), b.v)));
+}
+
+
+inline vec3xN::vec3xN(const vec3 &v)
+	: x(v.x())
+	, y(v.y())
+	, z(v.z())
+{
+}
+
+
+inline vec3xN vec3xN::load(const float *x, const float *y, const float *z)
+{
+	return vec3xN(simd::vfloat::loadu(x), simd::vfloat::loadu(y), simd::vfloat::loadu(z));
+}
+
+inline void vec3xN::store(float *x, float *y, float *z) const
+{
+	this->x.storeu(x);
+	this->y.storeu(y);
+	this->z.storeu(z);
+}
+
+
+inline vec3xN vec3xN::gather(const vec3 *v)
+{
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float xs[width];
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float ys[width];
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float zs[width];
+
+	for (size_t i = 0; i < width; ++i)
+	{
+		GM_SIMD_ALIGN(16) float lanes[4];
+		_gm_vec_store(lanes, v[i].v);
+
+		xs[i] = lanes[0];
+		ys[i] = lanes[1];
+		zs[i] = lanes[2];
+	}
+
+	return vec3xN(simd::vfloat::load(xs), simd::vfloat::load(ys), simd::vfloat::load(zs));
+}
+
+inline void vec3xN::scatter(vec3 *v) const
+{
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float xs[width];
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float ys[width];
+	GM_SIMD_ALIGN(GM_SIMD_ALIGNMENT) float zs[width];
+
+	x.store(xs);
+	y.store(ys);
+	z.store(zs);
+
+	for (size_t i = 0; i < width; ++i)
+		v[i] = vec3(xs[i], ys[i], zs[i]);
+}
+
+
+inline vec3xN& vec3xN::operator+=(const vec3xN &b)
+{
+	return (*this = *this + b);
+}
+
+inline vec3xN& vec3xN::operator-=(const vec3xN &b)
+{
+	return (*this = *this - b);
+}
+
+inline vec3xN& vec3xN::operator*=(const vec3xN &b)
+{
+	return (*this = *this * b);
+}
+
+inline vec3xN& vec3xN::operator/=(const vec3xN &b)
+{
+	return (*this = *this / b);
+}
+
+
+GM_VECTOR_API inline vec3xN operator+(const vec3xN &a, const vec3xN &b) { return vec3xN(a.x + b.x, a.y + b.y, a.z + b.z); }
+GM_VECTOR_API inline vec3xN operator-(const vec3xN &a, const vec3xN &b) { return vec3xN(a.x - b.x, a.y - b.y, a.z - b.z); }
+GM_VECTOR_API inline vec3xN operator*(const vec3xN &a, const vec3xN &b) { return vec3xN(a.x * b.x, a.y * b.y, a.z * b.z); }
+GM_VECTOR_API inline vec3xN operator/(const vec3xN &a, const vec3xN &b) { return vec3xN(a.x / b.x, a.y / b.y, a.z / b.z); }
+GM_VECTOR_API inline vec3xN operator-(const vec3xN &a) { return vec3xN(-a.x, -a.y, -a.z); }
+
+GM_VECTOR_API inline vec3xN operator*(const vec3xN &a, const simd::vfloat &s) { return vec3xN(a.x * s, a.y * s, a.z * s); }
+GM_VECTOR_API inline vec3xN operator*(const simd::vfloat &s, const vec3xN &a) { return vec3xN(s * a.x, s * a.y, s * a.z); }
+GM_VECTOR_API inline vec3xN operator/(const vec3xN &a, const simd::vfloat &s) { return vec3xN(a.x / s, a.y / s, a.z / s); }
+
+GM_VECTOR_API inline vec3xN select(const simd::vmask &m, const vec3xN &a, const vec3xN &b)
+{
+	return vec3xN(simd::select(m, a.x, b.x), simd::select(m, a.y, b.y), simd::select(m, a.z, b.z));
+}
+
+
+GM_VECTOR_API inline vec3xN sqrt(const vec3xN &x)
+{
+	return vec3xN(simd::sqrt(x.x), simd::sqrt(x.y), simd::sqrt(x.z));
+}
+
+
+GM_VECTOR_API inline simd::vfloat dot(const vec3xN &a, const vec3xN &b)
+{
+	return simd::fmadd(a.z, b.z, simd::fmadd(a.y, b.y, a.x * b.x));
+}
+
+GM_VECTOR_API inline simd::vfloat length(const vec3xN &x)
+{
+	return simd::sqrt(dot(x, x));
+}
+
+
+GM_VECTOR_API inline vec3xN cross(const vec3xN &a, const vec3xN &b)
+{
+	return vec3xN(
+		a.y * b.z - a.z * b.y,
+		a.z * b.x - a.x * b.z,
+		a.x * b.y - a.y * b.x);
+}
+
+
+template<> inline vec2 abs(const vec2 &x) { return _gm_vec_abs(x.v); }
+template<> inline vec3 abs(const vec3 &x) { return _gm_vec_abs(x.v); }
+template<> inline vec4 abs(const vec4 &x) { return _gm_vec_abs(x.v); }
+template<> inline vec3xN abs(const vec3xN &x) { return vec3xN(simd::abs(x.x), simd::abs(x.y), simd::abs(x.z)); }
+
+template<> inline vec2 ceil(const vec2 &x) { return _gm_vec_ceil(x.v); }
+template<> inline vec3 ceil(const vec3 &x) { return _gm_vec_ceil(x.v); }
+template<> inline vec4 ceil(const vec4 &x) { return _gm_vec_ceil(x.v); }
+template<> inline vec3xN ceil(const vec3xN &x) { return vec3xN(simd::ceil(x.x), simd::ceil(x.y), simd::ceil(x.z)); }
+
+template<> inline vec2 floor(const vec2 &x) { return _gm_vec_floor(x.v); }
+template<> inline vec3 floor(const vec3 &x) { return _gm_vec_floor(x.v); }
+template<> inline vec4 floor(const vec4 &x) { return _gm_vec_floor(x.v); }
+template<> inline vec3xN floor(const vec3xN &x) { return vec3xN(simd::floor(x.x), simd::floor(x.y), simd::floor(x.z)); }
+
+template<> inline vec2 round(const vec2 &x) { return _gm_vec_round(x.v); }
+template<> inline vec3 round(const vec3 &x) { return _gm_vec_round(x.v); }
+template<> inline vec4 round(const vec4 &x) { return _gm_vec_round(x.v); }
+template<> inline vec3xN round(const vec3xN &x) { return vec3xN(_gm_math_round(x.x), _gm_math_round(x.y), _gm_math_round(x.z)); }
+
+template<> inline vec2 max(const vec2 &a, const vec2 &b) { return _gm_vec_max(a.v, b.v); }
+template<> inline vec3 max(const vec3 &a, const vec3 &b) { return _gm_vec_max(a.v, b.v); }
+template<> inline vec4 max(const vec4 &a, const vec4 &b) { return _gm_vec_max(a.v, b.v); }
+template<> inline vec3xN max(const vec3xN &a, const vec3xN &b) { return vec3xN(simd::max(a.x, b.x), simd::max(a.y, b.y), simd::max(a.z, b.z)); }
+
+template<> inline vec2 min(const vec2 &a, const vec2 &b) { return _gm_vec_min(a.v, b.v); }
+template<> inline vec3 min(const vec3 &a, const vec3 &b) { return _gm_vec_min(a.v, b.v); }
+template<> inline vec4 min(const vec4 &a, const vec4 &b) { return _gm_vec_min(a.v, b.v); }
+template<> inline vec3xN min(const vec3xN &a, const vec3xN &b) { return vec3xN(simd::min(a.x, b.x), simd::min(a.y, b.y), simd::min(a.z, b.z)); }
+
+template<> inline vec2 clamp(const vec2 &x, const vec2 &min, const vec2 &max) { return _gm_vec_min(_gm_vec_max(x.v, min.v), max.v); }
+template<> inline vec3 clamp(const vec3 &x, const vec3 &min, const vec3 &max) { return _gm_vec_min(_gm_vec_max(x.v, min.v), max.v); }
+template<> inline vec4 clamp(const vec4 &x, const vec4 &min, const vec4 &max) { return _gm_vec_min(_gm_vec_max(x.v, min.v), max.v); }
+template<> inline vec3xN clamp(const vec3xN &x, const vec3xN &min, const vec3xN &max) { return vec3xN(simd::clamp(x.x, min.x, max.x), simd::clamp(x.y, min.y, max.y), simd::clamp(x.z, min.z, max.z)); }
+
+
+#ifndef GM_NO_NAMESPACE
+}
+#endif
+
+
+#endif
@@ -0,0 +1,49 @@
+// Checks shared by the tests. Every test is a standalone program,
+// which prints the failed checks and returns non-zero if any failed.
+
+#ifndef GM_TEST_HPP
+#define GM_TEST_HPP
+
+
+#include <stdio.h>
+#include <math.h>
+
+
+static int _gm_test_failures = 0;
+
+
+#define GM_CHECK(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			if (_gm_test_failures++ < 20) \
+				printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+		} \
+	} \
+	while (0)
+
+#define GM_CHECK_NEAR(a, b, tolerance) \
+	do \
+	{ \
+		const double _gm_a = static_cast<double>(a); \
+		const double _gm_b = static_cast<double>(b); \
+		if (!(fabs(_gm_a - _gm_b) <= (tolerance))) \
+		{ \
+			if (_gm_test_failures++ < 20) \
+				printf("%s:%d: check failed: %s = %.9g, %s = %.9g\n", __FILE__, __LINE__, #a, _gm_a, #b, _gm_b); \
+		} \
+	} \
+	while (0)
+
+
+static int gm_test_result()
+{
+	if (_gm_test_failures != 0)
+		printf("%d checks failed\n", _gm_test_failures);
+
+	return (_gm_test_failures != 0) ? 1 : 0;
+}
+
+
+#endif
@@ -0,0 +1,168 @@
+// Checks composite() against the Porter-Duff formulas in double
+// precision, for every mode, both alpha modes, 8-bit and float, with
+// runs of transparent and opaque source pixels, and the tile version.
+//
+//   g++ -std=c++11 -O2 -I.. test_color_composite.cpp -o test_color_composite -pthread
+
+#include "gm_math.hpp"
+#include "gm_color.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdlib.h>
+#include <vector>
+
+
+// The source and destination factors (Fa, Fb) of every mode,
+// where 0 = zero, 1 = one, 2 = alpha, 3 = one minus alpha
+static const int factors[13][2] =
+{
+	{ 0, 0 }, { 1, 0 }, { 0, 1 }, { 1, 3 }, { 3, 1 }, { 2, 0 }, { 0, 2 },
+	{ 3, 0 }, { 0, 3 }, { 2, 3 }, { 3, 2 }, { 3, 3 }, { 1, 1 },
+};
+
+static double factor(int f, double alpha)
+{
+	return (f == 0) ? 0.0 : ((f == 1) ? 1.0 : ((f == 2) ? alpha : (1.0 - alpha)));
+}
+
+// Composites premultiplied src onto dst, in [0;1]
+static void reference(int mode, const double src[4], const double dst[4], double result[4])
+{
+	const double fa = factor(factors[mode][0], dst[3]);
+	const double fb = factor(factors[mode][1], src[3]);
+
+	for (int c = 0; c < 4; ++c)
+		result[c] = gm::clamp(src[c] * fa + dst[c] * fb, 0.0, 1.0);
+}
+
+
+int main()
+{
+	const size_t n = 1003;
+
+	std::vector<unsigned char> src(n * 4), dst(n * 4);
+
+	srand(1);
+
+	for (size_t i = 0; i < (n * 4); ++i)
+	{
+		src[i] = static_cast<unsigned char>(rand());
+		dst[i] = static_cast<unsigned char>(rand());
+	}
+
+	// Runs of 8 transparent, 8 opaque and 8 translucent pixels
+	for (size_t i = 0; i < n; ++i)
+	{
+		if (((i / 8) % 3) == 0) src[i * 4 + 3] = 0;
+		if (((i / 8) % 3) == 1) src[i * 4 + 3] = 255;
+	}
+
+	std::vector<unsigned char> premultipliedSrc = src, premultipliedDst = dst;
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		for (int c = 0; c < 3; ++c)
+		{
+			premultipliedSrc[i * 4 + c] = static_cast<unsigned char>(src[i * 4 + c] * src[i * 4 + 3] / 255);
+			premultipliedDst[i * 4 + c] = static_cast<unsigned char>(dst[i * 4 + c] * dst[i * 4 + 3] / 255);
+		}
+	}
+
+	for (int mode = 0; mode < 13; ++mode)
+	{
+		const gm::CompositeMode compositeMode = static_cast<gm::CompositeMode>(mode);
+
+		std::vector<unsigned char> result8 = premultipliedDst;
+		gm::composite(premultipliedSrc.data(), result8.data(), n, compositeMode, gm::AlphaMode::Premultiplied);
+
+		std::vector<float> srcf(n * 4), resultf(n * 4);
+
+		for (size_t i = 0; i < (n * 4); ++i)
+		{
+			srcf[i] = premultipliedSrc[i] / 255.0f;
+			resultf[i] = premultipliedDst[i] / 255.0f;
+		}
+
+		gm::composite(srcf.data(), resultf.data(), n, compositeMode, gm::AlphaMode::Premultiplied);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			double s[4], d[4], expected[4];
+
+			for (int c = 0; c < 4; ++c)
+			{
+				s[c] = premultipliedSrc[i * 4 + c] / 255.0;
+				d[c] = premultipliedDst[i * 4 + c] / 255.0;
+			}
+
+			reference(mode, s, d, expected);
+
+			for (int c = 0; c < 4; ++c)
+			{
+				GM_CHECK_NEAR(result8[i * 4 + c], expected[c] * 255.0, 1.0);
+				GM_CHECK_NEAR(resultf[i * 4 + c], expected[c], 1E-5);
+			}
+		}
+
+		// Straight alpha is the premultiplied result divided by its alpha
+		std::vector<float> straightSrc(n * 4), straightResult(n * 4);
+
+		for (size_t i = 0; i < (n * 4); ++i)
+		{
+			straightSrc[i] = src[i] / 255.0f;
+			straightResult[i] = dst[i] / 255.0f;
+		}
+
+		gm::composite(straightSrc.data(), straightResult.data(), n, compositeMode, gm::AlphaMode::Straight);
+
+		std::vector<unsigned char> straightResult8 = dst;
+		gm::composite(src.data(), straightResult8.data(), n, compositeMode, gm::AlphaMode::Straight);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			double s[4], d[4], expected[4];
+
+			s[3] = src[i * 4 + 3] / 255.0;
+			d[3] = dst[i * 4 + 3] / 255.0;
+
+			for (int c = 0; c < 3; ++c)
+			{
+				s[c] = src[i * 4 + c] / 255.0 * s[3];
+				d[c] = dst[i * 4 + c] / 255.0 * d[3];
+			}
+
+			reference(mode, s, d, expected);
+
+			GM_CHECK_NEAR(straightResult[i * 4 + 3], expected[3], 1E-5);
+			GM_CHECK_NEAR(straightResult8[i * 4 + 3], expected[3] * 255.0, 1.0);
+
+			if (expected[3] > 1E-3)
+			{
+				for (int c = 0; c < 3; ++c)
+				{
+					GM_CHECK_NEAR(straightResult[i * 4 + c], gm::clamp(expected[c] / expected[3], 0.0, 1.0), 1E-3);
+
+					// The 8-bit version rounds the premultiplied colors (more than
+					// once), and an error of 1 there is 1 / alpha once divided
+					GM_CHECK_NEAR(straightResult8[i * 4 + c], straightResult[i * 4 + c] * 255.0f, 1.0 + 2.0 / expected[3]);
+				}
+			}
+		}
+	}
+
+	// The tile version is the same as compositing every scanline,
+	// with strides larger than the width
+	const size_t width = 13, height = 7, stride = 17;
+
+	std::vector<unsigned char> tile = premultipliedDst, rows = premultipliedDst;
+
+	gm::composite(premultipliedSrc.data(), stride, tile.data(), stride, width, height);
+
+	for (size_t y = 0; y < height; ++y)
+		gm::composite(premultipliedSrc.data() + y * stride * 4, rows.data() + y * stride * 4, width);
+
+	GM_CHECK(tile == rows);
+
+	return gm_test_result();
+}
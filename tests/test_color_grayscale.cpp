@@ -0,0 +1,73 @@
+// Checks the fixed-point batch grayscale() against its documented
+// formulas and the real luma weights, for RGB and RGBA pixels and
+// both weightings, and the scalar grayscale<int>() for wide ranges.
+//
+//   g++ -std=c++11 -O2 -I.. test_color_grayscale.cpp -o test_color_grayscale -pthread
+
+#include "gm_color.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdlib.h>
+#include <vector>
+
+
+int main()
+{
+	const int weights[2][3] = { { 9798, 19235, 3735 }, { 6966, 23436, 2366 } };
+	const double exact[2][3] = { { 0.299, 0.587, 0.114 }, { 0.2126, 0.7152, 0.0722 } };
+
+	const size_t counts[] = { 1, 15, 16, 17, 33, 1000 };
+
+	srand(1);
+
+	for (int channels = 3; channels <= 4; ++channels)
+	{
+		for (size_t k = 0; k < (sizeof(counts) / sizeof(*counts)); ++k)
+		{
+			for (int w = 0; w < 2; ++w)
+			{
+				const size_t n = counts[k];
+
+				std::vector<unsigned char> pixels(n * channels);
+
+				for (size_t i = 0; i < pixels.size(); ++i)
+					pixels[i] = static_cast<unsigned char>(rand());
+
+				// White must give exactly the max value
+				pixels[0] = pixels[1] = pixels[2] = 255;
+
+				std::vector<unsigned char> gray8(n);
+				std::vector<unsigned short> gray16(n);
+
+				gm::grayscale(pixels.data(), gray8.data(), n, channels, static_cast<gm::LumaWeights>(w));
+				gm::grayscale(pixels.data(), gray16.data(), n, channels, static_cast<gm::LumaWeights>(w));
+
+				GM_CHECK(gray8[0] == 255);
+				GM_CHECK(gray16[0] == 65535);
+
+				for (size_t i = 0; i < n; ++i)
+				{
+					const unsigned char *p = pixels.data() + i * channels;
+					const unsigned int sum = weights[w][0] * p[0] + weights[w][1] * p[1] + weights[w][2] * p[2];
+
+					GM_CHECK(gray8[i] == ((sum + 16384) >> 15));
+					GM_CHECK(gray16[i] == ((sum * 257 + 16384) >> 15));
+
+					GM_CHECK_NEAR(gray8[i], exact[w][0] * p[0] + exact[w][1] * p[1] + exact[w][2] * p[2], 0.51);
+				}
+			}
+		}
+	}
+
+	GM_CHECK(gm::grayscale<int>(255, 255, 255) == 255);
+	GM_CHECK(gm::grayscale<int>(0, 0, 0) == 0);
+
+	// Any range, without overflowing
+	GM_CHECK(gm::grayscale<int>(100000, 100000, 100000) == 100000);
+	GM_CHECK(gm::grayscale<int>(2000000000, 2000000000, 2000000000) == 2000000000);
+	GM_CHECK(gm::grayscale<int>(1000000, 0, 0) == ((1000000LL * 6966 + 16384) >> 15));
+	GM_CHECK(gm::grayscale<int>(-255, -255, -255) == -255);
+
+	return gm_test_result();
+}
@@ -0,0 +1,102 @@
+// Checks the batch hue2rgb(), hsl2rgb(), rgb2hsl() and rgb2hcv()
+// against the scalar templates, for counts that aren't a multiple
+// of the vector width, and the interleaved versions.
+//
+//   g++ -std=c++11 -O2 -I.. test_color_hsl.cpp -o test_color_hsl -pthread
+
+#include "gm_color.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdlib.h>
+#include <vector>
+
+
+int main()
+{
+	const size_t n = 1003;
+
+	std::vector<float> r(n), g(n), b(n), rgba(n * 4);
+
+	srand(1);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		r[i] = rand() / static_cast<float>(RAND_MAX);
+		g[i] = rand() / static_cast<float>(RAND_MAX);
+		b[i] = rand() / static_cast<float>(RAND_MAX);
+
+		// Grays and equal channels hit the hue edge cases
+		if ((i % 7) == 0) g[i] = r[i];
+		if ((i % 11) == 0) b[i] = g[i];
+
+		rgba[i * 4 + 0] = r[i];
+		rgba[i * 4 + 1] = g[i];
+		rgba[i * 4 + 2] = b[i];
+		rgba[i * 4 + 3] = 0.5f;
+	}
+
+	std::vector<float> h(n), s(n), l(n), c(n), v(n), hsla(n * 4);
+
+	gm::rgb2hsl(r.data(), g.data(), b.data(), h.data(), s.data(), l.data(), n);
+	gm::rgb2hcv(r.data(), g.data(), b.data(), nullptr, c.data(), v.data(), n);
+	gm::rgb2hsl(rgba.data(), hsla.data(), n, 4);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		float H, S, L, C, V;
+
+		gm::rgb2hsl<float>(r[i], g[i], b[i], &H, &S, &L);
+		GM_CHECK_NEAR(h[i], H, 1E-5);
+		GM_CHECK_NEAR(l[i], L, 1E-5);
+
+		if ((L > 1E-3f) && (L < (1.0f - 1E-3f)))
+			GM_CHECK_NEAR(s[i], S, 1E-5);
+
+		gm::rgb2hcv<float>(r[i], g[i], b[i], &H, &C, &V);
+		GM_CHECK_NEAR(c[i], C, 1E-5);
+		GM_CHECK_NEAR(v[i], V, 1E-5);
+
+		GM_CHECK_NEAR(hsla[i * 4 + 0], h[i], 1E-5);
+		GM_CHECK_NEAR(hsla[i * 4 + 2], l[i], 1E-5);
+		GM_CHECK(hsla[i * 4 + 3] == 0.5f);
+	}
+
+	std::vector<float> R(n), G(n), B(n);
+
+	gm::hsl2rgb(h.data(), s.data(), l.data(), R.data(), G.data(), B.data(), n);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		float x, y, z;
+		gm::hsl2rgb<float>(h[i], s[i], l[i], &x, &y, &z);
+
+		GM_CHECK_NEAR(R[i], x, 1E-5);
+		GM_CHECK_NEAR(G[i], y, 1E-5);
+		GM_CHECK_NEAR(B[i], z, 1E-5);
+	}
+
+	gm::hue2rgb(h.data(), R.data(), G.data(), B.data(), n);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		float x, y, z;
+		gm::hue2rgb<float>(h[i], &x, &y, &z);
+
+		GM_CHECK_NEAR(R[i], x, 1E-5);
+		GM_CHECK_NEAR(G[i], y, 1E-5);
+		GM_CHECK_NEAR(B[i], z, 1E-5);
+	}
+
+	// In place, and back to the original colors
+	gm::hsl2rgb(hsla.data(), hsla.data(), n, 4);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		GM_CHECK_NEAR(hsla[i * 4 + 0], r[i], 1E-4);
+		GM_CHECK_NEAR(hsla[i * 4 + 1], g[i], 1E-4);
+		GM_CHECK_NEAR(hsla[i * 4 + 2], b[i], 1E-4);
+	}
+
+	return gm_test_result();
+}
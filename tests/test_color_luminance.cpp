@@ -0,0 +1,161 @@
+// Checks luminanceStats() against computing the luma of every pixel
+// on its own, for the 8-bit and float versions, the percentiles
+// against sorting the luma, and an empty image.
+//
+//   g++ -std=c++11 -O2 -I.. test_color_luminance.cpp -o test_color_luminance -pthread
+
+#include "gm_color.hpp"
+#include "gm_parallel.hpp"
+
+#include "gm_test.hpp"
+
+#include <algorithm>
+#include <stdlib.h>
+#include <vector>
+
+
+int main()
+{
+	gm::ThreadPool pool(4);
+
+	// Spans several of the 16K pixel ranges given to each thread
+	const size_t n = 100003;
+
+	std::vector<unsigned char> rgba(n * 4);
+
+	srand(1);
+
+	for (size_t i = 0; i < rgba.size(); ++i)
+		rgba[i] = static_cast<unsigned char>(rand() % 200);
+
+	rgba[0] = rgba[1] = rgba[2] = 255;
+
+	for (int channels = 3; channels <= 4; ++channels)
+	{
+		const size_t count = rgba.size() / channels;
+
+		const gm::LuminanceStats stats = gm::luminanceStats(rgba.data(), count, channels, gm::LumaWeights::Rec709, pool);
+
+		std::vector<unsigned char> luma(count);
+		gm::grayscale(rgba.data(), luma.data(), count, channels, gm::LumaWeights::Rec709);
+
+		std::vector<size_t> histogram(256, 0);
+		double sum = 0.0, logSum = 0.0;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			++histogram[luma[i]];
+			sum += luma[i] / 255.0;
+			logSum += log(luma[i] / 255.0 + 1E-4);
+		}
+
+		GM_CHECK(stats.count == count);
+		GM_CHECK(!stats.logarithmic);
+		GM_CHECK(stats.histogram == histogram);
+
+		const unsigned char lowest = *std::min_element(luma.begin(), luma.end());
+
+		GM_CHECK(stats.min == lowest / 255.0f);
+		GM_CHECK(stats.max == 1.0f);
+		GM_CHECK_NEAR(stats.mean, sum / count, 1E-6);
+		GM_CHECK_NEAR(stats.logAverage, exp(logSum / count) - 1E-4, 1E-5);
+
+		// The 8-bit percentiles are exact
+		std::sort(luma.begin(), luma.end());
+
+		const float percentiles[] = { 0.01f, 0.25f, 0.5f, 0.9f, 0.99f };
+
+		for (size_t k = 0; k < (sizeof(percentiles) / sizeof(*percentiles)); ++k)
+		{
+			const size_t rank = static_cast<size_t>(ceil(static_cast<double>(percentiles[k]) * count));
+			GM_CHECK(stats.percentile(percentiles[k]) == luma[rank - 1] / 255.0f);
+		}
+
+		GM_CHECK(stats.percentile(0.0f) == stats.min);
+		GM_CHECK(stats.percentile(1.0f) == stats.max);
+	}
+
+	// HDR values spanning 2^-12 to 2^8
+	std::vector<float> hdr(n * 4);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		const float exposure = exp2f(-12.0f + 20.0f * (rand() / static_cast<float>(RAND_MAX)));
+
+		for (int c = 0; c < 3; ++c)
+			hdr[i * 4 + c] = exposure * (0.5f + 0.5f * (rand() / static_cast<float>(RAND_MAX)));
+
+		hdr[i * 4 + 3] = 1.0f;
+	}
+
+	const float minLog2 = -16.0f, maxLog2 = 16.0f;
+	const size_t bins = 128;
+
+	const gm::LuminanceStats stats = gm::luminanceStats(hdr.data(), n, 4, gm::LumaWeights::Rec601, minLog2, maxLog2, bins, pool);
+
+	std::vector<float> luma(n);
+	std::vector<size_t> histogram(bins, 0);
+
+	double sum = 0.0, logSum = 0.0;
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		const float *p = hdr.data() + i * 4;
+		luma[i] = p[0] * 0.299f + p[1] * 0.587f + p[2] * 0.114f;
+
+		const double l = log2(luma[i] + 1E-4);
+		const int bin = static_cast<int>(floor((l - minLog2) * bins / (maxLog2 - minLog2)));
+
+		++histogram[std::min(std::max(bin, 0), static_cast<int>(bins) - 1)];
+
+		sum += luma[i];
+		logSum += l;
+	}
+
+	GM_CHECK(stats.logarithmic);
+	GM_CHECK(stats.histogram.size() == bins);
+	const float lowest = *std::min_element(luma.begin(), luma.end());
+	const float highest = *std::max_element(luma.begin(), luma.end());
+
+	GM_CHECK_NEAR(stats.min, lowest, 1E-6 * lowest);
+	GM_CHECK_NEAR(stats.max, highest, 1E-6 * highest);
+	GM_CHECK_NEAR(stats.mean, sum / n, 1E-5 * sum / n);
+	GM_CHECK_NEAR(stats.logAverage, exp2(logSum / n) - 1E-4, 1E-4 * exp2(logSum / n));
+
+	// Only the luma close to the edge of a bin may differ
+	size_t moved = 0, total = 0;
+
+	for (size_t bin = 0; bin < bins; ++bin)
+	{
+		moved += (stats.histogram[bin] > histogram[bin]) ? (stats.histogram[bin] - histogram[bin]) : (histogram[bin] - stats.histogram[bin]);
+		total += stats.histogram[bin];
+	}
+
+	GM_CHECK(total == n);
+	GM_CHECK(moved <= (n / 1000));
+
+	// The float percentiles are within the bin
+	std::sort(luma.begin(), luma.end());
+
+	const float binWidth = (maxLog2 - minLog2) / bins;
+
+	for (float p = 0.1f; p < 1.0f; p += 0.2f)
+	{
+		const float expected = luma[static_cast<size_t>(ceil(static_cast<double>(p) * n)) - 1];
+		GM_CHECK_NEAR(log2(stats.percentile(p)), log2(expected), binWidth);
+	}
+
+	// An empty image
+	const gm::LuminanceStats empty = gm::luminanceStats(rgba.data(), 0, 4, gm::LumaWeights::Rec709, pool);
+
+	GM_CHECK(empty.count == 0);
+	GM_CHECK((empty.min == 0.0f) && (empty.max == 0.0f) && (empty.mean == 0.0f));
+	GM_CHECK(empty.percentile(0.5f) == 0.0f);
+
+	const gm::LuminanceStats emptyHDR = gm::luminanceStats(hdr.data(), 0, 4, gm::LumaWeights::Rec709, -16.0f, 16.0f, 256, pool);
+
+	GM_CHECK((emptyHDR.min == 0.0f) && (emptyHDR.logAverage == 0.0f));
+	GM_CHECK(emptyHDR.percentile(0.5f) == 0.0f);
+
+	return gm_test_result();
+}
@@ -0,0 +1,201 @@
+// Checks ColorLUT against applying the transform directly, for both
+// interpolations, that update() only rebakes when the params change
+// or after bake(), and that exceptions thrown by the transform or a
+// parallelFor() task are rethrown on the calling thread.
+//
+//   g++ -std=c++11 -O2 -I.. test_color_lut.cpp -o test_color_lut -pthread
+
+#include "gm_color.hpp"
+#include "gm_parallel.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdexcept>
+#include <stdlib.h>
+#include <vector>
+
+
+struct Params
+{
+	float gain;
+};
+
+
+int main()
+{
+	gm::ThreadPool pool(4);
+
+	// An affine transform is interpolated exactly by both
+	const auto affine = [](float r, float g, float b, float *outR, float *outG, float *outB)
+	{
+		*outR = 0.8f * r + 0.1f * g + 0.1f * b;
+		*outG = 0.2f * r + 0.7f * g + 0.05f;
+		*outB = 1.0f - b;
+	};
+
+	const auto curve = [](float r, float g, float b, float *outR, float *outG, float *outB)
+	{
+		*outR = r * r;
+		*outG = sqrtf(g + 0.01f);
+		*outB = 0.5f * (r + b * b);
+	};
+
+	const size_t n = 1003;
+
+	std::vector<float> r(n), g(n), b(n), rgba(n * 4);
+
+	srand(1);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		r[i] = rand() / static_cast<float>(RAND_MAX);
+		g[i] = rand() / static_cast<float>(RAND_MAX);
+		b[i] = rand() / static_cast<float>(RAND_MAX);
+
+		rgba[i * 4 + 0] = r[i];
+		rgba[i * 4 + 1] = g[i];
+		rgba[i * 4 + 2] = b[i];
+		rgba[i * 4 + 3] = 0.25f;
+	}
+
+	// Neutral colors and the corners of the cube
+	r[0] = g[0] = b[0] = 0.5f;
+	r[1] = g[1] = b[1] = 1.0f;
+	r[2] = g[2] = b[2] = 0.0f;
+
+	gm::ColorLUT lut(17);
+
+	GM_CHECK(lut.size() == 17);
+	GM_CHECK(!lut.baked());
+
+	for (int interpolation = 0; interpolation < 2; ++interpolation)
+	{
+		const gm::LUTInterpolation mode = static_cast<gm::LUTInterpolation>(interpolation);
+
+		std::vector<float> R(n), G(n), B(n);
+
+		lut.bake(affine, pool);
+		GM_CHECK(lut.baked());
+
+		lut.apply(r.data(), g.data(), b.data(), R.data(), G.data(), B.data(), n, mode);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			float x, y, z;
+			affine(r[i], g[i], b[i], &x, &y, &z);
+
+			GM_CHECK_NEAR(R[i], x, 1E-5);
+			GM_CHECK_NEAR(G[i], y, 1E-5);
+			GM_CHECK_NEAR(B[i], z, 1E-5);
+		}
+
+		lut.bake(curve, pool);
+		lut.apply(r.data(), g.data(), b.data(), R.data(), G.data(), B.data(), n, mode);
+
+		for (size_t i = 3; i < n; ++i)
+		{
+			float x, y, z;
+			curve(r[i], g[i], b[i], &x, &y, &z);
+
+			GM_CHECK_NEAR(R[i], x, 2E-3);
+			GM_CHECK_NEAR(G[i], y, 2E-2);
+			GM_CHECK_NEAR(B[i], z, 2E-3);
+		}
+
+		// The interleaved version copies alpha
+		std::vector<float> out(n * 4);
+		lut.apply(rgba.data(), out.data(), n, 4, mode);
+
+		for (size_t i = 3; i < n; ++i)
+		{
+			GM_CHECK_NEAR(out[i * 4 + 0], R[i], 1E-6);
+			GM_CHECK(out[i * 4 + 3] == 0.25f);
+		}
+	}
+
+	// update() bakes when the params change, and after bake()
+	int bakes = 0;
+
+	const auto counted = [&bakes](const Params &params)
+	{
+		return [&bakes, params](float r, float g, float b, float *outR, float *outG, float *outB)
+		{
+			if ((r == 0.0f) && (g == 0.0f) && (b == 0.0f))
+				++bakes;
+
+			*outR = r * params.gain;
+			*outG = g * params.gain;
+			*outB = b * params.gain;
+		};
+	};
+
+	const Params half = { 0.5f }, twice = { 2.0f };
+
+	gm::ColorLUT cached(5);
+
+	GM_CHECK(cached.update(half, counted(half), pool));
+	GM_CHECK(!cached.update(half, counted(half), pool));
+	GM_CHECK(cached.update(twice, counted(twice), pool));
+	GM_CHECK(bakes == 2);
+
+	cached.bake(affine, pool);
+	GM_CHECK(cached.update(twice, counted(twice), pool));
+	GM_CHECK(bakes == 3);
+
+	cached.invalidate();
+	GM_CHECK(cached.update(twice, counted(twice), pool));
+	GM_CHECK(!cached.update(twice, counted(twice), pool));
+	GM_CHECK(bakes == 4);
+
+	// Exceptions are rethrown by the calling thread, and the pool is
+	// still usable afterwards
+	bool caught = false;
+
+	try
+	{
+		lut.bake([](float r, float, float, float*, float*, float*)
+		{
+			if (r > 0.9f)
+				throw std::runtime_error("transform");
+		}, pool);
+	}
+	catch (const std::runtime_error&)
+	{
+		caught = true;
+	}
+
+	GM_CHECK(caught);
+
+	for (int attempt = 0; attempt < 20; ++attempt)
+	{
+		caught = false;
+
+		try
+		{
+			gm::parallelFor(pool, 1000, 1, [](size_t first, size_t last)
+			{
+				for (size_t i = first; i < last; ++i)
+					if ((i % 97) == 13)
+						throw std::runtime_error("task");
+			});
+		}
+		catch (const std::runtime_error&)
+		{
+			caught = true;
+		}
+
+		GM_CHECK(caught);
+	}
+
+	std::vector<int> visited(1000, 0);
+
+	gm::parallelFor(pool, visited.size(), 1, [&visited](size_t first, size_t last)
+	{
+		for (size_t i = first; i < last; ++i)
+			++visited[i];
+	});
+
+	GM_CHECK(visited == std::vector<int>(1000, 1));
+
+	return gm_test_result();
+}
@@ -0,0 +1,75 @@
+// Checks the batch int2rgb() and rgb2int() against the scalar
+// functions, the round trip through floats, and swizzle() between
+// every pair of channel orders.
+//
+//   g++ -std=c++11 -O2 -I.. test_color_pack.cpp -o test_color_pack -pthread
+
+#include "gm_color.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdlib.h>
+#include <vector>
+
+
+int main()
+{
+	const size_t n = 1037;
+
+	std::vector<int> packed(n), repacked(n);
+
+	srand(1);
+
+	for (size_t i = 0; i < n; ++i)
+		packed[i] = static_cast<int>((static_cast<unsigned int>(rand()) << 16) ^ static_cast<unsigned int>(rand()));
+
+	std::vector<unsigned char> r(n), g(n), b(n), a(n);
+
+	gm::int2rgb(packed.data(), r.data(), g.data(), b.data(), a.data(), n);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		int R, G, B, A;
+		gm::int2rgb(packed[i], &R, &G, &B, &A);
+
+		GM_CHECK((R == r[i]) && (G == g[i]) && (B == b[i]) && (A == a[i]));
+	}
+
+	gm::rgb2int(r.data(), g.data(), b.data(), a.data(), repacked.data(), n);
+	GM_CHECK(repacked == packed);
+
+	// A missing alpha channel is packed as 255
+	gm::rgb2int(r.data(), g.data(), b.data(), nullptr, repacked.data(), n);
+
+	for (size_t i = 0; i < n; ++i)
+		GM_CHECK(repacked[i] == gm::rgb2int(r[i], g[i], b[i]));
+
+	std::vector<float> fr(n), fg(n), fb(n), fa(n);
+
+	gm::int2rgb(packed.data(), fr.data(), fg.data(), fb.data(), fa.data(), n);
+	gm::rgb2int(fr.data(), fg.data(), fb.data(), fa.data(), repacked.data(), n);
+	GM_CHECK(repacked == packed);
+
+	const gm::ChannelOrder orders[] = { gm::ChannelOrder::ARGB, gm::ChannelOrder::RGBA, gm::ChannelOrder::BGRA, gm::ChannelOrder::ABGR };
+
+	for (int from = 0; from < 4; ++from)
+	{
+		for (int to = 0; to < 4; ++to)
+		{
+			std::vector<int> swizzled = packed;
+			gm::swizzle(swizzled.data(), n, orders[from], orders[to]);
+
+			std::vector<unsigned char> r2(n), g2(n), b2(n), a2(n);
+
+			gm::int2rgb(packed.data(), r.data(), g.data(), b.data(), a.data(), n, orders[from]);
+			gm::int2rgb(swizzled.data(), r2.data(), g2.data(), b2.data(), a2.data(), n, orders[to]);
+
+			GM_CHECK((r == r2) && (g == g2) && (b == b2) && (a == a2));
+
+			gm::rgb2int(r.data(), g.data(), b.data(), a.data(), repacked.data(), n, orders[to]);
+			GM_CHECK(repacked == swizzled);
+		}
+	}
+
+	return gm_test_result();
+}
@@ -0,0 +1,197 @@
+// Checks Palette::nearest() and remap() against a linear scan for
+// both distances and palettes of every size, ties between duplicate
+// colors, that dithering preserves the mean of a gradient, and the
+// empty palette.
+//
+//   g++ -std=c++11 -O2 -I.. test_color_palette.cpp -o test_color_palette -pthread
+
+#include "gm_color.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdlib.h>
+#include <vector>
+
+
+// The palette's embedding, see PaletteDistance
+static void embed(bool hsl, int color, float point[3])
+{
+	const float r = static_cast<float>((color >> 16) & 0xFF);
+	const float g = static_cast<float>((color >> 8) & 0xFF);
+	const float b = static_cast<float>(color & 0xFF);
+
+	if (!hsl)
+	{
+		point[0] = r;
+		point[1] = g;
+		point[2] = b;
+
+		return;
+	}
+
+	float h, s, l;
+	gm::rgb2hsl(r * (1.0f / 255.0f), g * (1.0f / 255.0f), b * (1.0f / 255.0f), &h, &s, &l);
+
+	const float angle = h * 6.283185307179586f;
+
+	point[0] = s * cosf(angle) * 255.0f;
+	point[1] = s * sinf(angle) * 255.0f;
+	point[2] = l * 255.0f;
+}
+
+// The first of the nearest colors
+static size_t linearScan(bool hsl, const std::vector<int> &palette, int color)
+{
+	float q[3];
+	embed(hsl, color, q);
+
+	float nearest = INFINITY;
+	size_t index = 0;
+
+	for (size_t i = 0; i < palette.size(); ++i)
+	{
+		float p[3];
+		embed(hsl, palette[i], p);
+
+		const float d = (q[0] - p[0]) * (q[0] - p[0]) + (q[1] - p[1]) * (q[1] - p[1]) + (q[2] - p[2]) * (q[2] - p[2]);
+
+		if (d < nearest)
+		{
+			nearest = d;
+			index = i;
+		}
+	}
+
+	return index;
+}
+
+
+int main()
+{
+	srand(1);
+
+	const size_t sizes[] = { 1, 2, 16, 64, 256, 300 };
+
+	for (size_t k = 0; k < (sizeof(sizes) / sizeof(*sizes)); ++k)
+	{
+		for (int hsl = 0; hsl < 2; ++hsl)
+		{
+			const size_t size = sizes[k];
+
+			std::vector<int> colors(size);
+
+			for (size_t i = 0; i < size; ++i)
+				colors[i] = static_cast<int>(0xFF000000u | (static_cast<unsigned int>(rand()) & 0xFFFFFFu));
+
+			// A duplicate, which is never the nearest
+			if (size > 4)
+				colors[3] = colors[1];
+
+			const gm::Palette palette(colors.data(), size, hsl ? gm::PaletteDistance::HSL : gm::PaletteDistance::RGB);
+
+			// At most 256 colors are kept
+			GM_CHECK(palette.size() == ((size < 256) ? size : 256));
+
+			colors.resize(palette.size());
+
+			for (size_t i = 0; i < colors.size(); ++i)
+				GM_CHECK(palette.color(i) == colors[i]);
+
+			// Repeated colors go through the cache
+			const size_t n = 20000;
+
+			std::vector<int> image(n);
+
+			for (size_t i = 0; i < n; ++i)
+				image[i] = static_cast<int>(static_cast<unsigned int>(rand()) & 0xFFFFFFu);
+
+			for (size_t i = 0; i < 1000; ++i)
+				image[i] = image[i % 10];
+
+			image[10] = colors[0];
+
+			std::vector<unsigned char> indices(n);
+			std::vector<int> remapped(n);
+
+			palette.nearest(image.data(), indices.data(), n);
+			palette.remap(image.data(), remapped.data(), n);
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				const size_t expected = linearScan(hsl != 0, colors, image[i]);
+
+				GM_CHECK(indices[i] == expected);
+				GM_CHECK(palette.nearest(image[i]) == expected);
+				GM_CHECK(remapped[i] == colors[expected]);
+			}
+
+			if (size > 4)
+				GM_CHECK(palette.nearest(colors[1]) == 1);
+		}
+	}
+
+	// Other channel orders compare the same channels
+	const int argb[3] = { static_cast<int>(0xFF102030u), static_cast<int>(0xFF808080u), static_cast<int>(0xFFF0E0D0u) };
+
+	int bgra[3];
+
+	for (int i = 0; i < 3; ++i)
+	{
+		int r, g, b, a;
+		gm::int2rgb(argb[i], &r, &g, &b, &a);
+		bgra[i] = (b << 24) | (g << 16) | (r << 8) | a;
+	}
+
+	const gm::Palette ordered(bgra, 3, gm::PaletteDistance::RGB, gm::ChannelOrder::BGRA);
+
+	GM_CHECK(ordered.nearest(bgra[0]) == 0);
+	GM_CHECK(ordered.nearest(bgra[1]) == 1);
+	GM_CHECK(ordered.nearest(bgra[2]) == 2);
+
+	// Dithering a gradient to black and white preserves its
+	// mean, over bands of 32 columns
+	const int blackWhite[2] = { static_cast<int>(0xFF000000u), static_cast<int>(0xFFFFFFFFu) };
+	const gm::Palette bw(blackWhite, 2);
+
+	const size_t width = 256, height = 64, stride = 260;
+
+	std::vector<int> gradient(stride * height);
+
+	for (size_t y = 0; y < height; ++y)
+		for (size_t x = 0; x < width; ++x)
+			gradient[y * stride + x] = static_cast<int>(0xFF000000u | (static_cast<unsigned int>(x) * 0x010101u));
+
+	std::vector<unsigned char> dithered(width * height);
+	bw.dither(gradient.data(), width, height, stride, dithered.data());
+
+	for (size_t band = 0; band < width; band += 32)
+	{
+		double mean = 0.0;
+
+		for (size_t y = 0; y < height; ++y)
+			for (size_t x = band; x < (band + 32); ++x)
+				mean += dithered[y * width + x] * 255.0;
+
+		GM_CHECK_NEAR(mean / (32 * height), band + 15.5, 4.0);
+	}
+
+	// An empty palette
+	const gm::Palette empty(nullptr, 0);
+
+	int colors[3] = { 1, 2, 3 }, result[3] = { 7, 7, 7 };
+	unsigned char indices[3] = { 9, 9, 9 };
+
+	GM_CHECK(empty.size() == 0);
+	GM_CHECK(empty.nearest(5) == 0);
+
+	empty.dither(colors, 3, 1, 3, indices);
+	GM_CHECK(indices[0] == 9);
+
+	empty.nearest(colors, indices, 3);
+	empty.remap(colors, result, 3);
+
+	GM_CHECK((indices[0] == 0) && (indices[2] == 0));
+	GM_CHECK((result[0] == 7) && (result[2] == 7));
+
+	return gm_test_result();
+}
@@ -0,0 +1,125 @@
+// Checks that ColorPipeline gives the same pixels as running every
+// stage over the whole image one after the other, for tile sizes that
+// don't divide the image, in place, and the stage statistics.
+//
+//   g++ -std=c++11 -O2 -I.. test_color_pipeline.cpp -o test_color_pipeline -pthread
+
+#include "gm_color.hpp"
+#include "gm_parallel.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdlib.h>
+#include <vector>
+
+
+int main()
+{
+	gm::ThreadPool pool(4);
+
+	const size_t n = 10007;
+
+	std::vector<int> src(n), overlay(n);
+
+	srand(1);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		src[i] = static_cast<int>((static_cast<unsigned int>(rand()) << 16) ^ static_cast<unsigned int>(rand()));
+		overlay[i] = static_cast<int>((static_cast<unsigned int>(rand()) << 16) ^ static_cast<unsigned int>(rand()));
+	}
+
+	gm::ColorLUT lut(9);
+	lut.bake([](float r, float g, float b, float *outR, float *outG, float *outB)
+	{
+		*outR = g;
+		*outG = b * b;
+		*outB = 1.0f - r;
+	}, pool);
+
+	const gm::ColorStage stages[] =
+	{
+		gm::adjustHSLStage(0.1f, 1.3f, 0.9f),
+		gm::blendStage(overlay.data()),
+		gm::blendStage(0.2f, 0.4f, 0.6f, 0.25f),
+		gm::lutStage(lut),
+		gm::grayscaleStage(gm::LumaWeights::Rec601),
+	};
+
+	const size_t stageCount = sizeof(stages) / sizeof(*stages);
+
+	// Every stage over the whole image, one after the other
+	std::vector<float> r(n), g(n), b(n), a(n);
+	gm::int2rgb(src.data(), r.data(), g.data(), b.data(), a.data(), n);
+
+	gm::ColorTile image = { r.data(), g.data(), b.data(), a.data(), 0, n };
+
+	for (size_t stage = 0; stage < stageCount; ++stage)
+		stages[stage](image);
+
+	std::vector<int> expected(n);
+	gm::rgb2int(r.data(), g.data(), b.data(), a.data(), expected.data(), n);
+
+	// The grayscale stage comes last
+	for (size_t i = 0; i < n; ++i)
+	{
+		int R, G, B, A;
+		gm::int2rgb(expected[i], &R, &G, &B, &A);
+
+		GM_CHECK((R == G) && (G == B));
+	}
+
+	const size_t tileSizes[] = { 1, 7, 256, 2048, 20000 };
+
+	for (size_t k = 0; k < (sizeof(tileSizes) / sizeof(*tileSizes)); ++k)
+	{
+		gm::ColorPipeline pipeline(tileSizes[k]);
+
+		for (size_t stage = 0; stage < stageCount; ++stage)
+			pipeline.add("stage", stages[stage]);
+
+		GM_CHECK(pipeline.size() == stageCount);
+
+		std::vector<int> dst(n, 0);
+		pipeline.run(src.data(), dst.data(), n, gm::ChannelOrder::ARGB, pool);
+
+		GM_CHECK(dst == expected);
+
+		// In place
+		dst = src;
+		pipeline.run(dst.data(), dst.data(), n, gm::ChannelOrder::ARGB, pool);
+
+		GM_CHECK(dst == expected);
+
+		const std::vector<gm::ColorStageStats> &stats = pipeline.stats();
+
+		GM_CHECK(stats.size() == (stageCount + 2));
+		GM_CHECK(stats.front().name == "int2rgb");
+		GM_CHECK(stats.back().name == "rgb2int");
+
+		for (size_t stage = 0; stage < stats.size(); ++stage)
+		{
+			GM_CHECK(stats[stage].pixels == (n * 2));
+			GM_CHECK(stats[stage].seconds >= 0.0);
+		}
+
+		GM_CHECK(pipeline.pixels() == (n * 2));
+
+		pipeline.resetStats();
+		GM_CHECK(pipeline.pixels() == 0);
+		GM_CHECK(pipeline.stats()[1].pixels == 0);
+	}
+
+	// Without stages, the pipeline only unpacks and packs
+	gm::ColorPipeline empty;
+
+	std::vector<int> copy(n, 0);
+	empty.run(src.data(), copy.data(), n, gm::ChannelOrder::ARGB, pool);
+
+	GM_CHECK(copy == src);
+
+	empty.run(src.data(), copy.data(), 0, gm::ChannelOrder::ARGB, pool);
+	GM_CHECK(empty.pixels() == n);
+
+	return gm_test_result();
+}
@@ -0,0 +1,107 @@
+// Checks the batch srgb2linear() and linear2srgb() against the
+// scalar functions in double precision, the 8-bit round trip, and
+// compositeSRGB() and grayscaleSRGB() against decoding, applying
+// the linear function and encoding by hand.
+//
+//   g++ -std=c++11 -O2 -I.. test_color_srgb.cpp -o test_color_srgb -pthread
+
+#include "gm_color.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdlib.h>
+#include <vector>
+
+
+int main()
+{
+	const size_t n = 100003;
+
+	std::vector<float> x(n), decoded(n), encoded(n);
+
+	for (size_t i = 0; i < n; ++i)
+		x[i] = i / static_cast<float>(n - 1);
+
+	x[5] = 1E-30f;
+
+	gm::srgb2linear(x.data(), decoded.data(), n);
+	gm::linear2srgb(x.data(), encoded.data(), n);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		const double linear = gm::srgb2linear<double>(x[i]);
+		const double srgb = gm::linear2srgb<double>(x[i]);
+
+		GM_CHECK_NEAR(decoded[i], linear, 1E-6 * linear + 1E-30);
+		GM_CHECK_NEAR(encoded[i], srgb, 1E-6 * srgb + 1E-30);
+	}
+
+	// The 8-bit encode is exactly rounded, away from the boundaries
+	std::vector<unsigned char> encoded8(n);
+	gm::linear2srgb(x.data(), encoded8.data(), n);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		const double srgb = gm::linear2srgb<double>(x[i]) * 255.0;
+
+		if (fabs(srgb - floor(srgb) - 0.5) > 1E-4)
+			GM_CHECK(encoded8[i] == static_cast<int>(floor(srgb + 0.5)));
+	}
+
+	unsigned char values[256], roundTrip[256];
+	float linear[256];
+
+	for (int i = 0; i < 256; ++i)
+		values[i] = static_cast<unsigned char>(i);
+
+	gm::srgb2linear(values, linear, 256);
+	gm::linear2srgb(linear, roundTrip, 256);
+
+	for (int i = 0; i < 256; ++i)
+	{
+		GM_CHECK_NEAR(linear[i], gm::srgb2linear<double>(i / 255.0), 1E-7);
+		GM_CHECK(roundTrip[i] == i);
+	}
+
+	const size_t pixels = 1001;
+
+	std::vector<unsigned char> src(pixels * 4), dst(pixels * 4);
+
+	srand(1);
+
+	for (size_t i = 0; i < (pixels * 4); ++i)
+	{
+		src[i] = static_cast<unsigned char>(rand());
+		dst[i] = static_cast<unsigned char>(rand());
+	}
+
+	std::vector<float> srcf(pixels * 4), dstf(pixels * 4);
+
+	for (size_t i = 0; i < (pixels * 4); ++i)
+	{
+		srcf[i] = ((i % 4) == 3) ? (src[i] / 255.0f) : linear[src[i]];
+		dstf[i] = ((i % 4) == 3) ? (dst[i] / 255.0f) : linear[dst[i]];
+	}
+
+	gm::composite(srcf.data(), dstf.data(), pixels, gm::CompositeMode::SourceOver, gm::AlphaMode::Straight);
+	gm::compositeSRGB(src.data(), dst.data(), pixels);
+
+	for (size_t i = 0; i < (pixels * 4); ++i)
+	{
+		const double expected = ((i % 4) == 3) ? (dstf[i] * 255.0) : (gm::linear2srgb<double>(dstf[i]) * 255.0);
+		GM_CHECK_NEAR(dst[i], expected, 0.51);
+	}
+
+	std::vector<unsigned char> gray(pixels);
+	gm::grayscaleSRGB(src.data(), gray.data(), pixels, 4);
+
+	for (size_t i = 0; i < pixels; ++i)
+	{
+		const unsigned char *p = src.data() + i * 4;
+		const double luma = 0.2126 * linear[p[0]] + 0.7152 * linear[p[1]] + 0.0722 * linear[p[2]];
+
+		GM_CHECK_NEAR(gray[i], gm::linear2srgb<double>(luma) * 255.0, 0.51);
+	}
+
+	return gm_test_result();
+}
@@ -0,0 +1,98 @@
+// Checks the batch versions of every curve against the scalar
+// functions, for floats and doubles, counts that aren't a multiple
+// of the vector width, and in place.
+//
+//   g++ -std=c++11 -O2 -I.. test_easing_batch.cpp -o test_easing_batch -pthread
+
+#include "gm_easing.hpp"
+
+#include "gm_test.hpp"
+
+#include <vector>
+
+
+template<typename T, typename Scalar, typename Batch> static void check(Scalar scalar, Batch batch, double tolerance)
+{
+	const size_t counts[] = { 1, 3, 17, 10007 };
+
+	for (size_t k = 0; k < (sizeof(counts) / sizeof(*counts)); ++k)
+	{
+		const size_t n = counts[k];
+
+		std::vector<T> time(n), result(n);
+
+		for (size_t i = 0; i < n; ++i)
+			time[i] = (n > 1) ? (static_cast<T>(i) / static_cast<T>(n - 1)) : static_cast<T>(0.5);
+
+		batch(time.data(), result.data(), n);
+
+		for (size_t i = 0; i < n; ++i)
+			GM_CHECK_NEAR(result[i], scalar(time[i]), tolerance);
+
+		// In place
+		batch(time.data(), time.data(), n);
+		GM_CHECK(time == result);
+	}
+}
+
+#define CHECK_CURVE(curve) \
+	check<float>([](float t) { return gm::easing::curve(t); }, [](const float *t, float *r, size_t n) { gm::easing::curve(t, r, n); }, 1E-6); \
+	check<double>([](double t) { return gm::easing::curve(t); }, [](const double *t, double *r, size_t n) { gm::easing::curve(t, r, n); }, 1E-12)
+
+
+int main()
+{
+	CHECK_CURVE(easeLinear);
+
+	CHECK_CURVE(easeInQuad);
+	CHECK_CURVE(easeOutQuad);
+	CHECK_CURVE(easeInOutQuad);
+
+	CHECK_CURVE(easeInCubic);
+	CHECK_CURVE(easeOutCubic);
+	CHECK_CURVE(easeInOutCubic);
+
+	CHECK_CURVE(easeInQuart);
+	CHECK_CURVE(easeOutQuart);
+	CHECK_CURVE(easeInOutQuart);
+
+	CHECK_CURVE(easeInQuint);
+	CHECK_CURVE(easeOutQuint);
+	CHECK_CURVE(easeInOutQuint);
+
+	CHECK_CURVE(easeInSine);
+	CHECK_CURVE(easeOutSine);
+	CHECK_CURVE(easeInOutSine);
+
+	CHECK_CURVE(easeInExpo);
+	CHECK_CURVE(easeOutExpo);
+	CHECK_CURVE(easeInOutExpo);
+
+	CHECK_CURVE(easeInCirc);
+	CHECK_CURVE(easeOutCirc);
+	CHECK_CURVE(easeInOutCirc);
+
+	CHECK_CURVE(easeInBack);
+	CHECK_CURVE(easeOutBack);
+	CHECK_CURVE(easeInOutBack);
+
+	CHECK_CURVE(easeInElastic);
+	CHECK_CURVE(easeOutElastic);
+	CHECK_CURVE(easeInOutElastic);
+
+	CHECK_CURVE(easeInBounce);
+	CHECK_CURVE(easeOutBounce);
+	CHECK_CURVE(easeInOutBounce);
+
+	// The endpoints are exact
+	const float ends[2] = { 0.0f, 1.0f };
+	float eased[2];
+
+	gm::easing::easeInOutExpo(ends, eased, 2);
+	GM_CHECK((eased[0] == 0.0f) && (eased[1] == 1.0f));
+
+	gm::easing::easeInOutElastic(ends, eased, 2);
+	GM_CHECK((eased[0] == 0.0f) && (eased[1] == 1.0f));
+
+	return gm_test_result();
+}
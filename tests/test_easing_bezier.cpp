@@ -0,0 +1,121 @@
+// Checks CubicBezier against solving x(t) = time by bisection in
+// double precision, where the result must be the curve's value at a
+// time within 2E-6, the batch version against the scalar one, the
+// endpoints, and that time is clamped.
+//
+//   g++ -std=c++11 -O2 -I.. test_easing_bezier.cpp -o test_easing_bezier -pthread
+
+#include "gm_easing.hpp"
+
+#include "gm_test.hpp"
+
+#include <vector>
+
+
+struct Bezier
+{
+	double x1, y1, x2, y2;
+
+	double x(double t) const
+	{
+		const double u = 1.0 - t;
+		return 3.0 * u * u * t * x1 + 3.0 * u * t * t * x2 + t * t * t;
+	}
+
+	double y(double t) const
+	{
+		const double u = 1.0 - t;
+		return 3.0 * u * u * t * y1 + 3.0 * u * t * t * y2 + t * t * t;
+	}
+
+	// x(t) is increasing, as x1 and x2 are in [0;1]
+	double solve(double time) const
+	{
+		double low = 0.0, high = 1.0;
+
+		for (int i = 0; i < 80; ++i)
+		{
+			const double middle = (low + high) * 0.5;
+			((x(middle) > time) ? high : low) = middle;
+		}
+
+		return (low + high) * 0.5;
+	}
+};
+
+
+int main()
+{
+	// CSS ease, ease-in, ease-out, ease-in-out, linear, back, and
+	// curves with flat and vertical tangents
+	const Bezier curves[] =
+	{
+		{ 0.25, 0.1, 0.25, 1.0 }, { 0.42, 0.0, 1.0, 1.0 }, { 0.0, 0.0, 0.58, 1.0 },
+		{ 0.42, 0.0, 0.58, 1.0 }, { 0.0, 0.0, 1.0, 1.0 }, { 0.68, -0.55, 0.265, 1.55 },
+		{ 1.0, 0.0, 0.0, 1.0 }, { 0.0, 1.0, 1.0, 0.0 }, { 0.9, 0.0, 0.1, 1.0 },
+		{ 1.0, 1.0, 1.0, 1.0 }, { 0.0, 0.0, 0.0, 0.0 },
+	};
+
+	const double window = 2E-6;
+
+	for (size_t k = 0; k < (sizeof(curves) / sizeof(*curves)); ++k)
+	{
+		const Bezier &c = curves[k];
+
+		const gm::easing::CubicBezier bezier(
+			static_cast<float>(c.x1), static_cast<float>(c.y1),
+			static_cast<float>(c.x2), static_cast<float>(c.y2));
+
+		const size_t n = 4001;
+
+		std::vector<float> time(n), result(n);
+
+		for (size_t i = 0; i < n; ++i)
+			time[i] = static_cast<float>(i) / static_cast<float>(n - 1);
+
+		bezier(time.data(), result.data(), n);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			GM_CHECK_NEAR(result[i], bezier(time[i]), 1E-6);
+
+			// The range of y over the parameters of the times
+			// within the window, which x(t) maps in order
+			const double first = c.solve(time[i] - window), last = c.solve(time[i] + window);
+
+			double low = INFINITY, high = -INFINITY;
+
+			for (int j = 0; j <= 64; ++j)
+			{
+				const double y = c.y(first + (last - first) * j / 64.0);
+
+				low = (y < low) ? y : low;
+				high = (y > high) ? y : high;
+			}
+
+			GM_CHECK((result[i] >= (low - 1E-6)) && (result[i] <= (high + 1E-6)));
+		}
+
+		GM_CHECK_NEAR(bezier(0.0f), 0.0, 1E-6);
+		GM_CHECK_NEAR(bezier(1.0f), 1.0, 1E-6);
+
+		// Clamped
+		GM_CHECK(bezier(-1.0f) == bezier(0.0f));
+		GM_CHECK(bezier(2.0f) == bezier(1.0f));
+	}
+
+	// Curves with the same control points share a table,
+	// and give the same results
+	const gm::easing::CubicBezier a(0.1f, 0.2f, 0.3f, 0.4f), b(0.1f, 0.2f, 0.3f, 0.4f);
+
+	for (float t = 0.0f; t <= 1.0f; t += 0.01f)
+		GM_CHECK(a(t) == b(t));
+
+	// x1 and x2 are clamped to [0;1]
+	const gm::easing::CubicBezier outside(-0.5f, 0.3f, 1.5f, 0.7f), clamped(0.0f, 0.3f, 1.0f, 0.7f);
+
+	for (float t = 0.0f; t <= 1.0f; t += 0.01f)
+		GM_CHECK(outside(t) == clamped(t));
+
+	return gm_test_result();
+}
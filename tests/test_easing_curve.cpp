@@ -0,0 +1,100 @@
+// Checks that the functions chosen by Curve are the named curves,
+// for the scalar, batch and mixed (grouped) versions of ease().
+//
+//   g++ -std=c++11 -O2 -I.. test_easing_curve.cpp -o test_easing_curve -pthread
+
+#include "gm_easing.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdlib.h>
+#include <vector>
+
+
+// The named curves, in the order of Curve
+template<typename T> static T named(int curve, T time)
+{
+	using namespace gm::easing;
+
+	T (*const functions[])(T) =
+	{
+		easeLinear<T>,
+		easeInQuad<T>, easeOutQuad<T>, easeInOutQuad<T>,
+		easeInCubic<T>, easeOutCubic<T>, easeInOutCubic<T>,
+		easeInQuart<T>, easeOutQuart<T>, easeInOutQuart<T>,
+		easeInQuint<T>, easeOutQuint<T>, easeInOutQuint<T>,
+		easeInSine<T>, easeOutSine<T>, easeInOutSine<T>,
+		easeInExpo<T>, easeOutExpo<T>, easeInOutExpo<T>,
+		easeInCirc<T>, easeOutCirc<T>, easeInOutCirc<T>,
+		easeInBack<T>, easeOutBack<T>, easeInOutBack<T>,
+		easeInElastic<T>, easeOutElastic<T>, easeInOutElastic<T>,
+		easeInBounce<T>, easeOutBounce<T>, easeInOutBounce<T>,
+	};
+
+	return functions[curve](time);
+}
+
+static const int CURVES = 31;
+
+
+template<typename T> static void check(double tolerance)
+{
+	const size_t n = 5003;
+
+	std::vector<T> time(n), result(n);
+
+	for (size_t i = 0; i < n; ++i)
+		time[i] = static_cast<T>(i) / static_cast<T>(n - 1);
+
+	for (int curve = 0; curve < CURVES; ++curve)
+	{
+		const gm::easing::Curve c = static_cast<gm::easing::Curve>(curve);
+
+		gm::easing::ease(c, time.data(), result.data(), n);
+
+		std::vector<T> batch(n);
+		gm::easing::easeBatchFunction<T>(c)(time.data(), batch.data(), n);
+
+		GM_CHECK(batch == result);
+
+		for (size_t i = 0; i < n; i += 7)
+		{
+			GM_CHECK(gm::easing::ease(c, time[i]) == named(curve, time[i]));
+			GM_CHECK(gm::easing::easeFunction<T>(c)(time[i]) == named(curve, time[i]));
+			GM_CHECK_NEAR(result[i], named(curve, time[i]), tolerance);
+		}
+	}
+
+	// Mixed curves, spanning several blocks of 1024, with runs of
+	// the same curve and curves changing every element
+	const size_t mixedCount = 5000;
+
+	std::vector<gm::easing::Curve> curves(mixedCount);
+	std::vector<T> mixedTime(mixedCount), mixed(mixedCount);
+
+	for (size_t i = 0; i < mixedCount; ++i)
+	{
+		curves[i] = static_cast<gm::easing::Curve>((i < 2000) ? (rand() % CURVES) : ((i / 100) % CURVES));
+		mixedTime[i] = static_cast<T>(rand()) / static_cast<T>(RAND_MAX);
+	}
+
+	gm::easing::ease(curves.data(), mixedTime.data(), mixed.data(), mixedCount);
+
+	for (size_t i = 0; i < mixedCount; ++i)
+		GM_CHECK_NEAR(mixed[i], named(static_cast<int>(curves[i]), mixedTime[i]), tolerance);
+
+	// In place
+	gm::easing::ease(curves.data(), mixedTime.data(), mixedTime.data(), mixedCount);
+	GM_CHECK(mixedTime == mixed);
+}
+
+
+int main()
+{
+	srand(1);
+
+	check<float>(1E-6);
+	check<double>(1E-12);
+
+	return gm_test_result();
+}
@@ -0,0 +1,134 @@
+// Checks the derivatives of every curve against central differences
+// of the curve in double precision, away from kinks, the combined
+// value and derivative against the curve, and the batch versions
+// against the scalar ones.
+//
+//   g++ -std=c++11 -O2 -I.. test_easing_derivative.cpp -o test_easing_derivative -pthread
+
+#include "gm_easing.hpp"
+
+#include "gm_test.hpp"
+
+#include <vector>
+
+
+template<typename T, typename Curve, typename Derivative, typename Combined, typename BatchDerivative, typename BatchCombined>
+static void check(
+	Curve curve, Derivative derivative, Combined combined,
+	BatchDerivative batchDerivative, BatchCombined batchCombined,
+	double valueTolerance, double derivativeTolerance)
+{
+	const size_t n = 4099;
+
+	std::vector<T> time(n), batch(n), batchValue(n), batchCombinedDerivative(n);
+
+	for (size_t i = 0; i < n; ++i)
+		time[i] = static_cast<T>(i + 1) / static_cast<T>(n + 1);
+
+	batchDerivative(time.data(), batch.data(), n);
+	batchCombined(time.data(), batchValue.data(), batchCombinedDerivative.data(), n);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		const double x = static_cast<double>(time[i]), h = 1E-6;
+
+		const double difference = (curve(x + h) - curve(x - h)) / (2.0 * h);
+		const double left = (curve(x) - curve(x - h)) / h;
+		const double right = (curve(x + h) - curve(x)) / h;
+
+		T d;
+		const T value = combined(time[i], &d);
+
+		GM_CHECK_NEAR(value, curve(x), valueTolerance);
+		GM_CHECK_NEAR(batchValue[i], value, valueTolerance);
+
+		GM_CHECK(static_cast<double>(d) == static_cast<double>(derivative(time[i])));
+
+		// Kinks (piecewise curves), and the (close to) infinite slopes of Circ
+		if ((fabs(right - left) > (1E-2 * (1.0 + fabs(difference)))) || (fabs(difference) > 1E3) || !isfinite(d))
+			continue;
+
+		const double scale = 1.0 + fabs(difference);
+
+		GM_CHECK_NEAR(d, difference, derivativeTolerance * scale);
+		GM_CHECK_NEAR(batch[i], d, derivativeTolerance * scale);
+		GM_CHECK_NEAR(batchCombinedDerivative[i], d, derivativeTolerance * scale);
+	}
+
+	// Either output may be nullptr
+	batchCombined(time.data(), nullptr, batch.data(), n);
+	GM_CHECK(batch == batchCombinedDerivative);
+
+	batchCombined(time.data(), batch.data(), nullptr, n);
+	GM_CHECK(batch == batchValue);
+}
+
+#define CHECK_CURVE(name) \
+	check<float>( \
+		[](double x) { return gm::easing::name<double>(x); }, \
+		[](float x) { return gm::easing::name##Derivative(x); }, \
+		[](float x, float *d) { return gm::easing::name(x, d); }, \
+		[](const float *t, float *r, size_t n) { gm::easing::name##Derivative(t, r, n); }, \
+		[](const float *t, float *v, float *d, size_t n) { gm::easing::name(t, v, d, n); }, \
+		3E-6, 2E-4); \
+	check<double>( \
+		[](double x) { return gm::easing::name<double>(x); }, \
+		[](double x) { return gm::easing::name##Derivative(x); }, \
+		[](double x, double *d) { return gm::easing::name(x, d); }, \
+		[](const double *t, double *r, size_t n) { gm::easing::name##Derivative(t, r, n); }, \
+		[](const double *t, double *v, double *d, size_t n) { gm::easing::name(t, v, d, n); }, \
+		1E-12, 1E-4)
+
+
+int main()
+{
+	CHECK_CURVE(easeLinear);
+
+	CHECK_CURVE(easeInQuad);
+	CHECK_CURVE(easeOutQuad);
+	CHECK_CURVE(easeInOutQuad);
+
+	CHECK_CURVE(easeInCubic);
+	CHECK_CURVE(easeOutCubic);
+	CHECK_CURVE(easeInOutCubic);
+
+	CHECK_CURVE(easeInQuart);
+	CHECK_CURVE(easeOutQuart);
+	CHECK_CURVE(easeInOutQuart);
+
+	CHECK_CURVE(easeInQuint);
+	CHECK_CURVE(easeOutQuint);
+	CHECK_CURVE(easeInOutQuint);
+
+	CHECK_CURVE(easeInSine);
+	CHECK_CURVE(easeOutSine);
+	CHECK_CURVE(easeInOutSine);
+
+	CHECK_CURVE(easeInExpo);
+	CHECK_CURVE(easeOutExpo);
+	CHECK_CURVE(easeInOutExpo);
+
+	CHECK_CURVE(easeInCirc);
+	CHECK_CURVE(easeOutCirc);
+	CHECK_CURVE(easeInOutCirc);
+
+	CHECK_CURVE(easeInBack);
+	CHECK_CURVE(easeOutBack);
+	CHECK_CURVE(easeInOutBack);
+
+	CHECK_CURVE(easeInElastic);
+	CHECK_CURVE(easeOutElastic);
+	CHECK_CURVE(easeInOutElastic);
+
+	CHECK_CURVE(easeInBounce);
+	CHECK_CURVE(easeOutBounce);
+	CHECK_CURVE(easeInOutBounce);
+
+	// The documented special cases
+	GM_CHECK(gm::easing::easeInExpoDerivative(0.0f) == 0.0f);
+	GM_CHECK(gm::easing::easeOutExpoDerivative(1.0f) == 0.0f);
+	GM_CHECK(isinf(gm::easing::easeInCircDerivative(1.0)));
+	GM_CHECK(isinf(gm::easing::easeOutCircDerivative(0.0)));
+
+	return gm_test_result();
+}
@@ -0,0 +1,86 @@
+// Checks the fast curves against the exact curves in double precision,
+// the batch versions against the scalar ones, the exact endpoints of
+// the Expo curves, and that time outside of [0;1] is clamped.
+//
+//   g++ -std=c++11 -O2 -I.. test_easing_fast.cpp -o test_easing_fast -pthread
+
+#include "gm_easing.hpp"
+
+#include "gm_test.hpp"
+
+#include <vector>
+
+
+template<typename Fast, typename Batch, typename Exact> static void check(Fast fast, Batch batch, Exact exact)
+{
+	const size_t n = 100003;
+
+	std::vector<float> time(n), result(n);
+
+	for (size_t i = 0; i < n; ++i)
+		time[i] = -0.5f + 2.0f * static_cast<float>(i) / static_cast<float>(n - 1);
+
+	batch(time.data(), result.data(), n);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		const float clamped = (time[i] < 0.0f) ? 0.0f : ((time[i] > 1.0f) ? 1.0f : time[i]);
+
+		GM_CHECK(result[i] == fast(time[i]));
+		GM_CHECK(fast(time[i]) == fast(clamped));
+
+		GM_CHECK_NEAR(fast(time[i]), exact(static_cast<double>(clamped)), 3E-7);
+	}
+}
+
+#define CHECK_CURVE(curve) \
+	check( \
+		[](float t) { return gm::easing::fast::curve(t); }, \
+		[](const float *t, float *r, size_t n) { gm::easing::fast::curve(t, r, n); }, \
+		[](double t) { return gm::easing::curve(t); })
+
+
+int main()
+{
+	CHECK_CURVE(easeInSine);
+	CHECK_CURVE(easeOutSine);
+	CHECK_CURVE(easeInOutSine);
+
+	CHECK_CURVE(easeInExpo);
+	CHECK_CURVE(easeOutExpo);
+	CHECK_CURVE(easeInOutExpo);
+
+	CHECK_CURVE(easeInElastic);
+	CHECK_CURVE(easeOutElastic);
+	CHECK_CURVE(easeInOutElastic);
+
+	// The special cases of the Expo curves hold for
+	// time outside of [0;1] as well
+	const float time[6] = { -0.5f, 0.0f, 1E-5f, 1.0f - 1E-5f, 1.0f, 1.5f };
+	const float ends[6] = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+
+	float in[6], out[6], inOut[6];
+
+	gm::easing::fast::easeInExpo(time, in, 6);
+	gm::easing::fast::easeOutExpo(time, out, 6);
+	gm::easing::fast::easeInOutExpo(time, inOut, 6);
+
+	for (int i = 0; i < 6; ++i)
+	{
+		if (ends[i] == 0.0f)
+		{
+			GM_CHECK(gm::easing::fast::easeInExpo(time[i]) == 0.0f);
+			GM_CHECK(in[i] == 0.0f);
+		}
+		else
+		{
+			GM_CHECK(gm::easing::fast::easeOutExpo(time[i]) == 1.0f);
+			GM_CHECK(out[i] == 1.0f);
+		}
+
+		GM_CHECK(gm::easing::fast::easeInOutExpo(time[i]) == ends[i]);
+		GM_CHECK(inOut[i] == ends[i]);
+	}
+
+	return gm_test_result();
+}
@@ -0,0 +1,147 @@
+// Checks KeyframeTrack against finding the segment by a linear scan,
+// when playing forward, seeking and playing backwards with a cursor,
+// with steps (keys at the same time), the batch sample(), and tracks
+// with less than 2 keys.
+//
+//   g++ -std=c++11 -O2 -I.. test_easing_keyframe.cpp -o test_easing_keyframe -pthread
+
+#include "gm_easing.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdlib.h>
+#include <vector>
+
+
+// The last segment starting at or before time
+static float reference(const std::vector<gm::easing::Keyframe> &keys, float time)
+{
+	if (keys.size() < 2)
+		return keys.empty() ? 0.0f : keys[0].value;
+
+	size_t segment = 0;
+
+	for (size_t i = 0; (i + 1) < keys.size(); ++i)
+		if (keys[i].time <= time)
+			segment = i;
+
+	const gm::easing::Keyframe &from = keys[segment], &to = keys[segment + 1];
+
+	const float duration = to.time - from.time;
+
+	float t = (time < from.time) ? 0.0f : ((duration > 0.0f) ? ((time - from.time) / duration) : 1.0f);
+	t = (t > 0.0f) ? ((t < 1.0f) ? t : 1.0f) : 0.0f;
+
+	return from.value + (to.value - from.value) * gm::easing::ease(from.curve, t);
+}
+
+static float random(float low, float high)
+{
+	return low + (high - low) * (static_cast<float>(rand()) / static_cast<float>(RAND_MAX));
+}
+
+
+int main()
+{
+	srand(1);
+
+	std::vector<gm::easing::KeyframeTrack> tracks;
+	std::vector<std::vector<gm::easing::Keyframe>> keys;
+
+	for (int k = 0; k < 50; ++k)
+	{
+		const size_t count = static_cast<size_t>(rand() % 40);
+
+		std::vector<gm::easing::Keyframe> track;
+		float time = random(-1.0f, 1.0f);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			// Every 5th key is a step
+			if ((rand() % 5) != 0)
+				time += random(0.01f, 0.5f);
+
+			const gm::easing::Keyframe key = { time, random(-10.0f, 10.0f), static_cast<gm::easing::Curve>(rand() % 31) };
+			track.push_back(key);
+		}
+
+		// Adding in any order sorts them, keeping the order of equal times
+		gm::easing::KeyframeTrack added;
+
+		for (size_t i = 0; i < count; i += 2)
+			added.add(track[i].time, track[i].value, track[i].curve);
+
+		for (size_t i = 1; i < count; i += 2)
+			added.add(track[i].time, track[i].value, track[i].curve);
+
+		const gm::easing::KeyframeTrack constructed(track.data(), track.size());
+
+		GM_CHECK(constructed.size() == count);
+		GM_CHECK(constructed.startTime() == (count ? track.front().time : 0.0f));
+		GM_CHECK(constructed.endTime() == (count ? track.back().time : 0.0f));
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			GM_CHECK(constructed.key(i).time == track[i].time);
+			GM_CHECK(constructed.key(i).value == track[i].value);
+			GM_CHECK(added.key(i).time == track[i].time);
+		}
+
+		tracks.push_back(constructed);
+		keys.push_back(track);
+	}
+
+	for (size_t k = 0; k < tracks.size(); ++k)
+	{
+		const gm::easing::KeyframeTrack &track = tracks[k];
+
+		const float start = track.startTime() - 0.5f, end = track.endTime() + 0.5f;
+
+		// Forward, backwards, and random seeks, at the key times as well
+		gm::easing::KeyframeCursor cursor;
+
+		for (float time = start; time <= end; time += 0.013f)
+		{
+			GM_CHECK(track.sample(time, cursor) == reference(keys[k], time));
+			GM_CHECK(track.sample(time) == reference(keys[k], time));
+		}
+
+		for (float time = end; time >= start; time -= 0.029f)
+			GM_CHECK(track.sample(time, cursor) == reference(keys[k], time));
+
+		for (int i = 0; (i < 200) && !keys[k].empty(); ++i)
+		{
+			const float time = ((i % 2) == 0) ? random(start, end) : keys[k][static_cast<size_t>(rand()) % keys[k].size()].time;
+			GM_CHECK(track.sample(time, cursor) == reference(keys[k], time));
+		}
+	}
+
+	// The batch version, with a cursor per track
+	const size_t n = tracks.size();
+
+	std::vector<gm::easing::KeyframeCursor> cursors(n);
+	std::vector<float> time(n), result(n);
+
+	for (int frame = 0; frame < 300; ++frame)
+	{
+		for (size_t k = 0; k < n; ++k)
+			time[k] = (frame < 250) ? (-1.0f + frame * 0.05f + k * 0.01f) : random(-2.0f, 20.0f);
+
+		gm::easing::sample(tracks.data(), cursors.data(), time.data(), result.data(), n);
+
+		for (size_t k = 0; k < n; ++k)
+			GM_CHECK_NEAR(result[k], reference(keys[k], time[k]), 1E-5 * (1.0 + fabs(result[k])));
+	}
+
+	// Less than 2 keys
+	gm::easing::KeyframeTrack single;
+	GM_CHECK(single.sample(1.0f) == 0.0f);
+
+	single.add(2.0f, 5.0f);
+	GM_CHECK((single.sample(0.0f) == 5.0f) && (single.sample(3.0f) == 5.0f));
+
+	single.clear();
+	GM_CHECK(single.size() == 0);
+
+	return gm_test_result();
+}
@@ -0,0 +1,142 @@
+// Checks TweenPool against tweening every tween on its own, over many
+// frames of random adds, removes and updates, across threads, that
+// the completion bits are set once, and that ids of removed tweens
+// aren't contained after their index was reused.
+//
+//   g++ -std=c++11 -O2 -I.. test_easing_tween.cpp -o test_easing_tween -pthread
+
+#include "gm_easing.hpp"
+#include "gm_parallel.hpp"
+
+#include "gm_test.hpp"
+
+#include <map>
+#include <stdlib.h>
+#include <vector>
+
+
+struct Tween
+{
+	float start, end, duration, elapsed;
+	gm::easing::Curve curve;
+};
+
+
+int main()
+{
+	gm::ThreadPool pool(4);
+
+	gm::easing::TweenPool tweens(8);
+	std::map<gm::easing::TweenId, Tween> expected;
+
+	srand(1);
+
+	for (int frame = 0; frame < 200; ++frame)
+	{
+		const int adds = rand() % ((frame < 20) ? 2000 : 300);
+
+		for (int k = 0; k < adds; ++k)
+		{
+			const float duration = ((rand() % 10) == 0) ? 0.0f : static_cast<float>(rand() % 100) / 50.0f;
+			const float start = static_cast<float>(rand() % 100), end = static_cast<float>(rand() % 100);
+			const gm::easing::Curve curve = static_cast<gm::easing::Curve>(rand() % 31);
+
+			const gm::easing::TweenId id = tweens.add(start, end, duration, curve);
+
+			GM_CHECK(expected.count(id) == 0);
+			GM_CHECK(tweens.contains(id) && (tweens.value(id) == start));
+
+			const Tween tween = { start, end, (duration > 0.0f) ? duration : 1E-30f, 0.0f, curve };
+			expected[id] = tween;
+		}
+
+		std::vector<gm::easing::TweenId> ids;
+
+		for (const auto &entry : expected)
+			ids.push_back(entry.first);
+
+		for (size_t k = 0; k < (ids.size() / 8); ++k)
+		{
+			const gm::easing::TweenId id = ids[static_cast<size_t>(rand()) % ids.size()];
+
+			if (expected.count(id))
+			{
+				tweens.remove(id);
+				expected.erase(id);
+
+				GM_CHECK(!tweens.contains(id));
+				GM_CHECK((tweens.value(id) == 0.0f) && tweens.finished(id));
+			}
+		}
+
+		const float deltaTime = 0.016f * static_cast<float>(1 + rand() % 3);
+		tweens.update(deltaTime, pool);
+
+		std::map<gm::easing::TweenId, bool> completed;
+
+		for (size_t slot = 0; slot < tweens.slots(); ++slot)
+		{
+			if ((tweens.completed()[slot / 64] >> (slot % 64)) & 1)
+				completed[tweens.id(slot)] = true;
+
+			// Every slot is either removed or an expected tween
+			GM_CHECK((tweens.id(slot) == 0xFFFFFFFFu) || expected.count(tweens.id(slot)));
+		}
+
+		for (auto &entry : expected)
+		{
+			Tween &tween = entry.second;
+
+			const float previous = tween.elapsed;
+			tween.elapsed = (previous + deltaTime < tween.duration) ? (previous + deltaTime) : tween.duration;
+
+			const bool finished = (previous < tween.duration) && (tween.elapsed >= tween.duration);
+			const float value = tween.start + (tween.end - tween.start) * gm::easing::ease(tween.curve, tween.elapsed / tween.duration);
+
+			GM_CHECK(finished == (completed.count(entry.first) != 0));
+			GM_CHECK(tweens.contains(entry.first));
+			GM_CHECK_NEAR(tweens.value(entry.first), value, 1E-3);
+			GM_CHECK(tweens.finished(entry.first) == (tween.elapsed >= tween.duration));
+		}
+
+		GM_CHECK(tweens.size() == expected.size());
+	}
+
+	// The index of a removed tween is reused with another generation
+	gm::easing::TweenPool reused;
+
+	const gm::easing::TweenId first = reused.add(0.0f, 1.0f, 1.0f);
+	reused.remove(first);
+
+	const gm::easing::TweenId second = reused.add(2.0f, 3.0f, 1.0f);
+
+	GM_CHECK(second != first);
+	GM_CHECK((second & 0xFFFFFFu) == (first & 0xFFFFFFu));
+	GM_CHECK(!reused.contains(first) && reused.contains(second));
+	GM_CHECK(reused.value(first) == 0.0f);
+	GM_CHECK(reused.value(second) == 2.0f);
+
+	// Removing the stale id leaves the new tween alone
+	reused.remove(first);
+	GM_CHECK(reused.contains(second) && (reused.size() == 1));
+
+	// As does clear()
+	reused.clear();
+
+	GM_CHECK(reused.size() == 0);
+	GM_CHECK(!reused.contains(second));
+
+	const gm::easing::TweenId third = reused.add(4.0f, 5.0f, 1.0f);
+
+	GM_CHECK(!reused.contains(first) && !reused.contains(second) && reused.contains(third));
+	GM_CHECK(reused.value(third) == 4.0f);
+
+	// A zero duration finishes on the next update
+	const gm::easing::TweenId instant = reused.add(0.0f, 10.0f, 0.0f, gm::easing::Curve::OutQuad);
+
+	GM_CHECK(!reused.finished(instant));
+	reused.update(0.016f, pool);
+	GM_CHECK(reused.finished(instant) && (reused.value(instant) == 10.0f));
+
+	return gm_test_result();
+}
@@ -0,0 +1,110 @@
+// Checks that evaluating a chain of expressions in one pass gives
+// bitwise the same results as calling the batch functions one after
+// another, for float and double, misaligned arrays, results in place,
+// arithmetic operators mixed with scalars, and apply().
+//
+//   g++ -std=c++11 -O2 -I.. test_expr.cpp -o test_expr -pthread
+
+#include "gm_expr.hpp"
+
+#include "gm_test.hpp"
+
+#include <string.h>
+#include <vector>
+
+
+struct Square
+{
+	template<typename V> V operator()(const V &x) const { return x * x; }
+};
+
+
+template<typename T>
+static bool same(const T *a, const T *b, size_t n)
+{
+	return (n == 0) || (memcmp(a, b, n * sizeof(T)) == 0);
+}
+
+template<typename T>
+static void check(size_t count, size_t offset)
+{
+	namespace expr = gm::expr;
+
+	std::vector<T> x(count + offset), y(count + offset), t(count + offset);
+	std::vector<T> a(count), b(count), c(count), r(count + 2);
+
+	for (size_t i = 0; i < (count + offset); ++i)
+	{
+		x[i] = static_cast<T>(sin(i * 0.37) * 3.0);
+		y[i] = static_cast<T>(cos(i * 0.11));
+		t[i] = static_cast<T>((i % 13) / 12.0);
+	}
+
+	const T *X = x.data() + offset;
+	const T *Y = y.data() + offset;
+	const T *U = t.data() + offset;
+
+	// The result misaligned from the inputs
+	T *R = r.data() + ((offset + 1) % 3);
+
+	gm::map(X, T(-3), T(3), T(0), T(1), a.data(), count);
+	gm::clamp(a.data(), T(0.1), T(0.9), a.data(), count);
+	gm::smoothstep(T(0.2), T(0.8), a.data(), b.data(), count);
+	gm::easing::easeInOutSine(b.data(), c.data(), count);
+
+	expr::evaluate(expr::easeInOutSine(expr::smoothstep(T(0.2), T(0.8), expr::clamp(expr::map(expr::array(X, count), T(-3), T(3), T(0), T(1)), T(0.1), T(0.9)))), R);
+	GM_CHECK(same(c.data(), R, count));
+
+	gm::lerp(X, Y, U, a.data(), count);
+	expr::evaluate(expr::lerp(expr::array(X, count), expr::array(Y, count), expr::array(U, count)), R);
+	GM_CHECK(same(a.data(), R, count));
+
+	gm::lerp(T(2), T(5), U, a.data(), count);
+	expr::evaluate(expr::lerp(2.0, 5.0f, expr::array(U, count)), R);
+	GM_CHECK(same(a.data(), R, count));
+
+	gm::normalize(T(-1), T(4), X, a.data(), count);
+	gm::fract(a.data(), a.data(), count);
+	expr::evaluate(expr::fract(expr::normalize(T(-1), T(4), expr::array(X, count))), R);
+	GM_CHECK(same(a.data(), R, count));
+
+	expr::evaluate(-((expr::array(X, count) * 2.0f + expr::array(Y, count)) / 3 - 1.0), R);
+
+	for (size_t i = 0; i < count; ++i)
+		GM_CHECK(R[i] == -((X[i] * T(2) + Y[i]) / T(3) - T(1)));
+
+	expr::evaluate(expr::apply(expr::array(X, count), Square()) + 1, R);
+
+	for (size_t i = 0; i < count; ++i)
+		GM_CHECK(R[i] == (X[i] * X[i] + T(1)));
+
+	// In place. The multiplication can be contracted with the curve
+	// into an FMA once fused, so this is the only inexact comparison
+	std::vector<T> inPlace(X, X + count), scaled(count);
+
+	for (size_t i = 0; i < count; ++i)
+		scaled[i] = X[i] * T(0.1);
+
+	gm::easing::easeOutBounce(scaled.data(), a.data(), count);
+	expr::evaluate(expr::easeOutBounce(expr::array(inPlace.data(), count) * 0.1), inPlace.data());
+
+	for (size_t i = 0; i < count; ++i)
+		GM_CHECK_NEAR(inPlace[i], a[i], 1E-6);
+}
+
+
+int main()
+{
+	const size_t counts[] = { 0, 1, 3, 7, 17, 100, 1003 };
+
+	for (size_t k = 0; k < (sizeof(counts) / sizeof(*counts)); ++k)
+	{
+		for (size_t offset = 0; offset < 3; ++offset)
+		{
+			check<float>(counts[k], offset);
+			check<double>(counts[k], offset);
+		}
+	}
+
+	return gm_test_result();
+}
@@ -0,0 +1,181 @@
+// Checks the fixed arithmetic and math functions against doubles
+// within their documented errors, the conversions and saturation,
+// the templates of the other libraries with fixed, and that the
+// results are bit identical (against a hash of them) on every
+// machine and instruction set.
+//
+// gm_fixed.hpp is included first on purpose, as its math functions
+// must not hide the math.h functions from the other libraries.
+//
+//   g++ -std=c++11 -O2 -I.. test_fixed.cpp -o test_fixed -pthread
+
+#include "gm_fixed.hpp"
+
+#include "gm_math.hpp"
+#include "gm_easing.hpp"
+#include "gm_color.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdint.h>
+
+
+static uint64_t hash = 1469598103934665603ULL;
+
+static void mix(const gm::fixed &x)
+{
+	hash = (hash ^ static_cast<uint32_t>(x.raw())) * 1099511628211ULL;
+}
+
+static double toDouble(const gm::fixed &x)
+{
+	return static_cast<double>(x);
+}
+
+
+int main()
+{
+	using gm::fixed;
+
+	const double LSB = 1.0 / 65536.0;
+
+	// Conversions round to nearest, and saturate
+	GM_CHECK(fixed(0.5).raw() == 32768);
+	GM_CHECK(fixed(-0.5f).raw() == -32768);
+	GM_CHECK(fixed(LSB * 0.49).raw() == 0);
+	GM_CHECK(fixed(LSB * 0.51).raw() == 1);
+	GM_CHECK(fixed(1E10).raw() == INT32_MAX);
+	GM_CHECK(fixed(-1E10).raw() == INT32_MIN);
+	GM_CHECK(fixed(NAN).raw() == 0);
+	GM_CHECK(fixed(3).raw() == (3 << 16));
+	GM_CHECK(static_cast<int>(fixed(-2.75)) == -2);
+
+	// The arithmetic, where multiplication and division round
+	for (int i = -3000; i <= 3000; i += 7)
+	{
+		for (int j = -3000; j <= 3000; j += 11)
+		{
+			const fixed a = fixed::fromRaw(i * 9973), b = fixed::fromRaw(j * 7919);
+			const double x = toDouble(a), y = toDouble(b);
+
+			GM_CHECK(toDouble(a + b) == (x + y));
+			GM_CHECK(toDouble(a - b) == (x - y));
+
+			if (fabs(x * y) < 32767.0)
+				GM_CHECK_NEAR(toDouble(a * b), x * y, LSB * 0.5);
+
+			if ((j != 0) && (fabs(x / y) < 32767.0))
+				GM_CHECK_NEAR(toDouble(a / b), x / y, LSB * 0.5);
+
+			GM_CHECK((a < b) == (x < y));
+			GM_CHECK((a == b) == (x == y));
+		}
+	}
+
+	// Division saturates, and 0 / 0 is 0
+	GM_CHECK((fixed(30000) / fixed(0.5)).raw() == INT32_MAX);
+	GM_CHECK((fixed(-30000) / fixed(0.5)).raw() == INT32_MIN);
+	GM_CHECK((fixed(1) / fixed(0)).raw() == INT32_MAX);
+	GM_CHECK((fixed(-1) / fixed(0)).raw() == INT32_MIN);
+	GM_CHECK((fixed(0) / fixed(0)).raw() == 0);
+
+	// Addition wraps around, like integers
+	GM_CHECK((fixed::fromRaw(INT32_MAX) + fixed::fromRaw(1)).raw() == INT32_MIN);
+
+	// The math functions, within their documented errors of
+	// the exact results for the same (fixed) input
+	for (int32_t raw = -200 * 65536; raw <= 200 * 65536; raw += 997)
+	{
+		const fixed x = fixed::fromRaw(raw);
+
+		GM_CHECK_NEAR(toDouble(sin(x)), ::sin(toDouble(x)), LSB * 1.0);
+		GM_CHECK_NEAR(toDouble(cos(x)), ::cos(toDouble(x)), LSB * 1.0);
+
+		mix(sin(x));
+		mix(cos(x));
+	}
+
+	for (int32_t raw = -17 * 65536; raw < 15 * 65536; raw += 37)
+	{
+		const fixed x = fixed::fromRaw(raw);
+		const double expected = ::exp2(toDouble(x));
+
+		// Within 1 below 2^12, and a relative error of 2^-28 above
+		if (expected < 2147483647.0 * LSB)
+			GM_CHECK_NEAR(toDouble(exp2(x)), expected, (expected < 4096.0) ? LSB : (expected * 3.2E-9 + LSB * 0.5));
+
+		mix(exp2(x));
+	}
+
+	GM_CHECK(exp2(fixed(15)).raw() == INT32_MAX);
+	GM_CHECK(exp2(fixed(-18)).raw() == 0);
+
+	for (int32_t raw = 1; raw < (INT32_MAX - 9973); raw += 9973)
+	{
+		const fixed x = fixed::fromRaw(raw);
+
+		// log2() truncates
+		const double log = toDouble(log2(x));
+		GM_CHECK((log <= (::log2(toDouble(x)) + 1E-9)) && (log > (::log2(toDouble(x)) - LSB * 1.001)));
+
+		GM_CHECK_NEAR(toDouble(sqrt(x)), ::sqrt(toDouble(x)), LSB * 0.5);
+
+		mix(log2(x));
+		mix(sqrt(x));
+	}
+
+	for (int i = 1; i < 400; ++i)
+	{
+		for (int j = -30; j < 30; ++j)
+		{
+			const fixed x = fixed(i / 50.0), y = fixed(j / 10.0);
+			const double expected = ::pow(toDouble(x), toDouble(y));
+
+			if ((expected >= 1.0) && (expected < 30000.0))
+				GM_CHECK_NEAR(toDouble(pow(x, y)), expected, expected * 0.6931 * (fabs(toDouble(y)) + 1.0) * LSB + LSB * 0.5);
+
+			mix(pow(x, y));
+		}
+	}
+
+	GM_CHECK(pow(fixed(0), fixed(2)) == fixed(0));
+	GM_CHECK(pow(fixed(5), fixed(0)) == fixed(1));
+	GM_CHECK(abs(fixed(-2.5)) == fixed(2.5));
+	GM_CHECK((floor(fixed(-2.5)) == fixed(-3)) && (ceil(fixed(-2.5)) == fixed(-2)));
+	GM_CHECK(round(fixed(2.5)) == fixed(3));
+
+	// The templates of the other libraries
+	for (int i = 0; i <= 100; ++i)
+	{
+		const double t = i / 100.0;
+		const fixed ft(t);
+
+		GM_CHECK_NEAR(toDouble(gm::lerp(fixed(2), fixed(5), ft)), gm::lerp(2.0, 5.0, t), 1E-4);
+		GM_CHECK_NEAR(toDouble(gm::smoothstep(fixed(0), fixed(1), ft)), gm::smoothstep(0.0, 1.0, t), 1E-4);
+		GM_CHECK_NEAR(toDouble(gm::easing::easeInOutSine<fixed>(ft)), gm::easing::easeInOutSine<double>(t), 1E-4);
+		GM_CHECK_NEAR(toDouble(gm::easing::easeInOutCirc<fixed>(ft)), gm::easing::easeInOutCirc<double>(t), 2E-3);
+		GM_CHECK_NEAR(toDouble(gm::easing::easeOutElastic<fixed>(ft)), gm::easing::easeOutElastic<double>(t), 2E-3);
+
+		fixed r, g, b;
+		double R, G, B;
+
+		gm::hsl2rgb<fixed>(ft, fixed(0.5), fixed(0.4), &r, &g, &b);
+		gm::hsl2rgb<double>(t, 0.5, 0.4, &R, &G, &B);
+
+		GM_CHECK_NEAR(toDouble(r), R, 1E-3);
+		GM_CHECK_NEAR(toDouble(g), G, 1E-3);
+		GM_CHECK_NEAR(toDouble(b), B, 1E-3);
+
+		mix(gm::easing::easeInOutElastic<fixed>(ft));
+		mix(r);
+	}
+
+	// And the math.h functions are still found by the other libraries,
+	// even though gm_fixed.hpp was included first
+	GM_CHECK_NEAR(gm::easing::easeInExpo(0.5f), powf(2.0f, -5.0f), 1E-7);
+
+	// Bit identical everywhere
+	GM_CHECK(hash == 0x9430F72639739FDDULL);
+
+	return gm_test_result();
+}
@@ -0,0 +1,153 @@
+// Checks Grid::sample() and the batch version against bilinear
+// interpolation of a row-major array in double precision, for every
+// addressing mode and grid sizes that aren't a multiple of the tile
+// size, load() and store(), and that infinities and NaN sample a
+// cell of the grid rather than reading out of bounds.
+//
+//   g++ -std=c++11 -O2 -I.. test_grid.cpp -o test_grid -pthread
+
+#include "gm_grid.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdlib.h>
+#include <limits>
+#include <vector>
+
+
+static int address(long i, int n, gm::GridAddressing addressing)
+{
+	if (addressing == gm::GridAddressing::Clamp)
+		return (i < 0) ? 0 : ((i >= n) ? (n - 1) : static_cast<int>(i));
+
+	if (addressing == gm::GridAddressing::Wrap)
+		return static_cast<int>(((i % n) + n) % n);
+
+	const long period = 2L * n;
+	const long m = ((i % period) + period) % period;
+
+	return static_cast<int>((m < n) ? m : (period - 1 - m));
+}
+
+static double reference(const std::vector<float> &data, int width, int height, gm::GridAddressing addressing, float x, float y)
+{
+	double xx = x, yy = y;
+
+	if (addressing == gm::GridAddressing::Clamp)
+	{
+		xx = gm::clamp(xx, 0.0, width - 1.0);
+		yy = gm::clamp(yy, 0.0, height - 1.0);
+	}
+
+	const double fx = floor(xx), fy = floor(yy);
+	const long ix = static_cast<long>(fx), iy = static_cast<long>(fy);
+
+	const double p00 = data[address(iy, height, addressing) * width + address(ix, width, addressing)];
+	const double p10 = data[address(iy, height, addressing) * width + address(ix + 1, width, addressing)];
+	const double p01 = data[address(iy + 1, height, addressing) * width + address(ix, width, addressing)];
+	const double p11 = data[address(iy + 1, height, addressing) * width + address(ix + 1, width, addressing)];
+
+	return gm::bilerp(p00, p10, p01, p11, xx - fx, yy - fy);
+}
+
+
+int main()
+{
+	const int sizes[][2] = { { 1, 1 }, { 1, 5 }, { 7, 3 }, { 8, 8 }, { 13, 29 }, { 64, 17 }, { 600, 700 } };
+
+	srand(1);
+
+	for (size_t s = 0; s < (sizeof(sizes) / sizeof(*sizes)); ++s)
+	{
+		const int width = sizes[s][0], height = sizes[s][1];
+
+		std::vector<float> data(width * height), stored(width * height);
+
+		for (size_t i = 0; i < data.size(); ++i)
+			data[i] = (rand() % 1000) * 0.01f;
+
+		for (int a = 0; a < 3; ++a)
+		{
+			const gm::GridAddressing addressing = static_cast<gm::GridAddressing>(a);
+
+			gm::Grid grid(width, height, addressing);
+			grid.load(data.data());
+
+			grid.store(stored.data());
+			GM_CHECK(stored == data);
+			GM_CHECK(grid.get(width - 1, height - 1) == data.back());
+
+			const size_t n = 1003;
+
+			std::vector<float> xs(n), ys(n), result(n);
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				xs[i] = (rand() / static_cast<float>(RAND_MAX) * 6.0f - 3.0f) * width;
+				ys[i] = (rand() / static_cast<float>(RAND_MAX) * 6.0f - 3.0f) * height;
+
+				// Integral coordinates, the edges, and -0
+				if ((i % 7) == 0) xs[i] = static_cast<float>(static_cast<int>(xs[i]));
+				if ((i % 11) == 0) ys[i] = static_cast<float>(height - 1);
+				if ((i % 13) == 0) xs[i] = -0.0f;
+				if ((i % 17) == 0) xs[i] = static_cast<float>(width);
+			}
+
+			grid.sample(xs.data(), ys.data(), result.data(), n);
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				const double expected = reference(data, width, height, addressing, xs[i], ys[i]);
+
+				GM_CHECK_NEAR(result[i], expected, 1E-3 * (1.0 + fabs(expected)));
+				GM_CHECK_NEAR(grid.sample(xs[i], ys[i]), expected, 1E-3 * (1.0 + fabs(expected)));
+			}
+		}
+	}
+
+	// Non-finite and huge coordinates give a value within the grid
+	const float inf = std::numeric_limits<float>::infinity();
+	const float values[] = { inf, -inf, std::numeric_limits<float>::quiet_NaN(), 1E30f, -1E30f, 1.5f, -2.0f };
+	const int count = static_cast<int>(sizeof(values) / sizeof(*values));
+
+	for (int a = 0; a < 3; ++a)
+	{
+		gm::Grid grid(37, 21, static_cast<gm::GridAddressing>(a));
+
+		for (int y = 0; y < 21; ++y)
+			for (int x = 0; x < 37; ++x)
+				grid.set(x, y, x + y * 100.0f);
+
+		for (int i = 0; i < count; ++i)
+		{
+			float xs[count], ys[count], result[count];
+
+			for (int j = 0; j < count; ++j)
+			{
+				xs[j] = values[i];
+				ys[j] = values[j];
+			}
+
+			grid.sample(xs, ys, result, count);
+
+			for (int j = 0; j < count; ++j)
+			{
+				const float r = grid.sample(values[i], values[j]);
+
+				GM_CHECK((r >= 0.0f) && (r <= 2036.0f));
+				GM_CHECK((result[j] >= 0.0f) && (result[j] <= 2036.0f));
+			}
+		}
+	}
+
+	// An empty grid samples 0
+	gm::Grid empty;
+
+	float x = 1.0f, y = 1.0f, r = 5.0f;
+	empty.sample(&x, &y, &r, 1);
+
+	GM_CHECK(r == 0.0f);
+	GM_CHECK(empty.sample(1.0f, 1.0f) == 0.0f);
+
+	return gm_test_result();
+}
@@ -0,0 +1,224 @@
+// Checks convertImage() round trips between raw RGBA8, PPM and PGM
+// with images spanning many chunks, that transform sees every pixel
+// in order, PPM headers with comments and a maxval below 255, and
+// that truncated input, write errors and a throwing transform fail
+// cleanly.
+//
+//   g++ -std=c++11 -O2 -I.. test_imagestream.cpp -o test_imagestream -pthread
+
+#include "gm_imagestream.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+
+static void put(FILE *file, const std::vector<unsigned char> &bytes)
+{
+	fwrite(bytes.data(), 1, bytes.size(), file);
+	rewind(file);
+}
+
+static std::vector<unsigned char> get(FILE *file)
+{
+	std::vector<unsigned char> bytes;
+
+	rewind(file);
+
+	for (int c = fgetc(file); c != EOF; c = fgetc(file))
+		bytes.push_back(static_cast<unsigned char>(c));
+
+	rewind(file);
+
+	return bytes;
+}
+
+// Converts src to dst with the FILE* versions, and rewinds both
+static bool convert(
+	FILE *src, gm::ImageFormat srcFormat, FILE *dst, gm::ImageFormat dstFormat,
+	size_t width, size_t height,
+	const gm::ImageTransform &transform = nullptr, gm::ImageStreamStats *stats = nullptr)
+{
+	gm::ImageReader reader;
+	gm::ImageWriter writer;
+
+	if (!reader.open(src, srcFormat, width, height))
+		return false;
+
+	if (!writer.open(dst, dstFormat, reader.width(), reader.height()))
+		return false;
+
+	// A small budget, to use the smallest chunks
+	const bool converted = gm::convertImage(reader, writer, transform, 0, stats);
+
+	const bool closed = writer.close();
+
+	rewind(src);
+	rewind(dst);
+
+	return converted && closed;
+}
+
+
+int main()
+{
+	const size_t width = 301, height = 203, n = width * height;
+
+	std::vector<unsigned char> rgba(n * 4);
+
+	srand(1);
+
+	for (size_t i = 0; i < rgba.size(); ++i)
+		rgba[i] = static_cast<unsigned char>(rand());
+
+	FILE *raw = tmpfile(), *ppm = tmpfile(), *pgm = tmpfile(), *back = tmpfile();
+
+	GM_CHECK(raw && ppm && pgm && back);
+
+	put(raw, rgba);
+
+	// Raw to PPM and back, where alpha becomes 255
+	gm::ImageStreamStats stats;
+
+	GM_CHECK(convert(raw, gm::ImageFormat::RawRGBA8, ppm, gm::ImageFormat::PPM, width, height, nullptr, &stats));
+	GM_CHECK(stats.pixels == n);
+	GM_CHECK(stats.chunks == ((n + 1023) / 1024));
+
+	char header[32];
+	snprintf(header, sizeof(header), "P6\n%zu %zu\n255\n", width, height);
+
+	const std::vector<unsigned char> ppmBytes = get(ppm);
+
+	GM_CHECK(ppmBytes.size() == (strlen(header) + n * 3));
+	GM_CHECK(memcmp(ppmBytes.data(), header, strlen(header)) == 0);
+
+	GM_CHECK(convert(ppm, gm::ImageFormat::PPM, back, gm::ImageFormat::RawRGBA8, 0, 0));
+
+	std::vector<unsigned char> expected = rgba;
+
+	for (size_t i = 0; i < n; ++i)
+		expected[i * 4 + 3] = 255;
+
+	GM_CHECK(get(back) == expected);
+
+	// Raw to PGM stores the luma
+	GM_CHECK(convert(raw, gm::ImageFormat::RawRGBA8, pgm, gm::ImageFormat::PGM, width, height));
+
+	std::vector<unsigned char> luma(n);
+	gm::grayscale(rgba.data(), luma.data(), n, 4, gm::LumaWeights::Rec709);
+
+	const std::vector<unsigned char> pgmBytes = get(pgm);
+
+	GM_CHECK(pgmBytes.size() >= n);
+	GM_CHECK(std::vector<unsigned char>(pgmBytes.end() - n, pgmBytes.end()) == luma);
+
+	// The transform sees every pixel once, in order
+	size_t seen = 0;
+
+	const auto invert = [&seen, &rgba](unsigned char *pixels, size_t count)
+	{
+		for (size_t i = 0; i < (count * 4); ++i)
+		{
+			if (pixels[i] != rgba[seen * 4 + i])
+				throw std::logic_error("out of order");
+
+			pixels[i] = static_cast<unsigned char>(255 - pixels[i]);
+		}
+
+		seen += count;
+	};
+
+	FILE *inverted = tmpfile();
+
+	GM_CHECK(convert(raw, gm::ImageFormat::RawRGBA8, inverted, gm::ImageFormat::RawRGBA8, width, height, invert));
+	GM_CHECK(seen == n);
+
+	const std::vector<unsigned char> invertedBytes = get(inverted);
+
+	GM_CHECK(invertedBytes.size() == rgba.size());
+
+	for (size_t i = 0; (i < rgba.size()) && (i < invertedBytes.size()); ++i)
+		GM_CHECK(invertedBytes[i] == (255 - rgba[i]));
+
+	// A header with comments, and a maxval of 100
+	FILE *scaled = tmpfile(), *scaledBack = tmpfile();
+
+	const char scaledHeader[] = "P6 # comment\n2 # another\n1\n100\n";
+	const unsigned char scaledPixels[] = { 0, 50, 100, 1, 99, 200 };
+
+	std::vector<unsigned char> scaledBytes(scaledHeader, scaledHeader + strlen(scaledHeader));
+	scaledBytes.insert(scaledBytes.end(), scaledPixels, scaledPixels + 6);
+
+	put(scaled, scaledBytes);
+
+	GM_CHECK(convert(scaled, gm::ImageFormat::PPM, scaledBack, gm::ImageFormat::RawRGBA8, 0, 0));
+
+	const unsigned char scaledExpected[] = { 0, 128, 255, 255, 3, 252, 255, 255 };
+	GM_CHECK(get(scaledBack) == std::vector<unsigned char>(scaledExpected, scaledExpected + 8));
+
+	// A truncated input
+	FILE *truncated = tmpfile(), *truncatedBack = tmpfile();
+
+	put(truncated, std::vector<unsigned char>(ppmBytes.begin(), ppmBytes.end() - 1000));
+
+	GM_CHECK(!convert(truncated, gm::ImageFormat::PPM, truncatedBack, gm::ImageFormat::RawRGBA8, 0, 0));
+
+	// A wrong magic number
+	GM_CHECK(!convert(ppm, gm::ImageFormat::PGM, truncatedBack, gm::ImageFormat::RawRGBA8, 0, 0));
+
+	// An output that can't be written
+	const char *readOnlyPath = "test_imagestream.tmp";
+
+	FILE *readOnly = fopen(readOnlyPath, "wb");
+	GM_CHECK(readOnly != nullptr);
+
+	if (readOnly)
+	{
+		fclose(readOnly);
+		readOnly = fopen(readOnlyPath, "rb");
+
+		GM_CHECK(!convert(raw, gm::ImageFormat::RawRGBA8, readOnly, gm::ImageFormat::RawRGBA8, width, height));
+
+		fclose(readOnly);
+		remove(readOnlyPath);
+	}
+
+	// A throwing transform is rethrown, after the first chunk went through
+	FILE *partial = tmpfile();
+
+	size_t calls = 0;
+	bool caught = false;
+
+	try
+	{
+		convert(raw, gm::ImageFormat::RawRGBA8, partial, gm::ImageFormat::RawRGBA8, width, height, [&calls](unsigned char*, size_t)
+		{
+			if (++calls == 3)
+				throw std::runtime_error("transform");
+		});
+	}
+	catch (const std::runtime_error&)
+	{
+		caught = true;
+	}
+
+	GM_CHECK(caught);
+	GM_CHECK(calls == 3);
+
+	fclose(raw);
+	fclose(ppm);
+	fclose(pgm);
+	fclose(back);
+	fclose(inverted);
+	fclose(scaled);
+	fclose(scaledBack);
+	fclose(truncated);
+	fclose(truncatedBack);
+	fclose(partial);
+
+	return gm_test_result();
+}
@@ -0,0 +1,140 @@
+// Checks the batch lerp(), map(), normalize(), clamp(), smoothstep()
+// and bilerp() against the scalar functions, for float and double,
+// misaligned arrays, counts that aren't a multiple of the vector
+// width, results in place, and that nothing past the end is written.
+//
+//   g++ -std=c++11 -O2 -I.. test_math_batch.cpp -o test_math_batch -pthread
+
+#include "gm_math.hpp"
+
+#include "gm_test.hpp"
+
+#include <float.h>
+#include <stdlib.h>
+#include <vector>
+
+
+template<typename T>
+static T random(T min, T max)
+{
+	return min + (max - min) * (rand() / static_cast<T>(RAND_MAX));
+}
+
+// Close to the last bit, relative to the magnitude of the values
+template<typename T>
+static double tolerance(T magnitude)
+{
+	return 4.0 * ((sizeof(T) == sizeof(float)) ? FLT_EPSILON : DBL_EPSILON) * (fabs(static_cast<double>(magnitude)) + 1.0);
+}
+
+template<typename T>
+static void check(size_t n, size_t offset)
+{
+	const T sentinel = T(-12345);
+
+	std::vector<T> a(n + offset + 1), b(n + offset + 1), c(n + offset + 1), d(n + offset + 1);
+	std::vector<T> u(n + offset + 1), v(n + offset + 1), result(n + offset + 1, sentinel);
+
+	for (size_t i = 0; i < a.size(); ++i)
+	{
+		a[i] = random<T>(-100, 100);
+		b[i] = random<T>(-100, 100);
+		c[i] = random<T>(-100, 100);
+		d[i] = random<T>(-100, 100);
+		u[i] = random<T>(-0.5, 1.5);
+		v[i] = random<T>(-0.5, 1.5);
+	}
+
+	// The result misaligned from the inputs
+	T *r = result.data() + offset;
+	const T *x = a.data() + 1;
+
+	gm::lerp(a.data(), b.data(), u.data(), r, n);
+
+	for (size_t i = 0; i < n; ++i)
+		GM_CHECK_NEAR(r[i], gm::lerp<T>(a[i], b[i], u[i]), tolerance<T>(200));
+
+	gm::lerp(T(-3), T(5), u.data(), r, n);
+
+	for (size_t i = 0; i < n; ++i)
+		GM_CHECK_NEAR(r[i], gm::lerp<T>(-3, 5, u[i]), tolerance<T>(8));
+
+	gm::map(x, T(-100), T(100), T(0), T(1), r, n);
+
+	for (size_t i = 0; i < n; ++i)
+		GM_CHECK_NEAR(r[i], gm::map<T>(x[i], -100, 100, 0, 1), tolerance<T>(1));
+
+	gm::normalize(T(-50), T(50), x, r, n);
+
+	for (size_t i = 0; i < n; ++i)
+		GM_CHECK_NEAR(r[i], gm::normalize<T>(-50, 50, x[i]), tolerance<T>(2));
+
+	gm::clamp(x, T(-10), T(20), r, n);
+
+	for (size_t i = 0; i < n; ++i)
+		GM_CHECK(r[i] == gm::clamp<T>(x[i], -10, 20));
+
+	gm::smoothstep(T(-50), T(50), x, r, n);
+
+	for (size_t i = 0; i < n; ++i)
+		GM_CHECK_NEAR(r[i], gm::smoothstep<T>(-50, 50, x[i]), tolerance<T>(1));
+
+	gm::bilerp(a.data(), b.data(), c.data(), d.data(), u.data(), v.data(), r, n);
+
+	for (size_t i = 0; i < n; ++i)
+		GM_CHECK_NEAR(r[i], gm::bilerp<T>(a[i], b[i], c[i], d[i], u[i], v[i]), tolerance<T>(800));
+
+	// Nothing before or past the result is written
+	for (size_t i = 0; i < offset; ++i)
+		GM_CHECK(result[i] == sentinel);
+
+	GM_CHECK(result[offset + n] == sentinel);
+
+	// In place, aliasing the inputs
+	std::vector<T> expected(n), inPlace(a.begin() + offset, a.begin() + offset + n);
+
+	for (size_t i = 0; i < n; ++i)
+		expected[i] = gm::lerp<T>(inPlace[i], b[i], u[i]);
+
+	gm::lerp(inPlace.data(), b.data(), u.data(), inPlace.data(), n);
+
+	for (size_t i = 0; i < n; ++i)
+		GM_CHECK_NEAR(inPlace[i], expected[i], tolerance<T>(200));
+
+	inPlace.assign(a.begin() + offset, a.begin() + offset + n);
+
+	for (size_t i = 0; i < n; ++i)
+		expected[i] = gm::clamp<T>(inPlace[i], -10, 20);
+
+	gm::clamp(inPlace.data(), T(-10), T(20), inPlace.data(), n);
+	GM_CHECK(inPlace == expected);
+}
+
+
+int main()
+{
+	srand(1);
+
+	const size_t counts[] = { 0, 1, 3, 7, 15, 16, 17, 33, 1003 };
+
+	for (size_t k = 0; k < (sizeof(counts) / sizeof(*counts)); ++k)
+	{
+		for (size_t offset = 0; offset < 9; ++offset)
+		{
+			check<float>(counts[k], offset);
+			check<double>(counts[k], offset);
+		}
+	}
+
+	// Endpoints are exact
+	const float t[4] = { 0.0f, 1.0f, 0.0f, 1.0f };
+	float r[4];
+
+	gm::lerp(0.1f, 0.7f, t, r, 4);
+	GM_CHECK((r[0] == 0.1f) && (r[1] == 0.7f) && (r[2] == 0.1f) && (r[3] == 0.7f));
+
+	gm::smoothstep(0.0f, 1.0f, t, r, 4);
+	GM_CHECK((r[0] == 0.0f) && (r[1] == 1.0f));
+
+	return gm_test_result();
+}
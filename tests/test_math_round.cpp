@@ -0,0 +1,140 @@
+// Checks the scalar and batch ceil(), floor(), round() and fract()
+// against math.h, including halfway cases, negative zero and values
+// beyond the range of int, and the batch nearest(), nearestCeil() and
+// nearestFloor() against the scalar versions, with the cell indices
+// saturated for infinities, huge values and NaN.
+//
+//   g++ -std=c++11 -O2 -I.. test_math_round.cpp -o test_math_round -pthread
+
+#include "gm_math.hpp"
+
+#include "gm_test.hpp"
+
+#include <limits.h>
+#include <limits>
+#include <vector>
+
+
+template<typename T>
+static void check()
+{
+	std::vector<T> values;
+
+	const T special[] =
+	{
+		T(0), T(-0.0), T(0.5), T(-0.5), T(1.5), T(-1.5), T(2.5), T(-2.5),
+		T(1.4), T(-1.4), T(-1.6), T(0.49999997), T(-0.49999997),
+		T(8388609), T(-8388609.5), T(3E9), T(-3E9), T(1E20), T(-1E20),
+		T(123.456), T(-7.999),
+	};
+
+	values.assign(special, special + (sizeof(special) / sizeof(*special)));
+
+	for (int i = 0; i < 1000; ++i)
+		values.push_back(static_cast<T>(sin(i * 1.7) * pow(10.0, (i % 12) - 3)));
+
+	// Misaligned, and counts that aren't a multiple of the vector width
+	for (size_t offset = 0; offset < 5; ++offset)
+	{
+		const size_t n = values.size() - offset;
+		const T *x = values.data() + offset;
+
+		std::vector<T> c(n), f(n), r(n), fr(n);
+
+		gm::ceil(x, c.data(), n);
+		gm::floor(x, f.data(), n);
+		gm::round(x, r.data(), n);
+		gm::fract(x, fr.data(), n);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			GM_CHECK(c[i] == ::ceil(x[i]));
+			GM_CHECK(f[i] == ::floor(x[i]));
+			GM_CHECK(r[i] == ::round(x[i]));
+			GM_CHECK(fr[i] == (x[i] - ::floor(x[i])));
+
+			GM_CHECK(gm::ceil(x[i]) == c[i]);
+			GM_CHECK(gm::floor(x[i]) == f[i]);
+			GM_CHECK(gm::round(x[i]) == r[i]);
+			GM_CHECK(gm::fract(x[i]) == fr[i]);
+		}
+
+		const T step = T(0.25);
+
+		std::vector<T> snapped(n);
+		std::vector<int> cells(n);
+
+		for (int mode = 0; mode < 3; ++mode)
+		{
+			if (mode == 0) gm::nearest(x, step, snapped.data(), n, cells.data());
+			if (mode == 1) gm::nearestCeil(x, step, snapped.data(), n, cells.data());
+			if (mode == 2) gm::nearestFloor(x, step, snapped.data(), n, cells.data());
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				const T expected = (mode == 0) ? gm::nearest(x[i], step) : ((mode == 1) ? gm::nearestCeil(x[i], step) : gm::nearestFloor(x[i], step));
+				const double q = static_cast<double>(expected / step);
+
+				GM_CHECK(snapped[i] == expected);
+				GM_CHECK(cells[i] == ((q >= 2147483647.0) ? INT_MAX : ((q <= -2147483648.0) ? INT_MIN : static_cast<int>(q))));
+			}
+		}
+
+		// Either output can be left out
+		std::vector<int> onlyCells(n);
+
+		gm::nearestFloor(x, step, static_cast<T*>(nullptr), n, onlyCells.data());
+		GM_CHECK(onlyCells == cells);
+
+		gm::nearest(x, step, snapped.data(), n);
+
+		for (size_t i = 0; i < n; ++i)
+			GM_CHECK(snapped[i] == gm::nearest(x[i], step));
+	}
+
+	// In place
+	std::vector<T> inPlace = values;
+	gm::round(inPlace.data(), inPlace.data(), inPlace.size());
+
+	for (size_t i = 0; i < values.size(); ++i)
+		GM_CHECK(inPlace[i] == ::round(values[i]));
+
+	// Saturated cells, and 0 for NaN
+	const T nan = std::numeric_limits<T>::quiet_NaN();
+	const T inf = std::numeric_limits<T>::infinity();
+
+	const T n[9] = { nan, inf, -inf, T(1E30), T(-1E30), T(3.4), T(-3.6), T(2147483647.0), T(-2147483648.0) };
+	const int expected[9] = { 0, INT_MAX, INT_MIN, INT_MAX, INT_MIN, 3, -4, INT_MAX, INT_MIN };
+
+	T snapped[9];
+	int cells[9];
+
+	gm::nearest(n, T(1), snapped, 9, cells);
+
+	for (int i = 0; i < 9; ++i)
+		GM_CHECK(cells[i] == expected[i]);
+
+	GM_CHECK(snapped[0] != snapped[0]);
+	GM_CHECK((snapped[1] == inf) && (snapped[2] == -inf));
+	GM_CHECK((snapped[5] == T(3)) && (snapped[6] == T(-4)));
+}
+
+
+int main()
+{
+	check<float>();
+	check<double>();
+
+	// Halfway cases round away from zero
+	GM_CHECK(gm::round(2.5f) == 3.0f);
+	GM_CHECK(gm::round(-2.5f) == -3.0f);
+	GM_CHECK(gm::round(0.5) == 1.0);
+	GM_CHECK(gm::nearest(7.5f, 5.0f) == 10.0f);
+	GM_CHECK(gm::nearest(-7.5f, 5.0f) == -10.0f);
+
+	// Beyond the range of int
+	GM_CHECK(gm::floor(3E9f) == 3E9f);
+	GM_CHECK(gm::ceil(-1E20) == -1E20);
+
+	return gm_test_result();
+}
@@ -0,0 +1,146 @@
+// Checks the accuracy of the three tiers of the vectorized sincos(),
+// atan2() and asin() against the double precision functions, and the
+// batch cartesianToSpherical() and sphericalToCartesian() against the
+// scalar functions, the origin, and the round trip.
+//
+//   g++ -std=c++11 -O2 -I.. test_math_spherical.cpp -o test_math_spherical -pthread
+
+#include "gm_math.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdlib.h>
+#include <vector>
+
+
+// Max absolute errors of sin/cos, and atan2/asin
+template<gm::simd::Accuracy accuracy, typename V>
+static void checkAccuracy(double sincosTolerance, double atanTolerance)
+{
+	typedef typename V::scalar T;
+
+	const int width = V::width;
+
+	T x[64], y[64], s[64], c[64], a[64];
+
+	for (int i = -100000; i <= 100000; i += width)
+	{
+		for (int k = 0; k < width; ++k)
+		{
+			x[k] = static_cast<T>((i + k) * 1E-3);
+			y[k] = static_cast<T>((((i + k) * 7919) % 100000) * 5E-5);
+		}
+
+		V vs, vc;
+		gm::simd::sincos<accuracy>(V::loadu(x), &vs, &vc);
+
+		vs.storeu(s);
+		vc.storeu(c);
+
+		for (int k = 0; k < width; ++k)
+		{
+			GM_CHECK_NEAR(s[k], sin(static_cast<double>(x[k])), sincosTolerance);
+			GM_CHECK_NEAR(c[k], cos(static_cast<double>(x[k])), sincosTolerance);
+		}
+
+		gm::simd::atan2<accuracy>(V::loadu(y), V::loadu(x)).storeu(a);
+
+		for (int k = 0; k < width; ++k)
+			GM_CHECK_NEAR(a[k], atan2(static_cast<double>(y[k]), static_cast<double>(x[k])), atanTolerance);
+
+		// In [-1;1]
+		for (int k = 0; k < width; ++k)
+			x[k] = static_cast<T>((i + k) * 1E-5);
+
+		gm::simd::asin<accuracy>(V::loadu(x)).storeu(a);
+
+		for (int k = 0; k < width; ++k)
+		{
+			if (fabs(static_cast<double>(x[k])) <= 1.0)
+				GM_CHECK_NEAR(a[k], asin(static_cast<double>(x[k])), atanTolerance * ((fabs(static_cast<double>(x[k])) > 0.999) ? 10.0 : 1.0));
+		}
+	}
+}
+
+template<typename T>
+static void checkSpherical(size_t n, gm::simd::Accuracy accuracy, double tolerance)
+{
+	std::vector<T> x(n), y(n), z(n), rho(n), phi(n), theta(n), x2(n), y2(n), z2(n);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		x[i] = static_cast<T>(rand() / static_cast<double>(RAND_MAX) * 20.0 - 10.0);
+		y[i] = static_cast<T>(rand() / static_cast<double>(RAND_MAX) * 20.0 - 10.0);
+		z[i] = static_cast<T>(rand() / static_cast<double>(RAND_MAX) * 20.0 - 10.0);
+	}
+
+	// The origin gives 0 rather than NaN
+	if (n > 0)
+		x[0] = y[0] = z[0] = T(0);
+
+	gm::cartesianToSpherical(x.data(), y.data(), z.data(), rho.data(), phi.data(), theta.data(), n, accuracy);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		T r, p, t;
+		gm::cartesianToSpherical(x[i], y[i], z[i], r, p, t);
+
+		if (i == 0)
+		{
+			GM_CHECK((rho[i] == T(0)) && (phi[i] == T(0)) && (theta[i] == T(0)));
+			continue;
+		}
+
+		GM_CHECK_NEAR(rho[i], r, 1E-6 * r);
+		GM_CHECK_NEAR(phi[i], p, tolerance);
+		GM_CHECK_NEAR(theta[i], t, tolerance);
+	}
+
+	gm::sphericalToCartesian(rho.data(), phi.data(), theta.data(), x2.data(), y2.data(), z2.data(), n, accuracy);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		T a, b, c;
+		gm::sphericalToCartesian(rho[i], phi[i], theta[i], a, b, c);
+
+		// The angle errors are scaled by the radius (up to about 17)
+		GM_CHECK_NEAR(x2[i], a, 20.0 * tolerance);
+		GM_CHECK_NEAR(y2[i], b, 20.0 * tolerance);
+		GM_CHECK_NEAR(z2[i], c, 20.0 * tolerance);
+
+		GM_CHECK_NEAR(x2[i], x[i], 40.0 * tolerance);
+		GM_CHECK_NEAR(y2[i], y[i], 40.0 * tolerance);
+		GM_CHECK_NEAR(z2[i], z[i], 40.0 * tolerance);
+	}
+}
+
+
+int main()
+{
+	using gm::simd::Accuracy;
+
+	checkAccuracy<Accuracy::Precise, gm::simd::vfloat>(3E-7, 5E-7);
+	checkAccuracy<Accuracy::Medium, gm::simd::vfloat>(1.2E-5, 1.2E-5);
+	checkAccuracy<Accuracy::Fast, gm::simd::vfloat>(2.2E-4, 6.5E-4);
+
+	checkAccuracy<Accuracy::Precise, gm::simd::vdouble>(1E-15, 1E-15);
+	checkAccuracy<Accuracy::Medium, gm::simd::vdouble>(1.2E-5, 1.2E-5);
+	checkAccuracy<Accuracy::Fast, gm::simd::vdouble>(2.2E-4, 6.5E-4);
+
+	srand(1);
+
+	const size_t counts[] = { 0, 1, 3, 17, 1003 };
+
+	for (size_t k = 0; k < (sizeof(counts) / sizeof(*counts)); ++k)
+	{
+		checkSpherical<float>(counts[k], Accuracy::Precise, 1E-6);
+		checkSpherical<float>(counts[k], Accuracy::Medium, 2E-5);
+		checkSpherical<float>(counts[k], Accuracy::Fast, 1E-3);
+
+		checkSpherical<double>(counts[k], Accuracy::Precise, 1E-14);
+		checkSpherical<double>(counts[k], Accuracy::Medium, 2E-5);
+		checkSpherical<double>(counts[k], Accuracy::Fast, 1E-3);
+	}
+
+	return gm_test_result();
+}
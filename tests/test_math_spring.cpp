@@ -0,0 +1,115 @@
+// Checks SpringSystem::step() against smoothDamp() and stepExact()
+// against smoothDampExact() for every spring, with and without the
+// thread pool, remove() and setSpringiness(), and that stepExact()
+// settles without overshooting for large time steps.
+//
+//   g++ -std=c++11 -O2 -I.. test_math_spring.cpp -o test_math_spring -pthread
+
+#include "gm_math.hpp"
+
+#include "gm_test.hpp"
+
+#include <stdlib.h>
+#include <vector>
+
+
+static float random(float min, float max)
+{
+	return min + (max - min) * (rand() / static_cast<float>(RAND_MAX));
+}
+
+
+int main()
+{
+	gm::ThreadPool pool(4);
+
+	srand(1);
+
+	const size_t counts[] = { 1, 7, 17, 1003, 10007 };
+
+	for (size_t k = 0; k < (sizeof(counts) / sizeof(*counts)); ++k)
+	{
+		const size_t n = counts[k];
+
+		// Below and above the parallel threshold
+		gm::SpringSystem springs(1000), exactSprings(1000);
+		std::vector<float> current(n), target(n), velocity(n), springiness(n);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			current[i] = random(-100.0f, 100.0f);
+			target[i] = random(-100.0f, 100.0f);
+			velocity[i] = random(-10.0f, 10.0f);
+			springiness[i] = random(0.5f, 50.0f);
+
+			GM_CHECK(springs.add(current[i], target[i], springiness[i], velocity[i]) == i);
+			exactSprings.add(current[i], target[i], springiness[i], velocity[i]);
+		}
+
+		GM_CHECK(springs.size() == n);
+
+		std::vector<float> exactCurrent = current, exactVelocity = velocity;
+
+		for (int step = 0; step < 50; ++step)
+		{
+			const float timeStep = 1.0f / 60.0f;
+
+			springs.step(timeStep, pool);
+			exactSprings.stepExact(timeStep, pool);
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				current[i] = gm::smoothDamp(current[i], target[i], velocity[i], timeStep, springiness[i]);
+				exactCurrent[i] = gm::smoothDampExact(exactCurrent[i], target[i], exactVelocity[i], timeStep, springiness[i]);
+			}
+		}
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			GM_CHECK(springs.current(i) == current[i]);
+			GM_CHECK(springs.velocity(i) == velocity[i]);
+
+			// Within float rounding, accumulated over the steps
+			GM_CHECK_NEAR(exactSprings.current(i), exactCurrent[i], 1E-4 * (fabs(exactCurrent[i]) + 1.0));
+			GM_CHECK_NEAR(exactSprings.velocity(i), exactVelocity[i], 1E-4 * (fabs(exactVelocity[i]) + 10.0));
+		}
+
+		// remove() moves the last spring into the removed index
+		const float last = springs.current(n - 1);
+
+		springs.remove(0);
+		GM_CHECK(springs.size() == (n - 1));
+
+		if (n > 1)
+			GM_CHECK(springs.current(0) == last);
+	}
+
+	// setSpringiness() updates the cached square root
+	gm::SpringSystem springs;
+
+	springs.add(10.0f, 0.0f, 5.0f);
+	springs.setSpringiness(0, 16.0f);
+	springs.stepExact(0.1f);
+
+	float velocity = 0.0f;
+	const float expected = gm::smoothDampExact(10.0f, 0.0f, velocity, 0.1f, 16.0f);
+
+	GM_CHECK_NEAR(springs.current(0), expected, 1E-5);
+	GM_CHECK_NEAR(springs.velocity(0), velocity, 1E-5);
+
+	// Large time steps neither overshoot nor blow up
+	springs.clear();
+	springs.add(10.0f, 0.0f, 25.0f);
+
+	for (int step = 0; step < 10; ++step)
+	{
+		springs.stepExact(10.0f);
+
+		GM_CHECK(springs.current(0) >= 0.0f);
+		GM_CHECK(springs.current(0) <= 10.0f);
+	}
+
+	GM_CHECK_NEAR(springs.current(0), 0.0f, 1E-6);
+
+	return gm_test_result();
+}
@@ -0,0 +1,218 @@
+// Checks vec2, vec3, vec4 and vec3xN against the same operations on
+// their float components: arithmetic, dot(), length(), cross(), sqrt(),
+// the rounding and min/max/clamp specializations, the gm_math.hpp
+// templates, and comparisons with select(), any() and all().
+//
+//   g++ -std=c++11 -O2 -I.. test_vector.cpp -o test_vector -pthread
+
+#include "gm_vector.hpp"
+
+#include "gm_test.hpp"
+
+#include <vector>
+
+
+template<int N>
+static void check(const float *a, const float *b)
+{
+	typedef gm::vec<N> V;
+
+	const V va = V::load(a);
+	const V vb = V::load(b);
+
+	float o[4];
+
+	(va + vb).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == (a[k] + b[k]));
+
+	(va - vb).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == (a[k] - b[k]));
+
+	(va * vb).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == (a[k] * b[k]));
+
+	(va / vb).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == (a[k] / b[k]));
+
+	(2.0f * va - 1.0f).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == (2.0f * a[k] - 1.0f));
+
+	(-va).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == -a[k]);
+
+	V t = va;
+	t += vb;
+	t *= 2.0f;
+	t -= V(1.0f);
+	t /= 4.0f;
+
+	for (int k = 0; k < N; ++k)
+		GM_CHECK(t[k] == ((a[k] + b[k]) * 2.0f - 1.0f) / 4.0f);
+
+	// Summed in order, as with floats
+	float d = 0.0f;
+
+	for (int k = 0; k < N; ++k)
+		d += a[k] * b[k];
+
+	GM_CHECK(gm::dot(va, vb) == d);
+	GM_CHECK_NEAR(gm::length(va), sqrt(static_cast<double>(gm::dot(va, va))), 1E-6 * gm::length(va));
+
+	sqrt(gm::abs(va)).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == sqrtf(fabsf(a[k])));
+
+	gm::floor(va).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == floorf(a[k]));
+
+	gm::ceil(va).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == ceilf(a[k]));
+
+	gm::round(va).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == roundf(a[k]));
+
+	gm::min(va, vb).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == gm::min(a[k], b[k]));
+
+	gm::max(va, vb).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == gm::max(a[k], b[k]));
+
+	gm::clamp(va, V(-1.0f), V(1.0f)).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == gm::clamp(a[k], -1.0f, 1.0f));
+
+	// The compiler may contract the float versions into FMAs
+	gm::lerp<V>(va, vb, 0.25f).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK_NEAR(o[k], gm::lerp<float>(a[k], b[k], 0.25f), 1E-6 * (fabs(a[k]) + fabs(b[k])));
+
+	gm::smoothstep<V>(-2.0f, 2.0f, va).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK_NEAR(o[k], gm::smoothstep<float>(-2.0f, 2.0f, a[k]), 1E-6);
+
+	gm::nearest<V>(va, 0.25f).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == gm::nearest<float>(a[k], 0.25f));
+
+	// Comparisons only consider the first N lanes
+	GM_CHECK(gm::all(va == va));
+	GM_CHECK(!gm::any(va != va));
+
+	bool anyLess = false, allLess = true;
+
+	for (int k = 0; k < N; ++k)
+	{
+		anyLess = anyLess || (a[k] < b[k]);
+		allLess = allLess && (a[k] < b[k]);
+	}
+
+	GM_CHECK(gm::any(va < vb) == anyLess);
+	GM_CHECK(gm::all(va < vb) == allLess);
+	GM_CHECK(gm::any(~(va < vb)) == !allLess);
+	GM_CHECK(gm::all((va < vb) | (va >= vb)));
+	GM_CHECK(!gm::any((va < vb) & (va >= vb)));
+
+	gm::select(va < vb, va, vb).store(o);
+	for (int k = 0; k < N; ++k) GM_CHECK(o[k] == ((a[k] < b[k]) ? a[k] : b[k]));
+}
+
+
+int main()
+{
+	const float values[] =
+	{
+		1.5f, -2.5f, 3.25f, 0.49999997f, -7.999f, 123.456f, 0.5f, -0.4f,
+		8388609.0f, 2.0f, -1.0f, 0.75f, 4.0f, -3.5f, 0.125f, 9.0f,
+	};
+
+	const int n = static_cast<int>(sizeof(values) / sizeof(*values));
+
+	for (int i = 0; (i + 8) <= n; ++i)
+	{
+		check<2>(values + i, values + n - 4 - (i % 4));
+		check<3>(values + i, values + n - 4 - (i % 4));
+		check<4>(values + i, values + n - 4 - (i % 4));
+	}
+
+	const gm::vec3 a(1.0f, 2.0f, 3.0f), b(4.0f, -5.0f, 6.0f);
+	const gm::vec3 c = gm::cross(a, b);
+
+	GM_CHECK((c.x() == (2.0f * 6.0f - 3.0f * -5.0f)) && (c.y() == (3.0f * 4.0f - 1.0f * 6.0f)) && (c.z() == (1.0f * -5.0f - 2.0f * 4.0f)));
+	GM_CHECK(gm::dot(c, a) == 0.0f);
+	GM_CHECK(gm::length(gm::vec2(3.0f, 4.0f)) == 5.0f);
+	GM_CHECK(gm::all(gm::vec4(7.0f) == gm::vec4(7.0f, 7.0f, 7.0f, 7.0f)));
+
+	// A vec3 spring is three float springs
+	gm::vec3 current(0.0f), velocity(0.0f);
+	float currents[3] = { 0.0f, 0.0f, 0.0f }, velocities[3] = { 0.0f, 0.0f, 0.0f };
+
+	for (int step = 0; step < 100; ++step)
+	{
+		current = gm::smoothDamp<gm::vec3>(current, a, velocity, 1.0f / 60.0f, 5.0f);
+
+		for (int k = 0; k < 3; ++k)
+			currents[k] = gm::smoothDamp<float>(currents[k], a[k], velocities[k], 1.0f / 60.0f, 5.0f);
+	}
+
+	for (int k = 0; k < 3; ++k)
+		GM_CHECK(current[k] == currents[k]);
+
+	// vec3xN is width vec3s at once
+	const size_t width = gm::vec3xN::width;
+
+	std::vector<gm::vec3> va(width), vb(width), vo(width);
+
+	for (size_t i = 0; i < width; ++i)
+	{
+		va[i] = gm::vec3(i * 0.5f, -1.0f * i, 2.0f + i);
+		vb[i] = gm::vec3(1.0f, i * 0.25f, -3.0f);
+	}
+
+	const gm::vec3xN A = gm::vec3xN::gather(va.data());
+	const gm::vec3xN B = gm::vec3xN::gather(vb.data());
+
+	gm::cross(A, B).scatter(vo.data());
+
+	for (size_t i = 0; i < width; ++i)
+		GM_CHECK(gm::all(vo[i] == gm::cross(va[i], vb[i])));
+
+	float dots[64], lengths[64];
+
+	gm::dot(A, B).storeu(dots);
+	gm::length(A).storeu(lengths);
+
+	for (size_t i = 0; i < width; ++i)
+	{
+		GM_CHECK(dots[i] == gm::dot(va[i], vb[i]));
+		GM_CHECK_NEAR(lengths[i], gm::length(va[i]), 1E-6 * lengths[i]);
+	}
+
+	(A * B - A / gm::simd::vfloat(2.0f)).scatter(vo.data());
+
+	for (size_t i = 0; i < width; ++i)
+		GM_CHECK(gm::all(vo[i] == (va[i] * vb[i] - va[i] / 2.0f)));
+
+	gm::lerp<gm::vec3xN>(A, B, gm::vec3xN(0.3f)).scatter(vo.data());
+
+	for (size_t i = 0; i < width; ++i)
+		GM_CHECK(gm::all(vo[i] == gm::lerp<gm::vec3>(va[i], vb[i], 0.3f)));
+
+	sqrt(gm::abs(B)).scatter(vo.data());
+
+	for (size_t i = 0; i < width; ++i)
+		GM_CHECK(gm::all(vo[i] == sqrt(gm::abs(vb[i]))));
+
+	// Through separate x, y and z arrays
+	std::vector<float> x(width), y(width), z(width);
+
+	A.store(x.data(), y.data(), z.data());
+	gm::vec3xN::load(x.data(), y.data(), z.data()).scatter(vo.data());
+
+	for (size_t i = 0; i < width; ++i)
+	{
+		GM_CHECK((x[i] == va[i].x()) && (y[i] == va[i].y()) && (z[i] == va[i].z()));
+		GM_CHECK(gm::all(vo[i] == va[i]));
+	}
+
+	gm::vec3xN(va[width - 1]).scatter(vo.data());
+
+	for (size_t i = 0; i < width; ++i)
+		GM_CHECK(gm::all(vo[i] == va[width - 1]));
+
+	return gm_test_result();
+}